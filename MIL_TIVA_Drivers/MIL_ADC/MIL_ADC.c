@@ -1,530 +1,1462 @@
-/*
- * Name: MIL_ADC.h
- * Author: Marquez Jones
- * Last Modified: 3/6/2019
- * Desc: Set of ADC wrapper functions to simplify ADC use
- *
- * Note: In effect, the ADC module has a good amount of
- *       modularity that  I reduced with these functions
- *       to provide an easy to use set of functions
- *
- *       This should be sufficient for most ADC uses
- *       in MIL.
- *
- *       In the case it isn't, you'll have to read both
- *       the ADC sections from TivaWare and the Manual
- *       in order to make a more custom solution
- *
- *FREE LEARNING:
- *https://sites.google.com/site/luiselectronicprojects/tutorials/tiva-tutorials/tiva-adc/understanding-the-tiva-adc
- */
-
-/*
- * WHAT YOU NEED TO UNDERSTAND WITHOUT READING THE ADC SECTION:
- * Refer to pages 800-801 of the TM4C123GH6PM manual
- * for tables to descibe sequences
- *
- * the Tiva has two possible ADC modules(ADC0 and ADC1)
- * Within these modules, you have multiple sequencers
- * effectively, what the sequencer does, is tell your adc
- * which channels it needs to check. So you can gather multiple
- * ADC samples from multiple different analog inputs and have those
- * results output to a buffer(some kind of array you declare)
- *
- * This is important to understand as it will change which sequencers you choose
- * There's 4 sequencers per ADC enumerated 0 to 3
- *
- * 3 can be assigned only one imput channel
- * 0 can be assigned 8 input channels
- *
- * Note if you were to write this code yourself, you check one pin
- * multiple times within a sequence. In this header, I hardcoded it to
- * assign unique channels to each sequence step
- *
- */
-
-#include <stdbool.h>
-#include <stdint.h>
-#include "inc/hw_memmap.h"
-#include "driverlib/adc.h"
-#include "driverlib/gpio.h"
-#include "driverlib/pin_map.h"
-#include "driverlib/sysctl.h"
-#include "driverlib/uart.h"
-#include "utils/uartstdio.h"
-
-//MIL includes
-#include "MIL_ADC.h"
-
-/*
- * Desc: This function will configure the selected ADC channel
- *       as enumerated by our MIL_ADC_PINx_bm defines. Each of
- *       of those is associated with one the 12 ADC channels
- *
- * Note: This function effectively calls the
- *       GPIOPinTypeADC() function for each ADC pin
- *       function will also call the peripheral clock enables
- *
- * Parameters: This function takes in a bitfield
- *             of each ADC pin desired bit wised ORed
- *             together
- *
- * Para Note: So if you wanted pins 3 and 7, you'd pass in
- *            uint16_t field = MIL_ADC_PIN3_bm | MIL_ADC_PIN7_bm
- */
-void MIL_ADCPinConfig(uint16_t bitfield){
-
-    if(bitfield & MIL_ADC_PORTB_gc){
-
-        SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
-
-    }
-    if(bitfield & MIL_ADC_PORTD_gc){
-
-        SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD);
-
-    }
-    if(bitfield & MIL_ADC_PORTE_gc){
-
-        SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-
-    }
-    if(bitfield & MIL_ADC_PIN0_bm){
-
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_3);
-
-    }
-    if(bitfield & MIL_ADC_PIN1_bm){
-
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_2);
-
-    }
-    if(bitfield & MIL_ADC_PIN2_bm){
-
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_1);
-
-    }
-    if(bitfield & MIL_ADC_PIN3_bm){
-
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_0);
-
-    }
-    if(bitfield & MIL_ADC_PIN4_bm){
-
-        GPIOPinTypeADC(GPIO_PORTD_BASE, GPIO_PIN_3);
-
-    }
-    if(bitfield & MIL_ADC_PIN5_bm){
-
-        GPIOPinTypeADC(GPIO_PORTD_BASE, GPIO_PIN_2);
-
-    }
-    if(bitfield & MIL_ADC_PIN6_bm){
-
-        GPIOPinTypeADC(GPIO_PORTD_BASE, GPIO_PIN_1);
-
-    }
-    if(bitfield & MIL_ADC_PIN7_bm){
-
-        GPIOPinTypeADC(GPIO_PORTD_BASE, GPIO_PIN_0);
-
-    }
-    if(bitfield & MIL_ADC_PIN8_bm){
-
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_5);
-
-    }
-    if(bitfield & MIL_ADC_PIN9_bm){
-
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_4);
-
-    }
-    if(bitfield & MIL_ADC_PIN10_bm){
-
-        GPIOPinTypeADC(GPIO_PORTB_BASE, GPIO_PIN_4);
-
-    }
-    if(bitfield & MIL_ADC_PIN11_bm){
-
-        GPIOPinTypeADC(GPIO_PORTB_BASE, GPIO_PIN_5);
-
-    }
-
-}
-
-/*
- * Desc:This function enables individual sequences
- *      You will need to call this for each sequence
- *      you sequence you need to call this function
- *
- * Note: Each ADC has multiple sequences that control the
- *       ADC
- *
- *       This also hardcodes for single ended mode. This
- *       If you need differential, either consult the TivaWare
- *       manual and modify this function,write your own function,
- *       or contact someone who feels like modifying it for you
- *
- * Sequence Note: know that which sequence you select will limit how
- *                how many channels/pins you can assign.
- *
- *                If you input more pins than are available to that sequence
- *                the function will disregard those pins
- *
- *                Sequence 0 - 1 step/channel
- *                Sequence 1 - 4 steps/channels
- *                Sequence 2 - 4 steps/channels
- *                Sequence 3 - 8 steps/channels
- *
- * Interrupts Note: This function will always configure the
- *              ADC to set it's ISR flag without enabling the
- *              interrupt.
- *
- *              If you want to use this without interrupts,
- *              poll the ISR flag, and clear the interrupt using
- *              IntClear
- *
- *              refer to page 32 section 4.2.2.18
- *              for more information on using
- *              the interrupts
- *
- *              You'll need to register an interrupt
- *              function and call the enable functions
- *
- * Parameters: ENSURE STEP NUM AND NUMBER OF 1S IN BITFIELD ARE EQUAL OTHERWISE,THE FUNCTION WILL BREAK
- * adc_base - from TIVA library either ADC0_BASE or ADC1_BASE
- * Seq_num - which sequence you wish to enable(see Sequence defines in this header)
- * pin_bitfield - what pins you're using(see pin defines in this header)
- * trig - from mil_trig_t, this specifies what triggers your ADC
- *
- * USE NOTES TO GET DATA:
- *  Poll for interrupt flag using
- *  ADCIntStatus(ADCx_BASE, MIL_ADC_SEQx, false);
- *
- *  Clear the Interrupt flag with
- *  ADCIntClear(ADCx_BASE, MIL_ADC_SEQx);
- *
- * receive data into buffer with
- * ADCSequenceDataGet(ADC0_BASE,MIL_ADC_SEQx,array_pointer); where the array point points to an array of 32 bit values
- *
- * Arrays are points in C/C++
- */
-mil_adc_stat_t MIL_ADCSeqInit(uint32_t base,uint8_t seq_num,uint16_t pin_bitfield,mil_trig_t trig){
-
-   if(base == ADC0_BASE){
-
-       SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
-       SysCtlPeripheralReset(SYSCTL_PERIPH_ADC0);
-
-   }
-   else if(base == ADC1_BASE){
-
-       SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC1);
-       SysCtlPeripheralReset(SYSCTL_PERIPH_ADC1);
-
-   }
-   else{
-
-       return MIL_ADC_NOK;
-   }
-
-    pin_bitfield = pin_bitfield & 0x0FFF; //get rid of extraneous bits
-
-    uint32_t local_trig;
-
-    //determine trigger source
-    switch(trig){
-        case MIL_ADC_SoftTrig:
-            local_trig = ADC_TRIGGER_PROCESSOR;
-            break;
-        case MIL_ADC_TimTrig:
-            local_trig = ADC_TRIGGER_TIMER;
-            break;
-        case MIL_ADC_AlwaysTrig:
-            local_trig = ADC_TRIGGER_ALWAYS;
-            break;
-        default:
-            local_trig = ADC_TRIGGER_PROCESSOR;
-            break;
-    }
-
-    ADCSequenceConfigure(base,seq_num,local_trig,seq_num);
-
-    uint8_t step_max;
-
-    //generate max number of steps
-    switch(seq_num){
-        case MIL_ADC_SEQ0:
-            step_max = 8;
-            break;
-
-        case MIL_ADC_SEQ1:
-            step_max = 4;
-            break;
-
-        case MIL_ADC_SEQ2:
-            step_max = 4;
-            break;
-
-        case MIL_ADC_SEQ3:
-            step_max = 4;
-            break;
-        default:
-            step_max = 1;
-            break;
-    }
-
-    uint8_t step_need = 0;
-    uint16_t temp_field = pin_bitfield;
-
-    //count needed steps based on bitfield
-    while(temp_field){
-
-        //check each bit for a 1,
-        //if there's a 1 ,then there's a step needed for that channel
-        if(temp_field & 0x01){
-
-            step_need++;
-
-        }
-
-        //shift bits into the lsb,when this hits all 0s ,the function will end
-        temp_field = temp_field >> 1;
-
-
-    }
-
-    uint8_t actual_steps;
-
-    if(step_need > step_max){
-
-        actual_steps = step_max;
-
-    }
-    else{
-
-        actual_steps = step_need;
-
-    }
-
-
-    temp_field = pin_bitfield;
-    uint8_t channel = 0;
-
-    //step configurations
-    /*
-     * in effect this function configures each step by
-     * assign each sequential step to the next available channel
-     */
-    for(uint8_t i = 0;i < actual_steps;i++){
-
-        temp_field = pin_bitfield & (0x01<<channel);
-
-        //if field = 0 after the bit wise and,
-        //generate a new field
-        while(!temp_field){
-
-            channel++;
-            temp_field = pin_bitfield & (0x01<<channel);
-
-            if(channel > 11){
-
-                return MIL_ADC_NOK;
-
-            }
-
-        }
-
-        uint32_t config_field = channel; //set channel and enable interrupts for that step
-
-        //if this is the last step, configure it as so by adding the
-        //End flag
-        if((i+1) == actual_steps){
-
-            config_field |= ADC_CTL_END | ADC_CTL_IE;
-
-        }
-
-        ADCSequenceStepConfigure(base, seq_num, i, config_field);
-
-        channel++;
-
-    }
-
-
-    ADCSequenceEnable(base,seq_num);
-
-    ADCIntClear(base,seq_num);
-
-    return MIL_ADC_OK;
-}
-
-/*
- * Desc: enable adc interrupts
- *
- * Note: will trigger upon a conversion finishing
- *
- * Parameters:
- *  isr_ptr - pointer to your isr
- *  base - ADC base
- *  seq_num- your sequence number
- *
- */
-void MIL_ADCIntEnable(void (*isr_ptr)(void),uint32_t base,uint8_t seq_num){
-
-    ADCIntRegister(base,seq_num,isr_ptr);
-
-    ADCIntEnable(base,seq_num);
-
-}
-
-/*
- * Desc: Runs get data sequence specified in the ADCSeqInit function
- *       This function can also be called in interrupts if need be
- *
- * Note:
- *      This includes a wait function that will wait for new data or
- *      the user specified timer is reached
- *
- *      You can also implment there to be no wait, in which case the function
- *      will exit immediately if there is no new data
- *
- * Sequence:
- *  Poll for interrupt flag using
- *  ADCIntStatus(ADCx_BASE, MIL_ADC_SEQx, false);
- *
- *  Clear the Interrupt flag with
- *  ADCIntClear(ADCx_BASE, MIL_ADC_SEQx);
- *
- * receive data into buffer with
- * ADCSequenceDataGet(ADC0_BASE,MIL_ADC_SEQx,array_pointer); where the array point points to an array of 32 bit values
- *
- * Parameters:
- *  base - from TivaWare, your ADCx_BASE(either 0 or 1 for or x)
- *  seq_num- from mil header, which MIL_ADC_SEQx( 0 to 3 for x)
- *  timeout- how many cycles you wish to wait for the ADC to provide data
- *  pbuffer - pointer to output buffer (MUST USE POINT TO UIN32_T OR IT'LL DIE)
- *
- * Returns:
- *  mil_adc_status_t - MIL_ADC_OK if there's new data
- *                     MIL_ADC_NOK if there's no new data
- */
-mil_adc_stat_t MIL_ADCGetData(uint32_t base,uint8_t seq_num,uint32_t timeout,uint32_t *pbuffer){
-
-    uint32_t timeout_cnt = 0;
-
-    //wait for new adc data
-    while(!ADCIntStatus(base,seq_num,false)){
-
-        timeout_cnt++;
-        if(timeout_cnt == timeout){
-
-            return MIL_ADC_NOK;
-
-        }
-
-    }
-
-    //get data
-    ADCSequenceDataGet(base,seq_num,pbuffer);
-
-    //clear interrupt
-    ADCIntClear(base,seq_num);
-
-    //if you've reached here, there was data therefore OK
-    return MIL_ADC_OK;
-
-}
-/*
- * Desc: This function will convert a raw single ended ADC value to
- *       its double equivalent
- *
- * Note: this is based on the equation of a line
- *       in effect, the max adc value is 0xFFF which corresponds to
- *       your reference voltage.
- *
- *       implemented with equation
- *
- *       m = 3V/0xFFF
- *
- *       Voltage = m*(raw ADC)
- */
-float MIL_ADC_HextoFloat(uint16_t adc_value){
-
-    float voltage;
-    float slope = 3/0xFFF;
-
-    voltage = adc_value * slope;
-    return voltage;
-}
-
-/*
- * Desc: just incase you needed to convert the ADC values to ascii
- *       This function will take your 12 bit ADC value and output
- *       a string including its raw hex values
- *
- * Note: outstring is 3 bytes long
- *
- * Note: I used this for debugging
- */
-void MIL_ADC_HEXtoASCII(uint16_t adc_value,char *pstring){
-
-    char hex_char[3];
-
-    //isolation
-    hex_char[0] = (adc_value>>8) & 0x000F;
-    hex_char[1] = (adc_value>>4) & 0x000F;
-    hex_char[2] =  adc_value     & 0x000F;
-
-    //conversion to ascii
-    for(uint8_t idx = 0; idx < 3;idx++){
-
-        if(hex_char[idx] > 9){
-
-            hex_char[idx] = hex_char[idx] + 0x37;
-
-        }
-        else{
-
-            hex_char[idx] = hex_char[idx] + 0x30;
-
-        }
-        //copy to outstring
-        pstring[idx] = hex_char[idx];
-    }
-
-}
-
-/*
- * Desc: Converts a raw adc value into an ascii string
- *
- * Note: outstring is 4 bytes long
- *
- * Parameters:
- *  adc_value - from the ADC output
- *  pstring- pointer to outstring
- *
- */
-void MIL_ADC_FloattoASCII(uint16_t adc_value,char *pstring){
-
-     double result_double = (double)adc_value;
-
-     if(result_double < 0){
-            result_double = result_double * -1;
-     }
-
-     double org_res = (result_double*3)/4095;
-     int8_t res_int = (int8_t)org_res;           //first int
-     double res1 = 10*(org_res - res_int);
-     int8_t res_int1 = (int8_t)res1;             //second int
-     double res2 = 10*(res1 - res_int1);
-     int8_t res_int2 = (int8_t)res2;             //third int
-
-     //conversion to char
-     pstring[0]  = res_int  + 0x30;
-     pstring[1] = '.';
-     pstring[2] = res_int1 + 0x30;
-     pstring[3] = res_int2 + 0x30;
-
-}
-
+/*
+ * Name: MIL_ADC.h
+ * Author: Marquez Jones
+ * Last Modified: 3/6/2019
+ * Desc: Set of ADC wrapper functions to simplify ADC use
+ *
+ * Note: In effect, the ADC module has a good amount of
+ *       modularity that  I reduced with these functions
+ *       to provide an easy to use set of functions
+ *
+ *       This should be sufficient for most ADC uses
+ *       in MIL.
+ *
+ *       In the case it isn't, you'll have to read both
+ *       the ADC sections from TivaWare and the Manual
+ *       in order to make a more custom solution
+ *
+ *FREE LEARNING:
+ *https://sites.google.com/site/luiselectronicprojects/tutorials/tiva-tutorials/tiva-adc/understanding-the-tiva-adc
+ */
+
+/*
+ * WHAT YOU NEED TO UNDERSTAND WITHOUT READING THE ADC SECTION:
+ * Refer to pages 800-801 of the TM4C123GH6PM manual
+ * for tables to descibe sequences
+ *
+ * the Tiva has two possible ADC modules(ADC0 and ADC1)
+ * Within these modules, you have multiple sequencers
+ * effectively, what the sequencer does, is tell your adc
+ * which channels it needs to check. So you can gather multiple
+ * ADC samples from multiple different analog inputs and have those
+ * results output to a buffer(some kind of array you declare)
+ *
+ * This is important to understand as it will change which sequencers you choose
+ * There's 4 sequencers per ADC enumerated 0 to 3
+ *
+ * 3 can be assigned only one imput channel
+ * 0 can be assigned 8 input channels
+ *
+ * Note if you were to write this code yourself, you check one pin
+ * multiple times within a sequence. In this header, I hardcoded it to
+ * assign unique channels to each sequence step
+ *
+ * MIL_ADCSeqInitRepeat is the exception, it puts one channel on several
+ * steps so they can be averaged
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_adc.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/uart.h"
+#include "driverlib/udma.h"
+#include "utils/uartstdio.h"
+
+//MIL includes
+#include "MIL_ADC.h"
+
+/*
+ * Desc: what MIL_ADCSeqInit put in each sequence, kept so the
+ *       streaming code can rewrite the steps with the interrupt
+ *       bits the uDMA needs
+ */
+static uint8_t MIL_ADC_SeqSteps[2][4];
+static uint8_t MIL_ADC_SeqChan[2][4][8];
+
+//hardware averaging each module is set to, MIL_ADCSeqInit's reset puts it back to 1
+static uint8_t MIL_ADC_HwAvg[2] = {1,1};
+
+/*
+ * Desc: state for one streaming sequence
+ */
+typedef struct{
+
+    uint32_t *pping;
+    uint32_t *ppong;
+    uint16_t num_samples;
+    uint8_t  dma_ch;
+    volatile bool alt_next;
+    mil_adc_stream_cb_t callback;
+    volatile uint32_t overruns;
+
+}mil_adc_stream_t;
+
+static mil_adc_stream_t MIL_ADC_Streams[2][4];
+
+/*
+ * Desc: per channel calibration for the millivolt conversions
+ *       everything starts out nominal
+ */
+typedef struct{
+
+    int32_t gain_q16;
+    int32_t offset_q16;
+
+}mil_adc_cal_t;
+
+//limits that keep raw * gain + offset inside an int32_t
+#define MIL_ADC_CAL_GAIN_MAX   (4 * MIL_ADC_GAIN_Q16_NOMINAL)
+#define MIL_ADC_CAL_OFFSET_MAX (MIL_ADC_VREF_MV * 65536)
+
+#define MIL_ADC_CAL_NOMINAL {MIL_ADC_GAIN_Q16_NOMINAL,0}
+
+static mil_adc_cal_t MIL_ADC_CalTable[12] = {
+    MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL,
+    MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL,
+    MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL,MIL_ADC_CAL_NOMINAL
+};
+
+/*
+ * Desc: uDMA channel assignments for each sequence
+ *       ADC0 has channels 14-17 by default, ADC1 sits on 24-27
+ *       which needs the channel reassigned
+ */
+static const uint32_t MIL_ADC_DMAAssign[2][4] = {
+    {UDMA_CH14_ADC0_0,UDMA_CH15_ADC0_1,UDMA_CH16_ADC0_2,UDMA_CH17_ADC0_3},
+    {UDMA_CH24_ADC1_0,UDMA_CH25_ADC1_1,UDMA_CH26_ADC1_2,UDMA_CH27_ADC1_3}
+};
+
+/*
+ * Desc: the uDMA control table, the hardware wants it on a 1024 byte boundary
+ */
+#ifndef MIL_ADC_DMA_EXTERNAL_TABLE
+#if defined(ewarm)
+#pragma data_alignment=1024
+static tDMAControlTable MIL_ADC_DMATable[64];
+#elif defined(ccs)
+#pragma DATA_ALIGN(MIL_ADC_DMATable, 1024)
+static tDMAControlTable MIL_ADC_DMATable[64];
+#else
+static tDMAControlTable MIL_ADC_DMATable[64] __attribute__((aligned(1024)));
+#endif
+#endif
+
+/*
+ * Desc: 0 for ADC0, 1 for ADC1, -1 for anything else
+ */
+static int8_t MIL_ADCModuleIdx(uint32_t base){
+
+    if(base == ADC0_BASE){
+        return 0;
+    }
+    if(base == ADC1_BASE){
+        return 1;
+    }
+    return -1;
+
+}
+
+/*
+ * Desc: This function will configure the selected ADC channel
+ *       as enumerated by our MIL_ADC_PINx_bm defines. Each of
+ *       of those is associated with one the 12 ADC channels
+ *
+ * Note: This function effectively calls the
+ *       GPIOPinTypeADC() function for each ADC pin
+ *       function will also call the peripheral clock enables
+ *
+ * Parameters: This function takes in a bitfield
+ *             of each ADC pin desired bit wised ORed
+ *             together
+ *
+ * Para Note: So if you wanted pins 3 and 7, you'd pass in
+ *            uint16_t field = MIL_ADC_PIN3_bm | MIL_ADC_PIN7_bm
+ */
+void MIL_ADCPinConfig(uint16_t bitfield){
+
+    if(bitfield & MIL_ADC_PORTB_gc){
+
+        SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
+
+    }
+    if(bitfield & MIL_ADC_PORTD_gc){
+
+        SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD);
+
+    }
+    if(bitfield & MIL_ADC_PORTE_gc){
+
+        SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
+
+    }
+    if(bitfield & MIL_ADC_PIN0_bm){
+
+        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_3);
+
+    }
+    if(bitfield & MIL_ADC_PIN1_bm){
+
+        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_2);
+
+    }
+    if(bitfield & MIL_ADC_PIN2_bm){
+
+        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_1);
+
+    }
+    if(bitfield & MIL_ADC_PIN3_bm){
+
+        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_0);
+
+    }
+    if(bitfield & MIL_ADC_PIN4_bm){
+
+        GPIOPinTypeADC(GPIO_PORTD_BASE, GPIO_PIN_3);
+
+    }
+    if(bitfield & MIL_ADC_PIN5_bm){
+
+        GPIOPinTypeADC(GPIO_PORTD_BASE, GPIO_PIN_2);
+
+    }
+    if(bitfield & MIL_ADC_PIN6_bm){
+
+        GPIOPinTypeADC(GPIO_PORTD_BASE, GPIO_PIN_1);
+
+    }
+    if(bitfield & MIL_ADC_PIN7_bm){
+
+        GPIOPinTypeADC(GPIO_PORTD_BASE, GPIO_PIN_0);
+
+    }
+    if(bitfield & MIL_ADC_PIN8_bm){
+
+        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_5);
+
+    }
+    if(bitfield & MIL_ADC_PIN9_bm){
+
+        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_4);
+
+    }
+    if(bitfield & MIL_ADC_PIN10_bm){
+
+        GPIOPinTypeADC(GPIO_PORTB_BASE, GPIO_PIN_4);
+
+    }
+    if(bitfield & MIL_ADC_PIN11_bm){
+
+        GPIOPinTypeADC(GPIO_PORTB_BASE, GPIO_PIN_5);
+
+    }
+
+}
+
+/*
+ * Desc:This function enables individual sequences
+ *      You will need to call this for each sequence
+ *      you sequence you need to call this function
+ *
+ * Note: Each ADC has multiple sequences that control the
+ *       ADC
+ *
+ *       This also hardcodes for single ended mode. This
+ *       If you need differential, either consult the TivaWare
+ *       manual and modify this function,write your own function,
+ *       or contact someone who feels like modifying it for you
+ *
+ * Sequence Note: know that which sequence you select will limit how
+ *                how many channels/pins you can assign.
+ *
+ *                If you input more pins than are available to that sequence
+ *                the function will disregard those pins
+ *
+ *                Sequence 0 - 8 steps/channels
+ *                Sequence 1 - 4 steps/channels
+ *                Sequence 2 - 4 steps/channels
+ *                Sequence 3 - 1 step/channel
+ *
+ * Interrupts Note: This function will always configure the
+ *              ADC to set it's ISR flag without enabling the
+ *              interrupt.
+ *
+ *              If you want to use this without interrupts,
+ *              poll the ISR flag, and clear the interrupt using
+ *              IntClear
+ *
+ *              refer to page 32 section 4.2.2.18
+ *              for more information on using
+ *              the interrupts
+ *
+ *              You'll need to register an interrupt
+ *              function and call the enable functions
+ *
+ * Parameters: ENSURE STEP NUM AND NUMBER OF 1S IN BITFIELD ARE EQUAL OTHERWISE,THE FUNCTION WILL BREAK
+ * adc_base - from TIVA library either ADC0_BASE or ADC1_BASE
+ * Seq_num - which sequence you wish to enable(see Sequence defines in this header)
+ * pin_bitfield - what pins you're using(see pin defines in this header)
+ * trig - from mil_trig_t, this specifies what triggers your ADC
+ *
+ * USE NOTES TO GET DATA:
+ *  Poll for interrupt flag using
+ *  ADCIntStatus(ADCx_BASE, MIL_ADC_SEQx, false);
+ *
+ *  Clear the Interrupt flag with
+ *  ADCIntClear(ADCx_BASE, MIL_ADC_SEQx);
+ *
+ * receive data into buffer with
+ * ADCSequenceDataGet(ADC0_BASE,MIL_ADC_SEQx,array_pointer); where the array point points to an array of 32 bit values
+ *
+ * Arrays are points in C/C++
+ */
+mil_adc_stat_t MIL_ADCSeqInit(uint32_t base,uint8_t seq_num,uint16_t pin_bitfield,mil_trig_t trig){
+
+   if(base == ADC0_BASE){
+
+       SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+       SysCtlPeripheralReset(SYSCTL_PERIPH_ADC0);
+       MIL_ADC_HwAvg[0] = 1;
+
+   }
+   else if(base == ADC1_BASE){
+
+       SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC1);
+       SysCtlPeripheralReset(SYSCTL_PERIPH_ADC1);
+       MIL_ADC_HwAvg[1] = 1;
+
+   }
+   else{
+
+       return MIL_ADC_NOK;
+   }
+
+    //forget any old step layout until this one is fully written
+    if(seq_num <= MIL_ADC_SEQ3){
+        MIL_ADC_SeqSteps[MIL_ADCModuleIdx(base)][seq_num] = 0;
+    }
+
+    pin_bitfield = pin_bitfield & 0x0FFF; //get rid of extraneous bits
+
+    uint32_t local_trig;
+
+    //determine trigger source
+    switch(trig){
+        case MIL_ADC_SoftTrig:
+            local_trig = ADC_TRIGGER_PROCESSOR;
+            break;
+        case MIL_ADC_TimTrig:
+            local_trig = ADC_TRIGGER_TIMER;
+            break;
+        case MIL_ADC_AlwaysTrig:
+            local_trig = ADC_TRIGGER_ALWAYS;
+            break;
+        default:
+            local_trig = ADC_TRIGGER_PROCESSOR;
+            break;
+    }
+
+    ADCSequenceConfigure(base,seq_num,local_trig,seq_num);
+
+    uint8_t step_max;
+
+    //generate max number of steps
+    switch(seq_num){
+        case MIL_ADC_SEQ0:
+            step_max = 8;
+            break;
+
+        case MIL_ADC_SEQ1:
+            step_max = 4;
+            break;
+
+        case MIL_ADC_SEQ2:
+            step_max = 4;
+            break;
+
+        case MIL_ADC_SEQ3:
+            step_max = 1;
+            break;
+        default:
+            step_max = 1;
+            break;
+    }
+
+    uint8_t step_need = 0;
+    uint16_t temp_field = pin_bitfield;
+
+    //count needed steps based on bitfield
+    while(temp_field){
+
+        //check each bit for a 1,
+        //if there's a 1 ,then there's a step needed for that channel
+        if(temp_field & 0x01){
+
+            step_need++;
+
+        }
+
+        //shift bits into the lsb,when this hits all 0s ,the function will end
+        temp_field = temp_field >> 1;
+
+
+    }
+
+    uint8_t actual_steps;
+
+    if(step_need > step_max){
+
+        actual_steps = step_max;
+
+    }
+    else{
+
+        actual_steps = step_need;
+
+    }
+
+
+    temp_field = pin_bitfield;
+    uint8_t channel = 0;
+
+    //step configurations
+    /*
+     * in effect this function configures each step by
+     * assign each sequential step to the next available channel
+     */
+    for(uint8_t i = 0;i < actual_steps;i++){
+
+        temp_field = pin_bitfield & (0x01<<channel);
+
+        //if field = 0 after the bit wise and,
+        //generate a new field
+        while(!temp_field){
+
+            channel++;
+            temp_field = pin_bitfield & (0x01<<channel);
+
+            if(channel > 11){
+
+                return MIL_ADC_NOK;
+
+            }
+
+        }
+
+        uint32_t config_field = channel; //set channel and enable interrupts for that step
+
+        //if this is the last step, configure it as so by adding the
+        //End flag
+        if((i+1) == actual_steps){
+
+            config_field |= ADC_CTL_END | ADC_CTL_IE;
+
+        }
+
+        ADCSequenceStepConfigure(base, seq_num, i, config_field);
+
+        //remember the channel in case this sequence gets streamed
+        if(seq_num <= MIL_ADC_SEQ3){
+            MIL_ADC_SeqChan[MIL_ADCModuleIdx(base)][seq_num][i] = channel;
+        }
+
+        channel++;
+
+    }
+
+
+    if(seq_num <= MIL_ADC_SEQ3){
+        MIL_ADC_SeqSteps[MIL_ADCModuleIdx(base)][seq_num] = actual_steps;
+    }
+
+    ADCSequenceEnable(base,seq_num);
+
+    ADCIntClear(base,seq_num);
+
+    return MIL_ADC_OK;
+}
+
+/*
+ * Desc: enable adc interrupts
+ *
+ * Note: will trigger upon a conversion finishing
+ *
+ * Parameters:
+ *  isr_ptr - pointer to your isr
+ *  base - ADC base
+ *  seq_num- your sequence number
+ *
+ */
+void MIL_ADCIntEnable(void (*isr_ptr)(void),uint32_t base,uint8_t seq_num){
+
+    ADCIntRegister(base,seq_num,isr_ptr);
+
+    ADCIntEnable(base,seq_num);
+
+}
+
+/*
+ * Desc: Runs get data sequence specified in the ADCSeqInit function
+ *       This function can also be called in interrupts if need be
+ *
+ * Note:
+ *      This includes a wait function that will wait for new data or
+ *      the user specified timer is reached
+ *
+ *      You can also implment there to be no wait, in which case the function
+ *      will exit immediately if there is no new data
+ *
+ * Sequence:
+ *  Poll for interrupt flag using
+ *  ADCIntStatus(ADCx_BASE, MIL_ADC_SEQx, false);
+ *
+ *  Clear the Interrupt flag with
+ *  ADCIntClear(ADCx_BASE, MIL_ADC_SEQx);
+ *
+ * receive data into buffer with
+ * ADCSequenceDataGet(ADC0_BASE,MIL_ADC_SEQx,array_pointer); where the array point points to an array of 32 bit values
+ *
+ * Parameters:
+ *  base - from TivaWare, your ADCx_BASE(either 0 or 1 for or x)
+ *  seq_num- from mil header, which MIL_ADC_SEQx( 0 to 3 for x)
+ *  timeout- how many cycles you wish to wait for the ADC to provide data
+ *  pbuffer - pointer to output buffer (MUST USE POINT TO UIN32_T OR IT'LL DIE)
+ *
+ * Returns:
+ *  mil_adc_status_t - MIL_ADC_OK if there's new data
+ *                     MIL_ADC_NOK if there's no new data
+ */
+mil_adc_stat_t MIL_ADCGetData(uint32_t base,uint8_t seq_num,uint32_t timeout,uint32_t *pbuffer){
+
+    uint32_t timeout_cnt = 0;
+
+    //wait for new adc data
+    while(!ADCIntStatus(base,seq_num,false)){
+
+        timeout_cnt++;
+        if(timeout_cnt == timeout){
+
+            return MIL_ADC_NOK;
+
+        }
+
+    }
+
+    //get data
+    ADCSequenceDataGet(base,seq_num,pbuffer);
+
+    //clear interrupt
+    ADCIntClear(base,seq_num);
+
+    //if you've reached here, there was data therefore OK
+    return MIL_ADC_OK;
+
+}
+/*
+ * Desc: sets hardware averaging for a whole ADC module
+ *
+ * Note: MIL_ADCSeqInit resets the module which clears this, so call
+ *       this after your sequences are set up
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  factor - 1(off),2,4,8,16,32 or 64 samples averaged per step
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad base or factor
+ */
+mil_adc_stat_t MIL_ADCOversampleSet(uint32_t base,uint8_t factor){
+
+    if(MIL_ADCModuleIdx(base) < 0){
+        return MIL_ADC_NOK;
+    }
+
+    //has to be a power of 2 up to 64
+    if(!factor || (factor > 64) || (factor & (factor - 1))){
+        return MIL_ADC_NOK;
+    }
+
+    //driverlib takes 0 for off
+    ADCHardwareOversampleConfigure(base,(factor == 1) ? 0 : factor);
+    MIL_ADC_HwAvg[MIL_ADCModuleIdx(base)] = factor;
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: sets up a sequence that samples one channel on several steps
+ *
+ * Note: unlike MIL_ADCSeqInit this won't reset the ADC module, so
+ *       other sequences and the hardware averaging are left alone
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ *  pin_bm - ONE of the MIL_ADC_PINx_bm defines
+ *  repeats - how many steps sample it, capped at the sequence's
+ *            size(8 for SEQ0, 4 for SEQ1/SEQ2, 1 for SEQ3)
+ *  trig - from mil_trig_t, what triggers the sequence
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad base, sequence or pin_bm
+ */
+mil_adc_stat_t MIL_ADCSeqInitRepeat(uint32_t base,
+                                    uint8_t seq_num,
+                                    uint16_t pin_bm,
+                                    uint8_t repeats,
+                                    mil_trig_t trig){
+
+    int8_t mod = MIL_ADCModuleIdx(base);
+    uint8_t step_max;
+    uint8_t channel = 0;
+    uint32_t local_trig;
+
+    if((mod < 0) || (seq_num > MIL_ADC_SEQ3) || !repeats){
+        return MIL_ADC_NOK;
+    }
+
+    //exactly one pin
+    pin_bm &= 0x0FFF;
+    if(!pin_bm || (pin_bm & (pin_bm - 1))){
+        return MIL_ADC_NOK;
+    }
+    while(!(pin_bm & (0x01 << channel))){
+        channel++;
+    }
+
+    step_max = (seq_num == MIL_ADC_SEQ0) ? 8 : ((seq_num == MIL_ADC_SEQ3) ? 1 : 4);
+    if(repeats > step_max){
+        repeats = step_max;
+    }
+
+    switch(trig){
+        case MIL_ADC_TimTrig:
+            local_trig = ADC_TRIGGER_TIMER;
+            break;
+        case MIL_ADC_AlwaysTrig:
+            local_trig = ADC_TRIGGER_ALWAYS;
+            break;
+        default:
+            local_trig = ADC_TRIGGER_PROCESSOR;
+            break;
+    }
+
+    SysCtlPeripheralEnable(mod ? SYSCTL_PERIPH_ADC1 : SYSCTL_PERIPH_ADC0);
+    while(!SysCtlPeripheralReady(mod ? SYSCTL_PERIPH_ADC1 : SYSCTL_PERIPH_ADC0)){}
+
+    ADCSequenceDisable(base,seq_num);
+    ADCSequenceConfigure(base,seq_num,local_trig,seq_num);
+
+    for(uint8_t i = 0;i < repeats;i++){
+
+        uint32_t config_field = channel;
+
+        if((i + 1) == repeats){
+            config_field |= ADC_CTL_END | ADC_CTL_IE;
+        }
+
+        ADCSequenceStepConfigure(base,seq_num,i,config_field);
+        MIL_ADC_SeqChan[mod][seq_num][i] = channel;
+
+    }
+    MIL_ADC_SeqSteps[mod][seq_num] = repeats;
+
+    ADCSequenceEnable(base,seq_num);
+
+    ADCIntClear(base,seq_num);
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: waits for a repeated sequence like MIL_ADCGetData and
+ *       decimates every step into one result
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ *  timeout - how many cycles you wish to wait for the ADC to provide data
+ *  sum - false gives the rounded 12 bit average, true gives the sum of
+ *        every step(up to 8 * 0xFFF, the extra bits are real resolution
+ *        once the averaging is past the noise)
+ *  presult - where the result goes
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_OK if there's new data
+ *                   MIL_ADC_NOK if there's no new data
+ */
+mil_adc_stat_t MIL_ADCGetAveraged(uint32_t base,
+                                  uint8_t seq_num,
+                                  uint32_t timeout,
+                                  bool sum,
+                                  uint16_t *presult){
+
+    int8_t mod = MIL_ADCModuleIdx(base);
+    uint32_t samples[8];
+    uint32_t total = 0;
+    uint8_t count;
+
+    if((mod < 0) || (seq_num > MIL_ADC_SEQ3) || !MIL_ADC_SeqSteps[mod][seq_num]){
+        return MIL_ADC_NOK;
+    }
+
+    if(MIL_ADCGetData(base,seq_num,timeout,samples) != MIL_ADC_OK){
+        return MIL_ADC_NOK;
+    }
+
+    count = MIL_ADC_SeqSteps[mod][seq_num];
+    for(uint8_t i = 0;i < count;i++){
+        total += samples[i] & 0x0FFF;
+    }
+
+    if(sum){
+        *presult = (uint16_t)total;
+    }
+    else{
+        *presult = (uint16_t)((total + (count >> 1)) / count);
+    }
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: runs a sequence at a fixed rate off a general purpose timer
+ *
+ * Note: the sequence is switched to MIL_ADC_TimTrig if it wasn't already
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx, already set up with MIL_ADCSeqInit or
+ *            MIL_ADCSeqInitRepeat
+ *  timer_base - TIMER0_BASE to TIMER5_BASE(timer A is used at full width)
+ *  rate_hz - how many times a second the sequence runs
+ *  pactual_hz - where the rate you really got goes, can be 0
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad base, sequence or timer, or
+ *                   a rate the ADC can't keep up with
+ */
+mil_adc_stat_t MIL_ADCTimerTrigInit(uint32_t base,
+                                    uint8_t seq_num,
+                                    uint32_t timer_base,
+                                    uint32_t rate_hz,
+                                    uint32_t *pactual_hz){
+
+    int8_t mod = MIL_ADCModuleIdx(base);
+    uint32_t periph;
+    uint32_t clock;
+    uint32_t period;
+    uint32_t conversions;
+
+    if((mod < 0) || (seq_num > MIL_ADC_SEQ3) || !rate_hz){
+        return MIL_ADC_NOK;
+    }
+
+    switch(timer_base){
+        case TIMER0_BASE: periph = SYSCTL_PERIPH_TIMER0; break;
+        case TIMER1_BASE: periph = SYSCTL_PERIPH_TIMER1; break;
+        case TIMER2_BASE: periph = SYSCTL_PERIPH_TIMER2; break;
+        case TIMER3_BASE: periph = SYSCTL_PERIPH_TIMER3; break;
+        case TIMER4_BASE: periph = SYSCTL_PERIPH_TIMER4; break;
+        case TIMER5_BASE: periph = SYSCTL_PERIPH_TIMER5; break;
+        default: return MIL_ADC_NOK;
+    }
+
+    //every trigger runs every step, each step is hardware averaging conversions
+    conversions = (uint32_t)MIL_ADC_SeqSteps[mod][seq_num] * MIL_ADC_HwAvg[mod];
+    if(!conversions || (rate_hz > (MIL_ADC_CONV_RATE / conversions))){
+        return MIL_ADC_NOK;
+    }
+
+    //rounded to the nearest whole clock
+    clock = SysCtlClockGet();
+    period = (clock + (rate_hz >> 1)) / rate_hz;
+    if(period < 2){
+        return MIL_ADC_NOK;
+    }
+
+    if(pactual_hz){
+        *pactual_hz = clock / period;
+    }
+
+    //make sure the sequence listens to the timer
+    ADCSequenceDisable(base,seq_num);
+    ADCSequenceConfigure(base,seq_num,ADC_TRIGGER_TIMER,seq_num);
+    ADCSequenceEnable(base,seq_num);
+
+    SysCtlPeripheralEnable(periph);
+    while(!SysCtlPeripheralReady(periph)){}
+
+    TimerDisable(timer_base,TIMER_A);
+    TimerConfigure(timer_base,TIMER_CFG_PERIODIC);
+    TimerLoadSet(timer_base,TIMER_A,period - 1);
+    TimerControlTrigger(timer_base,TIMER_A,true);
+    TimerEnable(timer_base,TIMER_A);
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: stops the timer from triggering the ADC
+ *
+ * Parameters:
+ *  timer_base - the timer passed to MIL_ADCTimerTrigInit
+ */
+void MIL_ADCTimerTrigStop(uint32_t timer_base){
+
+    TimerDisable(timer_base,TIMER_A);
+    TimerControlTrigger(timer_base,TIMER_A,false);
+
+}
+
+/*
+ * Desc: rewrites a sequence's steps so the interrupt bit is set every
+ *       arb steps, the uDMA moves arb samples each time one fires
+ */
+static void MIL_ADCStepsWrite(uint32_t base,uint8_t seq_num,uint8_t arb){
+
+    int8_t mod = MIL_ADCModuleIdx(base);
+    uint8_t steps = MIL_ADC_SeqSteps[mod][seq_num];
+
+    for(uint8_t i = 0;i < steps;i++){
+
+        uint32_t config_field = MIL_ADC_SeqChan[mod][seq_num][i];
+
+        if(((i + 1) % arb) == 0){
+            config_field |= ADC_CTL_IE;
+        }
+        if((i + 1) == steps){
+            config_field |= ADC_CTL_END;
+        }
+
+        ADCSequenceStepConfigure(base,seq_num,i,config_field);
+
+    }
+
+}
+
+/*
+ * Desc: uDMA done handler for every stream
+ *
+ * Note: whichever half stopped is handed back to the uDMA before the
+ *       callback runs, so the callback has until the other half fills
+ *       up to finish with its buffer
+ */
+static void MIL_ADCStreamService(uint8_t mod,uint8_t seq_num){
+
+    mil_adc_stream_t *pstream = &MIL_ADC_Streams[mod][seq_num];
+    uint32_t base = mod ? ADC1_BASE : ADC0_BASE;
+    uint32_t src = base + ADC_O_SSFIFO0 + (0x20 * (uint32_t)seq_num);
+    uint32_t ch = pstream->dma_ch;
+    bool overrun;
+
+    ADCIntClear(base,seq_num);
+
+    if(!pstream->callback){
+        return;
+    }
+
+    //both halves done means the uDMA stopped and samples were lost
+    overrun = (uDMAChannelModeGet(ch | UDMA_PRI_SELECT) == UDMA_MODE_STOP) &&
+              (uDMAChannelModeGet(ch | UDMA_ALT_SELECT) == UDMA_MODE_STOP);
+
+    //hand back the finished halves in the order they filled
+    for(uint8_t i = 0;i < 2;i++){
+
+        uint32_t select = pstream->alt_next ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+        uint32_t *pbuffer = pstream->alt_next ? pstream->ppong : pstream->pping;
+
+        if(uDMAChannelModeGet(ch | select) != UDMA_MODE_STOP){
+            break;
+        }
+
+        uDMAChannelTransferSet(ch | select,UDMA_MODE_PINGPONG,
+                               (void *)src,pbuffer,pstream->num_samples);
+        pstream->alt_next = !pstream->alt_next;
+
+        pstream->callback(pbuffer,pstream->num_samples);
+
+    }
+
+    if(overrun){
+
+        pstream->overruns++;
+        ADCSequenceOverflowClear(base,seq_num);
+        uDMAChannelEnable(ch);
+
+    }
+
+}
+
+static void MIL_ADC0Seq0StreamISR(void){MIL_ADCStreamService(0,0);}
+static void MIL_ADC0Seq1StreamISR(void){MIL_ADCStreamService(0,1);}
+static void MIL_ADC0Seq2StreamISR(void){MIL_ADCStreamService(0,2);}
+static void MIL_ADC0Seq3StreamISR(void){MIL_ADCStreamService(0,3);}
+static void MIL_ADC1Seq0StreamISR(void){MIL_ADCStreamService(1,0);}
+static void MIL_ADC1Seq1StreamISR(void){MIL_ADCStreamService(1,1);}
+static void MIL_ADC1Seq2StreamISR(void){MIL_ADCStreamService(1,2);}
+static void MIL_ADC1Seq3StreamISR(void){MIL_ADCStreamService(1,3);}
+
+static void (* const MIL_ADC_StreamISRs[2][4])(void) = {
+    {MIL_ADC0Seq0StreamISR,MIL_ADC0Seq1StreamISR,MIL_ADC0Seq2StreamISR,MIL_ADC0Seq3StreamISR},
+    {MIL_ADC1Seq0StreamISR,MIL_ADC1Seq1StreamISR,MIL_ADC1Seq2StreamISR,MIL_ADC1Seq3StreamISR}
+};
+
+/*
+ * Desc: starts continuous uDMA acquisition on a sequence that was set up
+ *       with MIL_ADCSeqInit
+ *
+ * Note: the sequence's interrupt bits get rewritten so the uDMA is
+ *       asked to move a burst every 1,2,4 or 8 steps(the biggest power
+ *       of 2 that divides the step count), and the sequence interrupt
+ *       itself stays masked so the CPU only hears about full buffers
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ *  pping - first buffer, num_samples long
+ *  ppong - second buffer, num_samples long
+ *  num_samples - samples per buffer, a multiple of the sequence's steps
+ *                up to MIL_ADC_STREAM_MAX_SAMPLES
+ *  callback - called with each buffer as it fills
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad base, sequence or buffer size
+ */
+mil_adc_stat_t MIL_ADCStreamStart(uint32_t base,
+                                  uint8_t seq_num,
+                                  uint32_t *pping,
+                                  uint32_t *ppong,
+                                  uint16_t num_samples,
+                                  mil_adc_stream_cb_t callback){
+
+    static bool dma_ready = false;
+    int8_t mod = MIL_ADCModuleIdx(base);
+    mil_adc_stream_t *pstream;
+    uint32_t src;
+    uint8_t steps;
+    uint8_t arb;
+    uint32_t arb_flag;
+
+    if((mod < 0) || (seq_num > MIL_ADC_SEQ3) || !pping || !ppong || !callback){
+        return MIL_ADC_NOK;
+    }
+
+    steps = MIL_ADC_SeqSteps[mod][seq_num];
+    if(!steps || !num_samples || (num_samples > MIL_ADC_STREAM_MAX_SAMPLES) ||
+       (num_samples % steps)){
+        return MIL_ADC_NOK;
+    }
+
+    //one time uDMA setup
+    if(!dma_ready){
+
+        SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+        while(!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA)){}
+#ifndef MIL_ADC_DMA_EXTERNAL_TABLE
+        uDMAEnable();
+        uDMAControlBaseSet(MIL_ADC_DMATable);
+#endif
+        dma_ready = true;
+
+    }
+
+    //biggest burst that lands on a sequence boundary
+    if(!(steps & 0x07)){
+        arb = 8;
+        arb_flag = UDMA_ARB_8;
+    }
+    else if(!(steps & 0x03)){
+        arb = 4;
+        arb_flag = UDMA_ARB_4;
+    }
+    else if(!(steps & 0x01)){
+        arb = 2;
+        arb_flag = UDMA_ARB_2;
+    }
+    else{
+        arb = 1;
+        arb_flag = UDMA_ARB_1;
+    }
+
+    pstream = &MIL_ADC_Streams[mod][seq_num];
+    pstream->callback = 0;
+    pstream->pping = pping;
+    pstream->ppong = ppong;
+    pstream->num_samples = num_samples;
+    pstream->dma_ch = (uint8_t)(MIL_ADC_DMAAssign[mod][seq_num] & 0xFF);
+    pstream->alt_next = false;
+    pstream->overruns = 0;
+
+    ADCSequenceDisable(base,seq_num);
+    MIL_ADCStepsWrite(base,seq_num,arb);
+
+    //set up the channel, FIFO register to buffer, one word at a time
+    uDMAChannelAssign(MIL_ADC_DMAAssign[mod][seq_num]);
+    uDMAChannelAttributeDisable(pstream->dma_ch,
+                                UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+                                UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+
+    uDMAChannelControlSet(pstream->dma_ch | UDMA_PRI_SELECT,
+                          UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | arb_flag);
+    uDMAChannelControlSet(pstream->dma_ch | UDMA_ALT_SELECT,
+                          UDMA_SIZE_32 | UDMA_SRC_INC_NONE | UDMA_DST_INC_32 | arb_flag);
+
+    src = base + ADC_O_SSFIFO0 + (0x20 * (uint32_t)seq_num);
+    uDMAChannelTransferSet(pstream->dma_ch | UDMA_PRI_SELECT,UDMA_MODE_PINGPONG,
+                           (void *)src,pping,num_samples);
+    uDMAChannelTransferSet(pstream->dma_ch | UDMA_ALT_SELECT,UDMA_MODE_PINGPONG,
+                           (void *)src,ppong,num_samples);
+
+    pstream->callback = callback;
+
+    //the uDMA done interrupt comes in on the sequence's vector,
+    //the sequence interrupt itself stays off
+    ADCIntDisable(base,seq_num);
+    ADCIntClear(base,seq_num);
+    ADCIntRegister(base,seq_num,MIL_ADC_StreamISRs[mod][seq_num]);
+
+    ADCSequenceOverflowClear(base,seq_num);
+    ADCSequenceDMAEnable(base,seq_num);
+    uDMAChannelEnable(pstream->dma_ch);
+    ADCSequenceEnable(base,seq_num);
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: stops a stream, the buffer being filled is dropped
+ *
+ * Note: the sequence goes back to how MIL_ADCSeqInit left it
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ */
+void MIL_ADCStreamStop(uint32_t base,uint8_t seq_num){
+
+    int8_t mod = MIL_ADCModuleIdx(base);
+    mil_adc_stream_t *pstream;
+
+    if((mod < 0) || (seq_num > MIL_ADC_SEQ3)){
+        return;
+    }
+
+    pstream = &MIL_ADC_Streams[mod][seq_num];
+    if(!pstream->callback){
+        return;
+    }
+
+    ADCSequenceDisable(base,seq_num);
+    uDMAChannelDisable(pstream->dma_ch);
+    ADCSequenceDMADisable(base,seq_num);
+    ADCIntUnregister(base,seq_num);
+    pstream->callback = 0;
+
+    MIL_ADCStepsWrite(base,seq_num,MIL_ADC_SeqSteps[mod][seq_num]);
+    ADCIntClear(base,seq_num);
+    ADCSequenceEnable(base,seq_num);
+
+}
+
+/*
+ * Desc: how many times both buffers filled before the callback
+ *       gave one back(each one is a gap in the samples)
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ */
+uint32_t MIL_ADCStreamOverruns(uint32_t base,uint8_t seq_num){
+
+    int8_t mod = MIL_ADCModuleIdx(base);
+
+    if((mod < 0) || (seq_num > MIL_ADC_SEQ3)){
+        return 0;
+    }
+
+    return MIL_ADC_Streams[mod][seq_num].overruns;
+
+}
+
+/*
+ * Desc: sets one channel's calibration directly
+ *
+ * Parameters:
+ *  channel - 0 to 11 for AIN0 to AIN11
+ *  gain_q16 - mV per count in Q16(MIL_ADC_GAIN_Q16_NOMINAL is ideal)
+ *  offset_q16 - mV added after the gain in Q16
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad channel or a gain that
+ *                   could overflow(over 4x nominal or negative)
+ */
+mil_adc_stat_t MIL_ADCCalSet(uint8_t channel,int32_t gain_q16,int32_t offset_q16){
+
+    //keeps raw * gain + offset inside 32 bits
+    if((channel > 11) || (gain_q16 < 0) || (gain_q16 > MIL_ADC_CAL_GAIN_MAX) ||
+       (offset_q16 > MIL_ADC_CAL_OFFSET_MAX) || (offset_q16 < -MIL_ADC_CAL_OFFSET_MAX)){
+        return MIL_ADC_NOK;
+    }
+
+    MIL_ADC_CalTable[channel].gain_q16 = gain_q16;
+    MIL_ADC_CalTable[channel].offset_q16 = offset_q16;
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: works out one channel's calibration from two known points
+ *
+ * Parameters:
+ *  channel - 0 to 11 for AIN0 to AIN11
+ *  raw_lo,mv_lo - raw reading at a known low voltage
+ *  raw_hi,mv_hi - raw reading at a known high voltage
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad channel or points that don't
+ *                   make a sensible line
+ */
+mil_adc_stat_t MIL_ADCCalTwoPoint(uint8_t channel,
+                                  uint16_t raw_lo,
+                                  uint16_t mv_lo,
+                                  uint16_t raw_hi,
+                                  uint16_t mv_hi){
+
+    int64_t gain;
+    int64_t offset;
+
+    if((raw_hi <= raw_lo) || (mv_hi <= mv_lo)){
+        return MIL_ADC_NOK;
+    }
+
+    //slope rounded to the nearest Q16 step, then the offset that puts
+    //the line through the low point
+    gain = ((((int64_t)mv_hi - mv_lo) << 16) + ((raw_hi - raw_lo) >> 1)) / (raw_hi - raw_lo);
+    offset = ((int64_t)mv_lo << 16) - (gain * raw_lo);
+
+    if((gain > MIL_ADC_CAL_GAIN_MAX) || (offset > MIL_ADC_CAL_OFFSET_MAX) ||
+       (offset < -MIL_ADC_CAL_OFFSET_MAX)){
+        return MIL_ADC_NOK;
+    }
+
+    return MIL_ADCCalSet(channel,(int32_t)gain,(int32_t)offset);
+
+}
+
+/*
+ * Desc: one conversion, shared by the single and buffer versions
+ */
+static inline uint16_t MIL_ADCCalApply(const mil_adc_cal_t *pcal,uint32_t raw){
+
+    int32_t acc = (int32_t)(raw & 0x0FFF) * pcal->gain_q16 + pcal->offset_q16 + 0x8000;
+
+    return (acc < 0) ? 0 : (uint16_t)(acc >> 16);
+
+}
+
+/*
+ * Desc: converts one raw value with a channel's calibration
+ *
+ * Parameters:
+ *  channel - 0 to 11 for AIN0 to AIN11
+ *  raw - 12 bit ADC value
+ *
+ * Returns:
+ *  millivolts, 0 if the calibration takes it negative
+ */
+uint16_t MIL_ADCRawToMilliVolts(uint8_t channel,uint16_t raw){
+
+    if(channel > 11){
+        return 0;
+    }
+
+    return MIL_ADCCalApply(&MIL_ADC_CalTable[channel],raw);
+
+}
+
+/*
+ * Desc: converts a whole buffer from a sequence set up with
+ *       MIL_ADCSeqInit or MIL_ADCSeqInitRepeat, each sample gets
+ *       the calibration of the channel its step reads
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ *  praw - samples as they came out of the sequence(or a stream buffer)
+ *  num_samples - how many
+ *  pmv - where the millivolts go, num_samples long(can't be praw)
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK if the sequence was never set up
+ */
+mil_adc_stat_t MIL_ADCToMilliVolts(uint32_t base,
+                                   uint8_t seq_num,
+                                   const uint32_t *praw,
+                                   uint16_t num_samples,
+                                   uint16_t *pmv){
+
+    int8_t mod = MIL_ADCModuleIdx(base);
+    const mil_adc_cal_t *pcal[8];
+    uint8_t steps;
+
+    if((mod < 0) || (seq_num > MIL_ADC_SEQ3)){
+        return MIL_ADC_NOK;
+    }
+
+    steps = MIL_ADC_SeqSteps[mod][seq_num];
+    if(!steps){
+        return MIL_ADC_NOK;
+    }
+
+    //look the calibration for each step up once, not once per sample
+    for(uint8_t i = 0;i < steps;i++){
+        pcal[i] = &MIL_ADC_CalTable[MIL_ADC_SeqChan[mod][seq_num][i]];
+    }
+
+    //a run of the sequence at a time, the last one may be cut short
+    for(uint16_t i = 0;i < num_samples;i += steps){
+
+        uint16_t run = ((num_samples - i) < steps) ? (num_samples - i) : steps;
+
+        for(uint8_t step = 0;step < run;step++){
+            pmv[i + step] = MIL_ADCCalApply(pcal[step],praw[i + step]);
+        }
+
+    }
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: "00" to "99", two digits per lookup instead of one divide each
+ */
+static const char MIL_ADC_DecPairs[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+static const char MIL_ADC_HexDigits[16] = {
+    '0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'
+};
+
+/*
+ * Desc: checks the line fits, returns its length or 0
+ */
+static uint16_t MIL_ADCFormatLen(uint16_t num_values,uint8_t width,uint16_t buf_len){
+
+    uint32_t len;
+
+    if(!num_values){
+        return 0;
+    }
+
+    len = (uint32_t)num_values * (width + 1) + 1;
+
+    //room for the 0 too
+    return (len < buf_len) ? (uint16_t)len : 0;
+
+}
+
+/*
+ * Desc: formats millivolts as fixed width decimal, one line
+ *
+ * Note: values over 9999 are written as 9999
+ *
+ * Parameters:
+ *  pmv - values from MIL_ADCToMilliVolts
+ *  num_values - how many
+ *  delim - what goes between values(',' or ' ' or '\t')
+ *  pbuf - where the line is written, 0 terminated
+ *  buf_len - size of pbuf
+ *
+ * Returns:
+ *  length of the line without the 0, 0 if pbuf is too small
+ */
+uint16_t MIL_ADCFormatMilliVolts(const uint16_t *pmv,
+                                 uint16_t num_values,
+                                 char delim,
+                                 char *pbuf,
+                                 uint16_t buf_len){
+
+    uint16_t len = MIL_ADCFormatLen(num_values,4,buf_len);
+    char *p = pbuf;
+
+    if(!len){
+        return 0;
+    }
+
+    for(uint16_t i = 0;i < num_values;i++){
+
+        uint32_t mv = (pmv[i] > 9999) ? 9999 : pmv[i];
+        uint32_t hi = mv / 100; //a multiply and shift, not a real divide
+        uint32_t lo = mv - (hi * 100);
+
+        p[0] = MIL_ADC_DecPairs[hi * 2];
+        p[1] = MIL_ADC_DecPairs[hi * 2 + 1];
+        p[2] = MIL_ADC_DecPairs[lo * 2];
+        p[3] = MIL_ADC_DecPairs[lo * 2 + 1];
+        p[4] = delim;
+        p += 5;
+
+    }
+
+    //line ending goes over the last delimiter
+    p[-1] = '\r';
+    p[0] = '\n';
+    p[1] = 0;
+
+    return len;
+
+}
+
+/*
+ * Desc: formats raw samples as 3 digit hex, one line
+ *
+ * Parameters:
+ *  praw - samples straight out of the sequence
+ *  num_values - how many
+ *  delim - what goes between values(',' or ' ' or '\t')
+ *  pbuf - where the line is written, 0 terminated
+ *  buf_len - size of pbuf
+ *
+ * Returns:
+ *  length of the line without the 0, 0 if pbuf is too small
+ */
+uint16_t MIL_ADCFormatHex(const uint32_t *praw,
+                          uint16_t num_values,
+                          char delim,
+                          char *pbuf,
+                          uint16_t buf_len){
+
+    uint16_t len = MIL_ADCFormatLen(num_values,3,buf_len);
+    char *p = pbuf;
+
+    if(!len){
+        return 0;
+    }
+
+    for(uint16_t i = 0;i < num_values;i++){
+
+        uint32_t raw = praw[i];
+
+        p[0] = MIL_ADC_HexDigits[(raw >> 8) & 0x0F];
+        p[1] = MIL_ADC_HexDigits[(raw >> 4) & 0x0F];
+        p[2] = MIL_ADC_HexDigits[raw & 0x0F];
+        p[3] = delim;
+        p += 4;
+
+    }
+
+    p[-1] = '\r';
+    p[0] = '\n';
+    p[1] = 0;
+
+    return len;
+
+}
+
+/*
+ * Desc: This function will convert a raw single ended ADC value to
+ *       its double equivalent
+ *
+ * Note: this is based on the equation of a line
+ *       in effect, the max adc value is 0xFFF which corresponds to
+ *       your reference voltage.
+ *
+ *       implemented with equation
+ *
+ *       m = 3V/0xFFF
+ *
+ *       Voltage = m*(raw ADC)
+ */
+float MIL_ADC_HextoFloat(uint16_t adc_value){
+
+    float voltage;
+    float slope = 3.0f/0xFFF; //3/0xFFF alone is integer math and always 0
+
+    voltage = adc_value * slope;
+    return voltage;
+}
+
+/*
+ * Desc: just incase you needed to convert the ADC values to ascii
+ *       This function will take your 12 bit ADC value and output
+ *       a string including its raw hex values
+ *
+ * Note: outstring is 3 bytes long
+ *
+ * Note: I used this for debugging
+ */
+void MIL_ADC_HEXtoASCII(uint16_t adc_value,char *pstring){
+
+    char hex_char[3];
+
+    //isolation
+    hex_char[0] = (adc_value>>8) & 0x000F;
+    hex_char[1] = (adc_value>>4) & 0x000F;
+    hex_char[2] =  adc_value     & 0x000F;
+
+    //conversion to ascii
+    for(uint8_t idx = 0; idx < 3;idx++){
+
+        if(hex_char[idx] > 9){
+
+            hex_char[idx] = hex_char[idx] + 0x37;
+
+        }
+        else{
+
+            hex_char[idx] = hex_char[idx] + 0x30;
+
+        }
+        //copy to outstring
+        pstring[idx] = hex_char[idx];
+    }
+
+}
+
+/*
+ * Desc: Converts a raw adc value into an ascii string
+ *
+ * Note: outstring is 4 bytes long
+ *
+ * Parameters:
+ *  adc_value - from the ADC output
+ *  pstring- pointer to outstring
+ *
+ */
+void MIL_ADC_FloattoASCII(uint16_t adc_value,char *pstring){
+
+     double result_double = (double)adc_value;
+
+     if(result_double < 0){
+            result_double = result_double * -1;
+     }
+
+     double org_res = (result_double*3)/4095;
+     int8_t res_int = (int8_t)org_res;           //first int
+     double res1 = 10*(org_res - res_int);
+     int8_t res_int1 = (int8_t)res1;             //second int
+     double res2 = 10*(res1 - res_int1);
+     int8_t res_int2 = (int8_t)res2;             //third int
+
+     //conversion to char
+     pstring[0]  = res_int  + 0x30;
+     pstring[1] = '.';
+     pstring[2] = res_int1 + 0x30;
+     pstring[3] = res_int2 + 0x30;
+
+}
+
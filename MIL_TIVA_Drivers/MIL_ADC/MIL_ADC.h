@@ -1,347 +1,789 @@
-/*
- * Name: MIL_ADC.h
- * Author: Marquez Jones
- * Last Modified: 3/6/2019
- * Desc: Set of ADC wrapper functions to simplify ADC use
- *
- * Note VRef: This header defaults our reference voltage to the internal 3V source
- *            this means a 0xFFF raw output from the ADC corresponds to 3V
- *
- *            this is also hardcoded to single ended mode meaning we're capped at 0V
- *
- *            This can be represented by the equation of a line with the ADC value being our x
- *            and our output being y
- *
- *            so slope(m) = (3V - 0V)/(0xFFF - 0x000)
- *
- *            Voltage = m*(raw ADC)
- *
- * Note: In effect, the ADC module has a good amount of
- *       modularity that  I reduced with these functions
- *       to provide an easy to use set of functions
- *
- *       This should be sufficient for most ADC uses
- *       in MIL.
- *
- *       In the case it isn't, you'll have to read both
- *       the ADC sections from TivaWare and the Manual
- *       in order to make a more custom solution
- *
- *FREE LEARNING:
- *https://sites.google.com/site/luiselectronicprojects/tutorials/tiva-tutorials/tiva-adc/understanding-the-tiva-adc
- */
-
-/*
- * WHAT YOU NEED TO UNDERSTAND WITHOUT READING THE ADC SECTION:
- * Refer to pages 800-801 of the TM4C123GH6PM manual
- * for tables to descibe sequences
- *
- * the Tiva has two possible ADC modules(ADC0 and ADC1)
- * Within these modules, you have multiple sequencers
- * effectively, what the sequencer does, is tell your adc
- * which channels it needs to check. So you can gather multiple
- * ADC samples from multiple different analog inputs and have those
- * results output to a buffer(some kind of array you declare)
- *
- * This is important to understand as it will change which sequencers you choose
- * There's 4 sequencers per ADC enumerated 0 to 3
- *
- * 3 can be assigned only one imput channel
- * 0 can be assigned 8 input channels
- *
- * Note if you were to write this code yourself, you check one pin
- * multiple times within a sequence. In this header, I hardcoded it to
- * assign unique channels to each sequence step
- *
- */
-
-#include <stdbool.h>
-#include <stdint.h>
-#include "inc/hw_memmap.h"
-#include "driverlib/adc.h"
-#include "driverlib/gpio.h"
-#include "driverlib/pin_map.h"
-#include "driverlib/sysctl.h"
-#include "driverlib/uart.h"
-#include "utils/uartstdio.h"
-
-#ifndef MIL_ADC_H_
-#define MIL_ADC_H_
-
-/*
- * Desc: bitmasks for all possible ADC pins
- *       this will be used by other functions
- *       in this header file
- *
- * TIVA ADC Notes:
- * The TM4C123G has 12 possible ADC input pins
- * The ports are verying
- * Please refer to table 23-3 for enumeration of pins
- *
- * Define Notes: On the right of each define
- *               I've indicated it's Pin name
- *               and the port and pin it's assoicated
- *               with. These are based on the TIVA
- *               semantics
- */
-#define MIL_ADC_PIN0_bm  0x01 << 0  //AIN0, PE3
-#define MIL_ADC_PIN1_bm  0x01 << 1  //AIN1, PE2
-#define MIL_ADC_PIN2_bm  0x01 << 2  //AIN2, PE1
-#define MIL_ADC_PIN3_bm  0x01 << 3  //AIN3, PE0
-#define MIL_ADC_PIN4_bm  0x01 << 4  //AIN4, PD3
-#define MIL_ADC_PIN5_bm  0x01 << 5  //AIN5, PD2
-#define MIL_ADC_PIN6_bm  0x01 << 6  //AIN6, PD1
-#define MIL_ADC_PIN7_bm  0x01 << 7  //AIN7, PD0
-#define MIL_ADC_PIN8_bm  0x01 << 8  //AIN8, PE5
-#define MIL_ADC_PIN9_bm  0x01 << 9  //AIN9, PE4
-#define MIL_ADC_PIN10_bm 0x01 << 10//AIN10, PB4
-#define MIL_ADC_PIN11_bm 0x01 << 11//AIN11, PB5
-
-//literally the same defines as above but these
-//are denoted by Port and Pin as well as channel
-#define MIL_ADC_CH0_PE3_bm  0x01 << 0  //AIN0, PE3
-#define MIL_ADC_CH1_PE2_bm  0x01 << 1  //AIN1, PE2
-#define MIL_ADC_CH2_PE1_bm  0x01 << 2  //AIN2, PE1
-#define MIL_ADC_CH3_PE0_bm  0x01 << 3  //AIN3, PE0
-#define MIL_ADC_CH4_PD3_bm  0x01 << 4  //AIN4, PD3
-#define MIL_ADC_CH5_PD2_bm  0x01 << 5  //AIN5, PD2
-#define MIL_ADC_CH6_PD1_bm  0x01 << 6  //AIN6, PD1
-#define MIL_ADC_CH7_PD0_bm  0x01 << 7  //AIN7, PD0
-#define MIL_ADC_CH8_PE5_bm  0x01 << 8  //AIN8, PE5
-#define MIL_ADC_CH9_PE4_bm  0x01 << 9  //AIN9, PE4
-#define MIL_ADC_CH10_PB4_bm 0x01 << 10//AIN10, PB4
-#define MIL_ADC_CH11_PB5_bm 0x01 << 11//AIN11, PB5
-
-//pins associated with Port E
-#define MIL_ADC_PORTE_gc  MIL_ADC_PIN0_bm | MIL_ADC_PIN1_bm | MIL_ADC_PIN2_bm | MIL_ADC_PIN3_bm | MIL_ADC_PIN8_bm | MIL_ADC_PIN9_bm
-#define MIL_ADC_PORTD_gc  MIL_ADC_PIN4_bm | MIL_ADC_PIN5_bm | MIL_ADC_PIN6_bm | MIL_ADC_PIN7_bm
-#define MIL_ADC_PORTB_gc  MIL_ADC_PIN10_bm | MIL_ADC_PIN11_bm
-
-/*
- * Refer to pages 800-801 of the TM4C123GH6PM manual
- * for tables to descibe sequences
- *
- * From an abstract perspect, each ADC module(ADC0 and ADC1)
- * have 4 sequencers attached to them. The sequencers are
- * what actually d
- *
- */
-
-//these defines are arbitrary as you can simply pass in the
-//the raw integer value,but these will increase readability
-#define MIL_ADC_SEQ0 0x00
-#define MIL_ADC_SEQ1 0x01
-#define MIL_ADC_SEQ2 0x02
-#define MIL_ADC_SEQ3 0x03
-
-/*
- * For the purpose of abstraction
- * I will limit our possible ADC
- * trigger sources to 3 options
- *
- * NOTE: VIEW ASSOCIATED FUNCTION IN TIVAWARE MANUAL
- * MIL_ADC_SoftTrig - trigger in software using ADCProcessorTrigger();
- * MIL_ADC_TimTrig  - triggered by configuring timer with TimerControlTrigger();
- * MIL_ADC_AlwaysTrig - ADC will always trigger
- *
- * These will be used by my ADC init function
- */
-typedef enum{
-    MIL_ADC_SoftTrig,
-    MIL_ADC_TimTrig,
-    MIL_ADC_AlwaysTrig
-}mil_trig_t;
-
-//
-/*
- * If there is a problem,
- * return NOK(not OK)
- *
- * else return ADC_OK
- */
-typedef enum{
-
-    MIL_ADC_OK,
-    MIL_ADC_NOK
-
-}mil_adc_stat_t;
-
-/*
- * Desc: This function will configure the selected ADC channel
- *       as enumerated by our MIL_ADC_PINx_bm defines. Each of
- *       of those is associated with one the 12 ADC channels
- *
- * Note: This function effectively calls the
- *       GPIOPinTypeADC() function for each ADC pin
- *       function will also call the peripheral clock enables
- *
- * Parameters: This function takes in a bitfield
- *             of each ADC pin desired bit wised ORed
- *             together
- *
- * Para Note: So if you wanted pins 3 and 7, you'd pass in
- *            uint16_t field = MIL_ADC_PIN3_bm | MIL_ADC_PIN7_bm
- */
-void MIL_ADCPinConfig(uint16_t bitfield);
-
-/*
- * Desc:This function enables individual sequences
- *      You will need to call this for each sequence
- *      you sequence you need to call this function
- *
- * Note: Each ADC has multiple sequences that control the
- *       ADC
- *
- *       This also hardcodes for single ended mode. This
- *       If you need differential, either consult the TivaWare
- *       manual and modify this function,write your own function,
- *       or contact someone who feels like modifying it for you
- *
- * Sequence Note: know that which sequence you select will limit how
- *                how many channels/pins you can assign.
- *
- *                If you input more pins than are available to that sequence
- *                the function will disregard those pins
- *
- *                Sequence 0 - 1 step/channel
- *                Sequence 1 - 4 steps/channels
- *                Sequence 2 - 4 steps/channels
- *                Sequence 3 - 8 steps/channels
- *
- * Interrupts Note: This function will always configure the
- *              ADC to set it's ISR flag without enabling the
- *              interrupt.
- *
- *              If you want to use this without interrupts,
- *              poll the ISR flag, and clear the interrupt using
- *              IntClear
- *
- *              refer to page 32 section 4.2.2.18
- *              for more information on using
- *              the interrupts
- *
- *              You'll need to register an interrupt
- *              function and call the enable functions
- *
- * Parameters:
- * adc_base - from TIVA library either ADC0_BASE or ADC1_BASE
- * Seq_num - which sequence you wish to enable(see Sequence defines in this header)
- * pin_bitfield - what pins you're using(see pin defines in this header)
- * trig - from mil_trig_t, this specifies what triggers your ADC
- *
- *
- * USE NOTES TO GET DATA:
- *  Poll for interrupt flag using
- *  ADCIntStatus(ADCx_BASE, MIL_ADC_SEQx, false);
- *
- *  Clear the Interrupt flag with
- *  ADCIntClear(ADCx_BASE, MIL_ADC_SEQx);
- *
- * receive data into buffer with
- * ADCSequenceDataGet(ADC0_BASE,MIL_ADC_SEQx,array_pointer); where the array point points to an array of 32 bit values
- *
- * Arrays are points in C/C++
- *
- * Returns: mil_adc_stat_t
- *          the only section of code that's able to return this is assigning
- *          sequences(check source code)
- *
- *          It basically means you passed in a bad parameter that caused the function
- *          not to exit relating to the bitfield
- */
-mil_adc_stat_t MIL_ADCSeqInit(uint32_t base,
-                    uint8_t seq_num,
-                    uint16_t pin_bitfield,
-                    mil_trig_t trig);
-
-/*
- * Desc: enable adc interrupts
- *
- * Note: will trigger upon a conversion finishing
- *
- * Parameters:
- *  isr_ptr - pointer to your isr
- *  base - ADC base
- *  seq_num- your sequence number
- *
- */
-void MIL_ADCIntEnable(void (*isr_ptr)(void),
-                      uint32_t base,
-                      uint8_t seq_num);
-
-/*
- * Desc: Runs get data sequence specified in the ADCSeqInit function
- *       This function can also be called in interrupts if need be
- *
- * Note:
- *      This includes a wait function that will wait for new data or
- *      the user specified timer is reached
- *
- *      You can also implment there to be no wait, in which case the function
- *      will exit immediately if there is no new data
- *
- * Sequence:
- *  Poll for interrupt flag using
- *  ADCIntStatus(ADCx_BASE, MIL_ADC_SEQx, false);
- *
- *  Clear the Interrupt flag with
- *  ADCIntClear(ADCx_BASE, MIL_ADC_SEQx);
- *
- * receive data into buffer with
- * ADCSequenceDataGet(ADC0_BASE,MIL_ADC_SEQx,array_pointer); where the array point points to an array of 32 bit values
- *
- * Parameters:
- *  base - from TivaWare, your ADCx_BASE(either 0 or 1 for or x)
- *  seq_num- from mil header, which MIL_ADC_SEQx( 0 to 3 for x)
- *  timeout- how many cycles you wish to wait for the ADC to provide data
- *  pbuffer - pointer to output buffer (MUST USE POINT TO UIN32_T OR IT'LL DIE)
- *
- * Returns:
- *  mil_adc_status_t - MIL_ADC_OK if there's new data
- *                     MIL_ADC_NOK if there's no new data
- */
-mil_adc_stat_t MIL_ADCGetData(uint32_t base,
-                              uint8_t seq_num,
-                              uint32_t timeout,
-                              uint32_t *pbuffer);
-
-/*
- * Desc: This function will convert a raw single ended ADC value to
- *       its double equivalent
- *
- * Note: this is based on the equation of a line
- *       in effect, the max adc value is 0xFFF which corresponds to
- *       your reference voltage.
- *
- *       implemented with equation
- *
- *       m = 3V/0xFFF
- *
- *       Voltage = m*(raw ADC)
- */
-float MIL_ADC_HextoFloat(uint16_t adc_value);
-
-/*
- * Desc: just incase you needed to convert the ADC values to ascii
- *       This function will take your 12 bit ADC value and output
- *       a string including its raw decimal and hex values
- *
- * Note: output string is 3 bytes long
- *
- * Note: I used this for debugging
- */
-void MIL_ADC_HEXtoASCII(uint16_t adc_value,char *pstring);
-
-/*
- * Desc: Converts a raw adc value into an ascii string
- *
- * Note: outstring is 4 bytes long
- *
- * Parameters:
- *  adc_value - from the ADC output
- *  pstring- pointer to outstring
- *
- */
-void MIL_ADC_FloattoASCII(uint16_t adc_value,char *pstring);
-
-#endif /* MIL_ADC_H_ */
+/*
+ * Name: MIL_ADC.h
+ * Author: Marquez Jones
+ * Last Modified: 3/6/2019
+ * Desc: Set of ADC wrapper functions to simplify ADC use
+ *
+ * Note VRef: This header defaults our reference voltage to the internal 3V source
+ *            this means a 0xFFF raw output from the ADC corresponds to 3V
+ *
+ *            this is also hardcoded to single ended mode meaning we're capped at 0V
+ *
+ *            This can be represented by the equation of a line with the ADC value being our x
+ *            and our output being y
+ *
+ *            so slope(m) = (3V - 0V)/(0xFFF - 0x000)
+ *
+ *            Voltage = m*(raw ADC)
+ *
+ * Note: In effect, the ADC module has a good amount of
+ *       modularity that  I reduced with these functions
+ *       to provide an easy to use set of functions
+ *
+ *       This should be sufficient for most ADC uses
+ *       in MIL.
+ *
+ *       In the case it isn't, you'll have to read both
+ *       the ADC sections from TivaWare and the Manual
+ *       in order to make a more custom solution
+ *
+ *FREE LEARNING:
+ *https://sites.google.com/site/luiselectronicprojects/tutorials/tiva-tutorials/tiva-adc/understanding-the-tiva-adc
+ */
+
+/*
+ * WHAT YOU NEED TO UNDERSTAND WITHOUT READING THE ADC SECTION:
+ * Refer to pages 800-801 of the TM4C123GH6PM manual
+ * for tables to descibe sequences
+ *
+ * the Tiva has two possible ADC modules(ADC0 and ADC1)
+ * Within these modules, you have multiple sequencers
+ * effectively, what the sequencer does, is tell your adc
+ * which channels it needs to check. So you can gather multiple
+ * ADC samples from multiple different analog inputs and have those
+ * results output to a buffer(some kind of array you declare)
+ *
+ * This is important to understand as it will change which sequencers you choose
+ * There's 4 sequencers per ADC enumerated 0 to 3
+ *
+ * 3 can be assigned only one imput channel
+ * 0 can be assigned 8 input channels
+ *
+ * Note if you were to write this code yourself, you check one pin
+ * multiple times within a sequence. In this header, I hardcoded it to
+ * assign unique channels to each sequence step
+ *
+ * MIL_ADCSeqInitRepeat is the exception, it puts one channel on several
+ * steps so they can be averaged(see OVERSAMPLING AND AVERAGING below)
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "utils/uartstdio.h"
+
+#ifndef MIL_ADC_H_
+#define MIL_ADC_H_
+
+/*
+ * Desc: bitmasks for all possible ADC pins
+ *       this will be used by other functions
+ *       in this header file
+ *
+ * TIVA ADC Notes:
+ * The TM4C123G has 12 possible ADC input pins
+ * The ports are verying
+ * Please refer to table 23-3 for enumeration of pins
+ *
+ * Define Notes: On the right of each define
+ *               I've indicated it's Pin name
+ *               and the port and pin it's assoicated
+ *               with. These are based on the TIVA
+ *               semantics
+ */
+#define MIL_ADC_PIN0_bm  0x01 << 0  //AIN0, PE3
+#define MIL_ADC_PIN1_bm  0x01 << 1  //AIN1, PE2
+#define MIL_ADC_PIN2_bm  0x01 << 2  //AIN2, PE1
+#define MIL_ADC_PIN3_bm  0x01 << 3  //AIN3, PE0
+#define MIL_ADC_PIN4_bm  0x01 << 4  //AIN4, PD3
+#define MIL_ADC_PIN5_bm  0x01 << 5  //AIN5, PD2
+#define MIL_ADC_PIN6_bm  0x01 << 6  //AIN6, PD1
+#define MIL_ADC_PIN7_bm  0x01 << 7  //AIN7, PD0
+#define MIL_ADC_PIN8_bm  0x01 << 8  //AIN8, PE5
+#define MIL_ADC_PIN9_bm  0x01 << 9  //AIN9, PE4
+#define MIL_ADC_PIN10_bm 0x01 << 10//AIN10, PB4
+#define MIL_ADC_PIN11_bm 0x01 << 11//AIN11, PB5
+
+//literally the same defines as above but these
+//are denoted by Port and Pin as well as channel
+#define MIL_ADC_CH0_PE3_bm  0x01 << 0  //AIN0, PE3
+#define MIL_ADC_CH1_PE2_bm  0x01 << 1  //AIN1, PE2
+#define MIL_ADC_CH2_PE1_bm  0x01 << 2  //AIN2, PE1
+#define MIL_ADC_CH3_PE0_bm  0x01 << 3  //AIN3, PE0
+#define MIL_ADC_CH4_PD3_bm  0x01 << 4  //AIN4, PD3
+#define MIL_ADC_CH5_PD2_bm  0x01 << 5  //AIN5, PD2
+#define MIL_ADC_CH6_PD1_bm  0x01 << 6  //AIN6, PD1
+#define MIL_ADC_CH7_PD0_bm  0x01 << 7  //AIN7, PD0
+#define MIL_ADC_CH8_PE5_bm  0x01 << 8  //AIN8, PE5
+#define MIL_ADC_CH9_PE4_bm  0x01 << 9  //AIN9, PE4
+#define MIL_ADC_CH10_PB4_bm 0x01 << 10//AIN10, PB4
+#define MIL_ADC_CH11_PB5_bm 0x01 << 11//AIN11, PB5
+
+//pins associated with Port E
+#define MIL_ADC_PORTE_gc  MIL_ADC_PIN0_bm | MIL_ADC_PIN1_bm | MIL_ADC_PIN2_bm | MIL_ADC_PIN3_bm | MIL_ADC_PIN8_bm | MIL_ADC_PIN9_bm
+#define MIL_ADC_PORTD_gc  MIL_ADC_PIN4_bm | MIL_ADC_PIN5_bm | MIL_ADC_PIN6_bm | MIL_ADC_PIN7_bm
+#define MIL_ADC_PORTB_gc  MIL_ADC_PIN10_bm | MIL_ADC_PIN11_bm
+
+/*
+ * Refer to pages 800-801 of the TM4C123GH6PM manual
+ * for tables to descibe sequences
+ *
+ * From an abstract perspect, each ADC module(ADC0 and ADC1)
+ * have 4 sequencers attached to them. The sequencers are
+ * what actually d
+ *
+ */
+
+//these defines are arbitrary as you can simply pass in the
+//the raw integer value,but these will increase readability
+#define MIL_ADC_SEQ0 0x00
+#define MIL_ADC_SEQ1 0x01
+#define MIL_ADC_SEQ2 0x02
+#define MIL_ADC_SEQ3 0x03
+
+/*
+ * For the purpose of abstraction
+ * I will limit our possible ADC
+ * trigger sources to 3 options
+ *
+ * NOTE: VIEW ASSOCIATED FUNCTION IN TIVAWARE MANUAL
+ * MIL_ADC_SoftTrig - trigger in software using ADCProcessorTrigger();
+ * MIL_ADC_TimTrig  - triggered by configuring timer with TimerControlTrigger();
+ * MIL_ADC_AlwaysTrig - ADC will always trigger
+ *
+ * These will be used by my ADC init function
+ */
+typedef enum{
+    MIL_ADC_SoftTrig,
+    MIL_ADC_TimTrig,
+    MIL_ADC_AlwaysTrig
+}mil_trig_t;
+
+//
+/*
+ * If there is a problem,
+ * return NOK(not OK)
+ *
+ * else return ADC_OK
+ */
+typedef enum{
+
+    MIL_ADC_OK,
+    MIL_ADC_NOK
+
+}mil_adc_stat_t;
+
+/*
+ * Desc: This function will configure the selected ADC channel
+ *       as enumerated by our MIL_ADC_PINx_bm defines. Each of
+ *       of those is associated with one the 12 ADC channels
+ *
+ * Note: This function effectively calls the
+ *       GPIOPinTypeADC() function for each ADC pin
+ *       function will also call the peripheral clock enables
+ *
+ * Parameters: This function takes in a bitfield
+ *             of each ADC pin desired bit wised ORed
+ *             together
+ *
+ * Para Note: So if you wanted pins 3 and 7, you'd pass in
+ *            uint16_t field = MIL_ADC_PIN3_bm | MIL_ADC_PIN7_bm
+ */
+void MIL_ADCPinConfig(uint16_t bitfield);
+
+/*
+ * Desc:This function enables individual sequences
+ *      You will need to call this for each sequence
+ *      you sequence you need to call this function
+ *
+ * Note: Each ADC has multiple sequences that control the
+ *       ADC
+ *
+ *       This also hardcodes for single ended mode. This
+ *       If you need differential, either consult the TivaWare
+ *       manual and modify this function,write your own function,
+ *       or contact someone who feels like modifying it for you
+ *
+ * Sequence Note: know that which sequence you select will limit how
+ *                how many channels/pins you can assign.
+ *
+ *                If you input more pins than are available to that sequence
+ *                the function will disregard those pins
+ *
+ *                Sequence 0 - 8 steps/channels
+ *                Sequence 1 - 4 steps/channels
+ *                Sequence 2 - 4 steps/channels
+ *                Sequence 3 - 1 step/channel
+ *
+ * Interrupts Note: This function will always configure the
+ *              ADC to set it's ISR flag without enabling the
+ *              interrupt.
+ *
+ *              If you want to use this without interrupts,
+ *              poll the ISR flag, and clear the interrupt using
+ *              IntClear
+ *
+ *              refer to page 32 section 4.2.2.18
+ *              for more information on using
+ *              the interrupts
+ *
+ *              You'll need to register an interrupt
+ *              function and call the enable functions
+ *
+ * Parameters:
+ * adc_base - from TIVA library either ADC0_BASE or ADC1_BASE
+ * Seq_num - which sequence you wish to enable(see Sequence defines in this header)
+ * pin_bitfield - what pins you're using(see pin defines in this header)
+ * trig - from mil_trig_t, this specifies what triggers your ADC
+ *
+ *
+ * USE NOTES TO GET DATA:
+ *  Poll for interrupt flag using
+ *  ADCIntStatus(ADCx_BASE, MIL_ADC_SEQx, false);
+ *
+ *  Clear the Interrupt flag with
+ *  ADCIntClear(ADCx_BASE, MIL_ADC_SEQx);
+ *
+ * receive data into buffer with
+ * ADCSequenceDataGet(ADC0_BASE,MIL_ADC_SEQx,array_pointer); where the array point points to an array of 32 bit values
+ *
+ * Arrays are points in C/C++
+ *
+ * Returns: mil_adc_stat_t
+ *          the only section of code that's able to return this is assigning
+ *          sequences(check source code)
+ *
+ *          It basically means you passed in a bad parameter that caused the function
+ *          not to exit relating to the bitfield
+ */
+mil_adc_stat_t MIL_ADCSeqInit(uint32_t base,
+                    uint8_t seq_num,
+                    uint16_t pin_bitfield,
+                    mil_trig_t trig);
+
+/*
+ * Desc: enable adc interrupts
+ *
+ * Note: will trigger upon a conversion finishing
+ *
+ * Parameters:
+ *  isr_ptr - pointer to your isr
+ *  base - ADC base
+ *  seq_num- your sequence number
+ *
+ */
+void MIL_ADCIntEnable(void (*isr_ptr)(void),
+                      uint32_t base,
+                      uint8_t seq_num);
+
+/*
+ * Desc: Runs get data sequence specified in the ADCSeqInit function
+ *       This function can also be called in interrupts if need be
+ *
+ * Note:
+ *      This includes a wait function that will wait for new data or
+ *      the user specified timer is reached
+ *
+ *      You can also implment there to be no wait, in which case the function
+ *      will exit immediately if there is no new data
+ *
+ * Sequence:
+ *  Poll for interrupt flag using
+ *  ADCIntStatus(ADCx_BASE, MIL_ADC_SEQx, false);
+ *
+ *  Clear the Interrupt flag with
+ *  ADCIntClear(ADCx_BASE, MIL_ADC_SEQx);
+ *
+ * receive data into buffer with
+ * ADCSequenceDataGet(ADC0_BASE,MIL_ADC_SEQx,array_pointer); where the array point points to an array of 32 bit values
+ *
+ * Parameters:
+ *  base - from TivaWare, your ADCx_BASE(either 0 or 1 for or x)
+ *  seq_num- from mil header, which MIL_ADC_SEQx( 0 to 3 for x)
+ *  timeout- how many cycles you wish to wait for the ADC to provide data
+ *  pbuffer - pointer to output buffer (MUST USE POINT TO UIN32_T OR IT'LL DIE)
+ *
+ * Returns:
+ *  mil_adc_status_t - MIL_ADC_OK if there's new data
+ *                     MIL_ADC_NOK if there's no new data
+ */
+mil_adc_stat_t MIL_ADCGetData(uint32_t base,
+                              uint8_t seq_num,
+                              uint32_t timeout,
+                              uint32_t *pbuffer);
+
+/*
+ * OVERSAMPLING AND AVERAGING:
+ * Averaging N samples of the same signal knocks random noise down by
+ * sqrt(N), so every 4x of averaging buys about 1 bit. There's two ways
+ * to get the Tiva to do it for you instead of adding samples up in code:
+ *
+ *  Hardware averaging(MIL_ADCOversampleSet) - the converter itself takes
+ *  2 to 64 samples for every step and puts their average in the FIFO.
+ *  It applies to EVERY sequence on that ADC module.
+ *
+ *  Repeated steps(MIL_ADCSeqInitRepeat) - one channel on several steps
+ *  of one sequence, MIL_ADCGetAveraged adds those up and hands back one
+ *  value.
+ *
+ * Both stack, total averaging = hardware factor * repeated steps
+ *
+ * Effective rate(converter at the 1 MSPS default, one sequence running):
+ *  rate = 1000000 / (hardware factor * repeated steps)
+ *
+ *  total   rate       noise vs 1 sample
+ *  1x      1 MSPS     1
+ *  4x      250 kSPS   1/2
+ *  16x     62.5 kSPS  1/4
+ *  64x     15.6 kSPS  1/8
+ *  512x    1.95 kSPS  1/22(64x hardware, 8 steps on SEQ0)
+ *
+ * Noise floor: out of the box the TM4C123 sits around 1-2 LSB of noise
+ *  (0.7mV-1.5mV on the 3V reference). Averaging only helps with noise
+ *  that's random, it won't fix a noisy reference or a slow settling
+ *  source, and the hardware average is still rounded to 12 bits so past
+ *  about 16x the 0.73mV step of one LSB is the floor. Past that you need
+ *  repeated steps too, MIL_ADCGetAveraged keeps the extra bits if you
+ *  ask for the sum.
+ *
+ * HOW TO USE:
+ *  uint16_t result;
+ *
+ *  MIL_ADCPinConfig(MIL_ADC_PIN4_bm);
+ *  MIL_ADCSeqInitRepeat(ADC0_BASE,MIL_ADC_SEQ0,MIL_ADC_PIN4_bm,8,MIL_ADC_SoftTrig);
+ *  MIL_ADCOversampleSet(ADC0_BASE,16); //after SeqInit, it resets the module
+ *
+ *  ADCProcessorTrigger(ADC0_BASE,MIL_ADC_SEQ0);
+ *  MIL_ADCGetAveraged(ADC0_BASE,MIL_ADC_SEQ0,10000,false,&result); //128x average
+ */
+
+/*
+ * Desc: sets hardware averaging for a whole ADC module
+ *
+ * Note: MIL_ADCSeqInit resets the module which clears this, so call
+ *       this after your sequences are set up
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  factor - 1(off),2,4,8,16,32 or 64 samples averaged per step
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad base or factor
+ */
+mil_adc_stat_t MIL_ADCOversampleSet(uint32_t base,uint8_t factor);
+
+/*
+ * Desc: sets up a sequence that samples one channel on several steps
+ *
+ * Note: unlike MIL_ADCSeqInit this won't reset the ADC module, so
+ *       other sequences and the hardware averaging are left alone
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ *  pin_bm - ONE of the MIL_ADC_PINx_bm defines
+ *  repeats - how many steps sample it, capped at the sequence's
+ *            size(8 for SEQ0, 4 for SEQ1/SEQ2, 1 for SEQ3)
+ *  trig - from mil_trig_t, what triggers the sequence
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad base, sequence or pin_bm
+ */
+mil_adc_stat_t MIL_ADCSeqInitRepeat(uint32_t base,
+                                    uint8_t seq_num,
+                                    uint16_t pin_bm,
+                                    uint8_t repeats,
+                                    mil_trig_t trig);
+
+/*
+ * Desc: waits for a repeated sequence like MIL_ADCGetData and
+ *       decimates every step into one result
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ *  timeout - how many cycles you wish to wait for the ADC to provide data
+ *  sum - false gives the rounded 12 bit average, true gives the sum of
+ *        every step(up to 8 * 0xFFF, the extra bits are real resolution
+ *        once the averaging is past the noise)
+ *  presult - where the result goes
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_OK if there's new data
+ *                   MIL_ADC_NOK if there's no new data
+ */
+mil_adc_stat_t MIL_ADCGetAveraged(uint32_t base,
+                                  uint8_t seq_num,
+                                  uint32_t timeout,
+                                  bool sum,
+                                  uint16_t *presult);
+
+/*
+ * FIXED RATE SAMPLING WITH A TIMER:
+ * Triggering with ADCProcessorTrigger from a loop or a timer ISR means
+ * every sample lands whenever the CPU gets to it, which smears the
+ * sample rate by however long the other interrupts take.
+ *
+ * MIL_ADC_TimTrig lets a general purpose timer start the sequence
+ * directly in hardware, so samples are exactly one timer period apart
+ * and the CPU isn't involved at all. MIL_ADCTimerTrigInit sets that
+ * timer up for you from a rate in Hz.
+ *
+ * The rate can't be faster than the converter can run the sequence:
+ *  rate * steps * hardware averaging <= MIL_ADC_CONV_RATE(1 MSPS)
+ * and it's rounded to a whole number of system clocks, the rate you
+ * really got is handed back.
+ *
+ * HOW TO USE:
+ *  uint32_t actual_hz;
+ *
+ *  MIL_ADCSeqInit(ADC0_BASE,MIL_ADC_SEQ1,MIL_ADC_PIN0_bm | MIL_ADC_PIN1_bm,MIL_ADC_TimTrig);
+ *  MIL_ADCTimerTrigInit(ADC0_BASE,MIL_ADC_SEQ1,TIMER2_BASE,10000,&actual_hz); //10 kHz
+ *
+ *  then read it with MIL_ADCGetData, an interrupt, or a stream
+ *
+ * Note: the ADC trigger is one signal for every timer, every
+ *       MIL_ADC_TimTrig sequence on both ADCs fires off whichever
+ *       timer has its trigger enabled, so use one timer for all of them
+ *
+ * Note: the timer is all yours to pick, just don't share it with
+ *       something else(MIL_CAN_RxCoalesceInit also wants one)
+ */
+
+//most conversions per second one ADC module does(ADCPC out of reset)
+#ifndef MIL_ADC_CONV_RATE
+#define MIL_ADC_CONV_RATE 1000000
+#endif
+
+/*
+ * Desc: runs a sequence at a fixed rate off a general purpose timer
+ *
+ * Note: the sequence is switched to MIL_ADC_TimTrig if it wasn't already
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx, already set up with MIL_ADCSeqInit or
+ *            MIL_ADCSeqInitRepeat
+ *  timer_base - TIMER0_BASE to TIMER5_BASE(timer A is used at full width)
+ *  rate_hz - how many times a second the sequence runs
+ *  pactual_hz - where the rate you really got goes, can be 0
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad base, sequence or timer, or
+ *                   a rate the ADC can't keep up with
+ */
+mil_adc_stat_t MIL_ADCTimerTrigInit(uint32_t base,
+                                    uint8_t seq_num,
+                                    uint32_t timer_base,
+                                    uint32_t rate_hz,
+                                    uint32_t *pactual_hz);
+
+/*
+ * Desc: stops the timer from triggering the ADC
+ *
+ * Parameters:
+ *  timer_base - the timer passed to MIL_ADCTimerTrigInit
+ */
+void MIL_ADCTimerTrigStop(uint32_t timer_base);
+
+/*
+ * STREAMING WITH THE uDMA:
+ * MIL_ADCGetData spins on the interrupt flag, so every sample costs CPU
+ * time and when you sample depends on when your loop gets around to it.
+ *
+ * Streaming hands the sequence over to the uDMA controller instead. Every
+ * time the sequence finishes its results get moved out of the sequencer
+ * FIFO straight into your buffers, no CPU involved. You give it two
+ * buffers(ping and pong): while the uDMA fills one, your callback gets
+ * the other one that just filled up. The ADC never waits on the CPU, so
+ * there's no gap between buffers as long as your callback finishes
+ * before the next buffer fills.
+ *
+ * Buffer timing:
+ *  time per buffer = num_samples / sample rate
+ *  e.g. MIL_ADC_AlwaysTrig at the full 1 MSPS with 512 sample buffers
+ *  calls you back every 512us, and your callback has 512us to finish
+ *
+ * Samples come out in step order, so with a 3 channel sequence a buffer
+ * is ch_a,ch_b,ch_c,ch_a,ch_b,ch_c... That's why num_samples has to be a
+ * multiple of the number of steps, every buffer starts on step 0.
+ *
+ * HOW TO USE:
+ *  uint32_t ping[512],pong[512];
+ *
+ *  void my_callback(uint32_t *pbuffer,uint16_t num_samples){...}
+ *
+ *  MIL_ADCPinConfig(MIL_ADC_PIN0_bm | MIL_ADC_PIN1_bm);
+ *  MIL_ADCSeqInit(ADC0_BASE,MIL_ADC_SEQ0,MIL_ADC_PIN0_bm | MIL_ADC_PIN1_bm,MIL_ADC_AlwaysTrig);
+ *  MIL_ADCStreamStart(ADC0_BASE,MIL_ADC_SEQ0,ping,pong,512,my_callback);
+ *
+ * Note: the callback runs in the ADC sequence interrupt, don't call
+ *       MIL_ADCIntEnable or MIL_ADCGetData on a streaming sequence
+ *
+ * Note: streaming owns the uDMA control table(MIL_ADC.c declares it).
+ *       If something else in your project already sets up the uDMA,
+ *       define MIL_ADC_DMA_EXTERNAL_TABLE and call uDMAEnable and
+ *       uDMAControlBaseSet yourself before starting a stream
+ *
+ * Note: the sample rate is set by the trigger(MIL_ADC_AlwaysTrig runs
+ *       the converter flat out at the ADCPC rate, 1 MSPS out of reset)
+ *       and is shared by every sequence on that ADC
+ */
+
+//the most samples the uDMA moves in one transfer
+#define MIL_ADC_STREAM_MAX_SAMPLES 1024
+
+/*
+ * Desc: called each time a stream buffer fills up
+ *
+ * Parameters:
+ *  pbuffer - the buffer that just filled(ping or pong)
+ *  num_samples - samples in it
+ */
+typedef void (*mil_adc_stream_cb_t)(uint32_t *pbuffer,uint16_t num_samples);
+
+/*
+ * Desc: starts continuous uDMA acquisition on a sequence that was set up
+ *       with MIL_ADCSeqInit
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ *  pping - first buffer, num_samples long
+ *  ppong - second buffer, num_samples long
+ *  num_samples - samples per buffer, a multiple of the sequence's steps
+ *                up to MIL_ADC_STREAM_MAX_SAMPLES
+ *  callback - called with each buffer as it fills
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad base, sequence or buffer size
+ */
+mil_adc_stat_t MIL_ADCStreamStart(uint32_t base,
+                                  uint8_t seq_num,
+                                  uint32_t *pping,
+                                  uint32_t *ppong,
+                                  uint16_t num_samples,
+                                  mil_adc_stream_cb_t callback);
+
+/*
+ * Desc: stops a stream, the buffer being filled is dropped
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ */
+void MIL_ADCStreamStop(uint32_t base,uint8_t seq_num);
+
+/*
+ * Desc: how many times both buffers filled before the callback
+ *       gave one back(each one is a gap in the samples)
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ */
+uint32_t MIL_ADCStreamOverruns(uint32_t base,uint8_t seq_num);
+
+/*
+ * CONVERTING TO MILLIVOLTS:
+ * MIL_ADC_HextoFloat does one float multiply per sample, which the
+ * M4F can do but it's still slower than integer math and a float
+ * isn't what you want to log or send over a bus anyway.
+ *
+ * These do the same line in fixed point:
+ *
+ *  mV = (raw * gain + offset) >> 16
+ *
+ * gain and offset are Q16(16 fraction bits), so the nominal gain of
+ * 3000mV/0xFFF = 0.7326 is stored as 48012. Every channel has its own
+ * gain and offset so you can trim out the error of each input's
+ * divider or the reference. Out of the box every channel is nominal.
+ *
+ * Calibrating: feed a known voltage near the bottom and near the top
+ * of the range, read the raw values, and pass both points to
+ * MIL_ADCCalTwoPoint. It works out the gain and offset for you.
+ *
+ * HOW TO USE:
+ *  uint32_t raw[4];
+ *  uint16_t mv[4];
+ *
+ *  MIL_ADCCalTwoPoint(4,124,100,3960,2900); //AIN4 read 124 at 100mV, 3960 at 2900mV
+ *
+ *  MIL_ADCGetData(ADC0_BASE,MIL_ADC_SEQ1,10000,raw);
+ *  MIL_ADCToMilliVolts(ADC0_BASE,MIL_ADC_SEQ1,raw,4,mv);
+ *
+ * The buffer is walked in step order, so a streamed buffer(many runs of
+ * the sequence back to back) converts in one call too.
+ */
+
+//reference in mV, a raw 0xFFF is this
+#ifndef MIL_ADC_VREF_MV
+#define MIL_ADC_VREF_MV 3000
+#endif
+
+//nominal Q16 gain, MIL_ADC_VREF_MV / 0xFFF rounded
+#define MIL_ADC_GAIN_Q16_NOMINAL (((MIL_ADC_VREF_MV * 65536) + 2047) / 4095)
+
+/*
+ * Desc: sets one channel's calibration directly
+ *
+ * Parameters:
+ *  channel - 0 to 11 for AIN0 to AIN11
+ *  gain_q16 - mV per count in Q16(MIL_ADC_GAIN_Q16_NOMINAL is ideal)
+ *  offset_q16 - mV added after the gain in Q16
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad channel or a gain that
+ *                   could overflow(over 4x nominal or negative)
+ */
+mil_adc_stat_t MIL_ADCCalSet(uint8_t channel,int32_t gain_q16,int32_t offset_q16);
+
+/*
+ * Desc: works out one channel's calibration from two known points
+ *
+ * Parameters:
+ *  channel - 0 to 11 for AIN0 to AIN11
+ *  raw_lo,mv_lo - raw reading at a known low voltage
+ *  raw_hi,mv_hi - raw reading at a known high voltage
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK on a bad channel or points that don't
+ *                   make a sensible line
+ */
+mil_adc_stat_t MIL_ADCCalTwoPoint(uint8_t channel,
+                                  uint16_t raw_lo,
+                                  uint16_t mv_lo,
+                                  uint16_t raw_hi,
+                                  uint16_t mv_hi);
+
+/*
+ * Desc: converts one raw value with a channel's calibration
+ *
+ * Parameters:
+ *  channel - 0 to 11 for AIN0 to AIN11
+ *  raw - 12 bit ADC value
+ *
+ * Returns:
+ *  millivolts, 0 if the calibration takes it negative
+ */
+uint16_t MIL_ADCRawToMilliVolts(uint8_t channel,uint16_t raw);
+
+/*
+ * Desc: converts a whole buffer from a sequence set up with
+ *       MIL_ADCSeqInit or MIL_ADCSeqInitRepeat, each sample gets
+ *       the calibration of the channel its step reads
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - MIL_ADC_SEQx
+ *  praw - samples as they came out of the sequence(or a stream buffer)
+ *  num_samples - how many
+ *  pmv - where the millivolts go, num_samples long(can't be praw)
+ *
+ * Returns:
+ *  mil_adc_stat_t - MIL_ADC_NOK if the sequence was never set up
+ */
+mil_adc_stat_t MIL_ADCToMilliVolts(uint32_t base,
+                                   uint8_t seq_num,
+                                   const uint32_t *praw,
+                                   uint16_t num_samples,
+                                   uint16_t *pmv);
+
+/*
+ * TELEMETRY LINES:
+ * MIL_ADC_HEXtoASCII and MIL_ADC_FloattoASCII do one value at a time
+ * and leave the commas and line endings to you. These turn a whole
+ * buffer into one line ready for UARTprintf("%s",...) or a UART FIFO:
+ *
+ *  MIL_ADCFormatMilliVolts - 0512,1024,2999\r\n(4 digits, mV)
+ *  MIL_ADCFormatHex        - 200,400,BB8\r\n(3 digits, raw)
+ *
+ * Every value is the same width so the line length only depends on how
+ * many values there are:
+ *  length = num_values * (width + 1) + 1(the \r\n replaces the last delim)
+ * and pbuf needs one more byte than that for the terminating 0.
+ *
+ * HOW TO USE:
+ *  char line[64];
+ *  uint16_t len;
+ *
+ *  MIL_ADCToMilliVolts(ADC0_BASE,MIL_ADC_SEQ1,raw,4,mv);
+ *  len = MIL_ADCFormatMilliVolts(mv,4,',',line,sizeof(line));
+ */
+
+/*
+ * Desc: formats millivolts as fixed width decimal, one line
+ *
+ * Note: values over 9999 are written as 9999
+ *
+ * Parameters:
+ *  pmv - values from MIL_ADCToMilliVolts
+ *  num_values - how many
+ *  delim - what goes between values(',' or ' ' or '\t')
+ *  pbuf - where the line is written, 0 terminated
+ *  buf_len - size of pbuf
+ *
+ * Returns:
+ *  length of the line without the 0, 0 if pbuf is too small
+ */
+uint16_t MIL_ADCFormatMilliVolts(const uint16_t *pmv,
+                                 uint16_t num_values,
+                                 char delim,
+                                 char *pbuf,
+                                 uint16_t buf_len);
+
+/*
+ * Desc: formats raw samples as 3 digit hex, one line
+ *
+ * Parameters:
+ *  praw - samples straight out of the sequence
+ *  num_values - how many
+ *  delim - what goes between values(',' or ' ' or '\t')
+ *  pbuf - where the line is written, 0 terminated
+ *  buf_len - size of pbuf
+ *
+ * Returns:
+ *  length of the line without the 0, 0 if pbuf is too small
+ */
+uint16_t MIL_ADCFormatHex(const uint32_t *praw,
+                          uint16_t num_values,
+                          char delim,
+                          char *pbuf,
+                          uint16_t buf_len);
+
+/*
+ * Desc: This function will convert a raw single ended ADC value to
+ *       its double equivalent
+ *
+ * Note: this is based on the equation of a line
+ *       in effect, the max adc value is 0xFFF which corresponds to
+ *       your reference voltage.
+ *
+ *       implemented with equation
+ *
+ *       m = 3V/0xFFF
+ *
+ *       Voltage = m*(raw ADC)
+ */
+float MIL_ADC_HextoFloat(uint16_t adc_value);
+
+/*
+ * Desc: just incase you needed to convert the ADC values to ascii
+ *       This function will take your 12 bit ADC value and output
+ *       a string including its raw decimal and hex values
+ *
+ * Note: output string is 3 bytes long
+ *
+ * Note: I used this for debugging
+ */
+void MIL_ADC_HEXtoASCII(uint16_t adc_value,char *pstring);
+
+/*
+ * Desc: Converts a raw adc value into an ascii string
+ *
+ * Note: outstring is 4 bytes long
+ *
+ * Parameters:
+ *  adc_value - from the ADC output
+ *  pstring- pointer to outstring
+ *
+ */
+void MIL_ADC_FloattoASCII(uint16_t adc_value,char *pstring);
+
+#endif /* MIL_ADC_H_ */
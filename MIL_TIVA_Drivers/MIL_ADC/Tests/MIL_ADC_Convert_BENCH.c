@@ -0,0 +1,126 @@
+/*
+ * Name: MIL_ADC millivolt conversion benchmark
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Times MIL_ADCToMilliVolts on a streamed buffer against doing the
+ *       same buffer a sample at a time with MIL_ADC_HextoFloat, as volts
+ *       and scaled to whole mV like the Q16 version gives you
+ *
+ * BENCH NOTES:
+ * The buffer is 1024 samples of a 4 step sequence(AIN0, AIN1, AIN2,
+ * AIN3) holding 1024 different codes. Before timing anything the Q16 mV
+ * has to be within 1mV of the float mV for every sample. The numbers
+ * are host ns per sample with a desktop FPU and don't carry over to the
+ * TM4C, where the float path also pays for the conversion to and from
+ * float on every sample; run it there with a timer for real numbers.
+ *
+ * HOW TO BUILD:
+ * from MIL_ADC/Tests, with TIVAWARE pointing at your TivaWare install
+ *
+ *      gcc -std=gnu99 -O2 -I$TIVAWARE -I.. MIL_ADC_Convert_BENCH.c
+ *          ../MIL_ADC.c MIL_ADC_HostStubs.c -o convert_bench
+ *
+ * then ./convert_bench, it returns non zero if the two ways disagree by
+ * more than 1mV anywhere
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "inc/hw_memmap.h"
+
+#include "MIL_ADC.h"
+
+/********DEFINES START******/
+#define BENCH_SAMPLES   1024
+#define BENCH_ROUNDS    20000   //times the buffer is converted per measurement
+/********DEFINES END******/
+
+static uint32_t bench_raw[BENCH_SAMPLES];
+static uint16_t bench_mv[BENCH_SAMPLES];
+static uint16_t bench_float_mv[BENCH_SAMPLES];
+static float bench_volts[BENCH_SAMPLES];
+
+static double BENCH_NowNs(void){
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+
+}
+
+/*
+ * Desc: the float way to whole mV, one sample at a time
+ */
+static void BENCH_FloatMilliVolts(const uint32_t *praw,uint16_t num_samples,uint16_t *pmv){
+
+    for(uint16_t i = 0;i < num_samples;i++){
+        pmv[i] = (uint16_t)(MIL_ADC_HextoFloat(praw[i] & 0x0FFF) * 1000.0f + 0.5f);
+    }
+
+}
+
+int main(void){
+
+    uint32_t mismatches = 0;
+    double start;
+    double q16_ns;
+    double volts_ns;
+    double float_mv_ns;
+
+    if(MIL_ADCSeqInit(ADC0_BASE,MIL_ADC_SEQ1,MIL_ADC_PORTE_gc,MIL_ADC_SoftTrig) != MIL_ADC_OK){
+        printf("sequence init failed\n");
+        return 1;
+    }
+
+    //1024 different codes, a multiple of 4 apart, spread over the range
+    for(uint32_t i = 0;i < BENCH_SAMPLES;i++){
+        bench_raw[i] = (i * 37 * 4) & 0x0FFF;
+    }
+
+    //both have to give the same answer first
+    MIL_ADCToMilliVolts(ADC0_BASE,MIL_ADC_SEQ1,bench_raw,BENCH_SAMPLES,bench_mv);
+    BENCH_FloatMilliVolts(bench_raw,BENCH_SAMPLES,bench_float_mv);
+    for(uint32_t i = 0;i < BENCH_SAMPLES;i++){
+
+        int32_t diff = (int32_t)bench_mv[i] - bench_float_mv[i];
+
+        if((diff > 1) || (diff < -1)){
+            mismatches++;
+        }
+
+    }
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        MIL_ADCToMilliVolts(ADC0_BASE,MIL_ADC_SEQ1,bench_raw,BENCH_SAMPLES,bench_mv);
+    }
+    q16_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_SAMPLES);
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        for(uint32_t i = 0;i < BENCH_SAMPLES;i++){
+            bench_volts[i] = MIL_ADC_HextoFloat(bench_raw[i]);
+        }
+    }
+    volts_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_SAMPLES);
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        BENCH_FloatMilliVolts(bench_raw,BENCH_SAMPLES,bench_float_mv);
+    }
+    float_mv_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_SAMPLES);
+
+    printf("MIL_ADCToMilliVolts(Q16 mV)       %6.2f ns/sample\n",q16_ns);
+    printf("MIL_ADC_HextoFloat(volts)         %6.2f ns/sample\n",volts_ns);
+    printf("MIL_ADC_HextoFloat scaled to mV   %6.2f ns/sample\n",float_mv_ns);
+    //keeps the compiler from dropping the loops
+    printf("last buffers %u %u %.4f\n",bench_mv[1],bench_float_mv[1],bench_volts[1]);
+    printf("mismatches over 1mV %u\n",mismatches);
+
+    return mismatches ? 1 : 0;
+
+}
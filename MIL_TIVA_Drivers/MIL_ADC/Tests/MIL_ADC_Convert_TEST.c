@@ -0,0 +1,206 @@
+/*
+ * Name: MIL_ADC millivolt conversion test
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Host test of the fixed point millivolt conversion, every 12 bit
+ *       code against the float line, the buffer version against the
+ *       single value one and two point calibration including the
+ *       points it has to turn down
+ *
+ * TEST NOTES:
+ * The nominal gain is 3000/0xFFF rounded to Q16, which is off by about
+ * 4ppm, so at 0xFFF that's 0.02mV on top of the 0.5mV of rounding to a
+ * whole mV. Every code has to land within 0.52mV of raw * 3000 / 4095.
+ * The two point case puts channel 5 on mV = 0.75 * raw - 20 and checks
+ * every code against that line to within 1mV.
+ *
+ * HOW TO BUILD:
+ * from MIL_ADC/Tests, with TIVAWARE pointing at your TivaWare install
+ *
+ *      gcc -std=gnu99 -I$TIVAWARE -I.. MIL_ADC_Convert_TEST.c
+ *          ../MIL_ADC.c MIL_ADC_HostStubs.c -o convert_test
+ *
+ * then ./convert_test, it prints every check and returns non zero if any failed
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "inc/hw_memmap.h"
+
+#include "MIL_ADC.h"
+
+/********DEFINES START******/
+#define TEST_NOMINAL_MAX_UV 520     //0.52mV
+#define TEST_CAL_MAX_UV     1000    //1mV
+#define TEST_CAL_CHANNEL    5
+/********DEFINES END******/
+
+static uint32_t test_failures;
+
+static void TEST_EQ(const char *pname,uint32_t got,uint32_t want){
+
+    printf("%-44s got %6u want %6u %s\n",pname,got,want,(got == want) ? "ok" : "FAIL");
+
+    if(got != want){
+        test_failures++;
+    }
+
+}
+
+static void TEST_LE(const char *pname,uint32_t got,uint32_t limit){
+
+    printf("%-44s got %6u max  %6u %s\n",pname,got,limit,(got <= limit) ? "ok" : "FAIL");
+
+    if(got > limit){
+        test_failures++;
+    }
+
+}
+
+/*
+ * Desc: distance between a converted value and the ideal line in uV
+ */
+static uint32_t TEST_ErrUv(uint16_t mv,double want_mv){
+
+    double err = (double)mv - want_mv;
+
+    if(err < 0){
+        err = -err;
+    }
+
+    return (uint32_t)(err * 1000.0 + 0.5);
+
+}
+
+int main(void){
+
+    static uint32_t raw[4096];
+    static uint16_t mv[4096];
+    uint32_t worst_uv;
+    uint32_t worst_float_uv;
+    uint32_t buffer_mismatches;
+    uint32_t clamp_mismatches;
+
+    /*********************NOMINAL*******************/
+
+    //every channel starts out nominal
+    worst_uv = 0;
+    for(uint8_t channel = 0;channel < 12;channel++){
+        for(uint32_t r = 0;r < 4096;r++){
+
+            uint32_t err_uv = TEST_ErrUv(MIL_ADCRawToMilliVolts(channel,r),r * 3000.0 / 4095.0);
+
+            if(err_uv > worst_uv){
+                worst_uv = err_uv;
+            }
+
+        }
+    }
+    TEST_LE("nominal worst error over every code(uV)",worst_uv,TEST_NOMINAL_MAX_UV);
+    TEST_EQ("nominal 0x000",MIL_ADCRawToMilliVolts(0,0x000),0);
+    TEST_EQ("nominal 0xFFF",MIL_ADCRawToMilliVolts(0,0xFFF),MIL_ADC_VREF_MV);
+    TEST_EQ("bad channel",MIL_ADCRawToMilliVolts(12,0x800),0);
+
+    //the float version is the reference for the old code
+    worst_float_uv = 0;
+    for(uint32_t r = 0;r < 4096;r++){
+
+        double err = (double)MIL_ADC_HextoFloat(r) * 1000.0 - r * 3000.0 / 4095.0;
+
+        err = (err < 0) ? -err : err;
+        if((uint32_t)(err * 1000.0 + 0.5) > worst_float_uv){
+            worst_float_uv = (uint32_t)(err * 1000.0 + 0.5);
+        }
+
+    }
+    TEST_LE("float worst error over every code(uV)",worst_float_uv,10);
+
+    /*********************BUFFER********************/
+
+    //AIN0, AIN5, AIN7, AIN9 on sequence 1, then every code through it
+    TEST_EQ("sequence init",MIL_ADCSeqInit(ADC0_BASE,MIL_ADC_SEQ1,
+            MIL_ADC_PIN0_bm | MIL_ADC_PIN5_bm | MIL_ADC_PIN7_bm | MIL_ADC_PIN9_bm,
+            MIL_ADC_SoftTrig),MIL_ADC_OK);
+    TEST_EQ("calibrate AIN5 for the buffer",MIL_ADCCalTwoPoint(TEST_CAL_CHANNEL,200,130,3800,2830),MIL_ADC_OK);
+
+    for(uint32_t r = 0;r < 4096;r++){
+        raw[r] = r | 0xF000;    //junk above bit 11 has to be ignored
+    }
+
+    //4095 isn't a whole number of runs, the last run is cut short
+    TEST_EQ("buffer convert",MIL_ADCToMilliVolts(ADC0_BASE,MIL_ADC_SEQ1,raw,4095,mv),MIL_ADC_OK);
+
+    buffer_mismatches = 0;
+    for(uint32_t i = 0;i < 4095;i++){
+
+        static const uint8_t step_channel[4] = {0,5,7,9};
+
+        if(mv[i] != MIL_ADCRawToMilliVolts(step_channel[i % 4],i)){
+            buffer_mismatches++;
+        }
+
+    }
+    TEST_EQ("buffer vs single value mismatches",buffer_mismatches,0);
+    TEST_EQ("sequence never set up",MIL_ADCToMilliVolts(ADC1_BASE,MIL_ADC_SEQ2,raw,4,mv),MIL_ADC_NOK);
+    TEST_EQ("bad base",MIL_ADCToMilliVolts(0,MIL_ADC_SEQ1,raw,4,mv),MIL_ADC_NOK);
+
+    /*********************TWO POINT*****************/
+
+    //read 200 at 130mV and 3800 at 2830mV, mV = 0.75 * raw - 20
+    TEST_EQ("two point",MIL_ADCCalTwoPoint(TEST_CAL_CHANNEL,200,130,3800,2830),MIL_ADC_OK);
+    TEST_EQ("two point low point",MIL_ADCRawToMilliVolts(TEST_CAL_CHANNEL,200),130);
+    TEST_EQ("two point high point",MIL_ADCRawToMilliVolts(TEST_CAL_CHANNEL,3800),2830);
+
+    //below raw 27 the line is negative and has to clamp to 0
+    worst_uv = 0;
+    clamp_mismatches = 0;
+    for(uint32_t r = 0;r < 4096;r++){
+
+        double want_mv = 0.75 * r - 20.0;
+        uint16_t got_mv = MIL_ADCRawToMilliVolts(TEST_CAL_CHANNEL,r);
+
+        if(want_mv < 0){
+            if(got_mv != 0){
+                clamp_mismatches++;
+            }
+            continue;
+        }
+
+        if(TEST_ErrUv(got_mv,want_mv) > worst_uv){
+            worst_uv = TEST_ErrUv(got_mv,want_mv);
+        }
+
+    }
+    TEST_LE("two point worst error over every code(uV)",worst_uv,TEST_CAL_MAX_UV);
+    TEST_EQ("two point clamps below 0mV",clamp_mismatches,0);
+
+    //the other channels didn't move
+    TEST_EQ("AIN4 still nominal",MIL_ADCRawToMilliVolts(4,0xFFF),MIL_ADC_VREF_MV);
+    TEST_EQ("AIN6 still nominal",MIL_ADCRawToMilliVolts(6,0xFFF),MIL_ADC_VREF_MV);
+
+    /*********************REJECTED******************/
+
+    TEST_EQ("reject raw_hi == raw_lo",MIL_ADCCalTwoPoint(TEST_CAL_CHANNEL,1000,100,1000,2000),MIL_ADC_NOK);
+    TEST_EQ("reject raw_hi < raw_lo",MIL_ADCCalTwoPoint(TEST_CAL_CHANNEL,3000,100,1000,2000),MIL_ADC_NOK);
+    TEST_EQ("reject mv_hi == mv_lo",MIL_ADCCalTwoPoint(TEST_CAL_CHANNEL,100,500,3000,500),MIL_ADC_NOK);
+    TEST_EQ("reject mv_hi < mv_lo",MIL_ADCCalTwoPoint(TEST_CAL_CHANNEL,100,2000,3000,500),MIL_ADC_NOK);
+    TEST_EQ("reject gain over 4x nominal",MIL_ADCCalTwoPoint(TEST_CAL_CHANNEL,100,0,200,2000),MIL_ADC_NOK);
+    TEST_EQ("reject offset below -VREF",MIL_ADCCalTwoPoint(TEST_CAL_CHANNEL,3000,0,4000,2000),MIL_ADC_NOK);
+    TEST_EQ("reject bad channel",MIL_ADCCalTwoPoint(12,200,130,3800,2830),MIL_ADC_NOK);
+    TEST_EQ("reject negative gain",MIL_ADCCalSet(TEST_CAL_CHANNEL,-1,0),MIL_ADC_NOK);
+
+    //a rejected calibration leaves the old one in place
+    TEST_EQ("after rejects low point",MIL_ADCRawToMilliVolts(TEST_CAL_CHANNEL,200),130);
+    TEST_EQ("after rejects high point",MIL_ADCRawToMilliVolts(TEST_CAL_CHANNEL,3800),2830);
+
+    //and nominal can be put back
+    TEST_EQ("back to nominal",MIL_ADCCalSet(TEST_CAL_CHANNEL,MIL_ADC_GAIN_Q16_NOMINAL,0),MIL_ADC_OK);
+    TEST_EQ("back to nominal 0xFFF",MIL_ADCRawToMilliVolts(TEST_CAL_CHANNEL,0xFFF),MIL_ADC_VREF_MV);
+
+    printf("%s, %u failed\n",test_failures ? "FAIL" : "PASS",test_failures);
+
+    return test_failures ? 1 : 0;
+
+}
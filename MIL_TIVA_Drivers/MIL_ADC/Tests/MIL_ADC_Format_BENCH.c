@@ -0,0 +1,263 @@
+/*
+ * Name: MIL_ADC telemetry line benchmark
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Checks MIL_ADCFormatMilliVolts and MIL_ADCFormatHex against
+ *       sprintf, then times a 1024 value line against building the same
+ *       line a value at a time with MIL_ADC_FloattoASCII and
+ *       MIL_ADC_HEXtoASCII, and with sprintf
+ *
+ * BENCH NOTES:
+ * Every mV value 0 to 9999 has to come out exactly like sprintf "%04u"
+ * and every raw code 0 to 0xFFF like "%03X"(and like MIL_ADC_HEXtoASCII),
+ * then whole lines have to match a line built with sprintf. Values over
+ * 9999 have to come out as 9999.
+ *
+ * MIL_ADC_FloattoASCII writes volts("2.99") rather than mV, so it isn't
+ * the same text, but it's what the old code used for a line of readings
+ * and does the same job, 4 characters per value. The old loops add the
+ * delimiter and line ending themselves like application code had to.
+ * The numbers are host ns per value and don't carry over to the TM4C,
+ * where FloattoASCII's double math is done in software and is slower
+ * still.
+ *
+ * HOW TO BUILD:
+ * from MIL_ADC/Tests, with TIVAWARE pointing at your TivaWare install
+ *
+ *      gcc -std=gnu99 -O2 -I$TIVAWARE -I.. MIL_ADC_Format_BENCH.c
+ *          ../MIL_ADC.c MIL_ADC_HostStubs.c -o format_bench
+ *
+ * then ./format_bench, it returns non zero if any line differs from sprintf
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "MIL_ADC.h"
+
+/********DEFINES START******/
+#define BENCH_VALUES    1024
+#define BENCH_ROUNDS    5000    //times the line is built per measurement
+
+//4 digits or 3 hex digits and a delimiter per value, then \r\n and 0
+#define BENCH_LINE_LEN  (BENCH_VALUES * 5 + 2)
+/********DEFINES END******/
+
+static uint16_t bench_mv[BENCH_VALUES];
+static uint32_t bench_raw[BENCH_VALUES];
+static char bench_line[BENCH_LINE_LEN];
+static char bench_want[BENCH_LINE_LEN];
+static uint32_t bench_mismatches;
+
+static double BENCH_NowNs(void){
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+
+}
+
+static void BENCH_Match(const char *pname,uint32_t value,const char *pgot,const char *pwant){
+
+    if(strcmp(pgot,pwant)){
+        printf("%s %u: got \"%s\" want \"%s\"\n",pname,value,pgot,pwant);
+        bench_mismatches++;
+    }
+
+}
+
+/*
+ * Desc: the old mV line, one MIL_ADC_FloattoASCII per value
+ */
+static void BENCH_OldMilliVolts(const uint32_t *praw,uint16_t num_values,char *pbuf){
+
+    char *p = pbuf;
+
+    for(uint16_t i = 0;i < num_values;i++){
+        MIL_ADC_FloattoASCII(praw[i],p);
+        p[4] = ',';
+        p += 5;
+    }
+
+    p[-1] = '\r';
+    p[0] = '\n';
+    p[1] = 0;
+
+}
+
+/*
+ * Desc: the old hex line, one MIL_ADC_HEXtoASCII per value
+ */
+static void BENCH_OldHex(const uint32_t *praw,uint16_t num_values,char *pbuf){
+
+    char *p = pbuf;
+
+    for(uint16_t i = 0;i < num_values;i++){
+        MIL_ADC_HEXtoASCII(praw[i],p);
+        p[3] = ',';
+        p += 4;
+    }
+
+    p[-1] = '\r';
+    p[0] = '\n';
+    p[1] = 0;
+
+}
+
+/*
+ * Desc: the same lines with sprintf
+ */
+static void BENCH_SprintfMilliVolts(const uint16_t *pmv,uint16_t num_values,char *pbuf){
+
+    char *p = pbuf;
+
+    for(uint16_t i = 0;i < num_values;i++){
+        p += sprintf(p,"%04u,",pmv[i]);
+    }
+
+    strcpy(p - 1,"\r\n");
+
+}
+
+static void BENCH_SprintfHex(const uint32_t *praw,uint16_t num_values,char *pbuf){
+
+    char *p = pbuf;
+
+    for(uint16_t i = 0;i < num_values;i++){
+        p += sprintf(p,"%03X,",praw[i]);
+    }
+
+    strcpy(p - 1,"\r\n");
+
+}
+
+int main(void){
+
+    char line[8];
+    char want[8];
+    uint16_t len;
+    double start;
+    double batch_ns;
+    double old_ns;
+    double sprintf_ns;
+
+    /*********************EQUIVALENCE***************/
+
+    for(uint32_t v = 0;v <= 9999;v++){
+
+        uint16_t mv = v;
+
+        MIL_ADCFormatMilliVolts(&mv,1,',',line,sizeof(line));
+        sprintf(want,"%04u\r\n",v);
+        BENCH_Match("mV",v,line,want);
+
+    }
+
+    //over range clamps
+    for(uint32_t v = 10000;v <= 0xFFFF;v += 5553){
+
+        uint16_t mv = v;
+
+        MIL_ADCFormatMilliVolts(&mv,1,',',line,sizeof(line));
+        BENCH_Match("mV clamp",v,line,"9999\r\n");
+
+    }
+
+    for(uint32_t raw = 0;raw <= 0xFFF;raw++){
+
+        MIL_ADCFormatHex(&raw,1,',',line,sizeof(line));
+        sprintf(want,"%03X\r\n",raw);
+        BENCH_Match("hex",raw,line,want);
+
+        MIL_ADC_HEXtoASCII(raw,want);
+        want[3] = 0;
+        line[3] = 0;
+        BENCH_Match("hex vs MIL_ADC_HEXtoASCII",raw,line,want);
+
+    }
+
+    //whole lines, and the length has to be right to the byte
+    for(uint32_t i = 0;i < BENCH_VALUES;i++){
+        bench_raw[i] = (i * 37 * 4) & 0x0FFF;
+        bench_mv[i] = MIL_ADCRawToMilliVolts(0,bench_raw[i]);
+    }
+
+    len = MIL_ADCFormatMilliVolts(bench_mv,BENCH_VALUES,',',bench_line,sizeof(bench_line));
+    BENCH_SprintfMilliVolts(bench_mv,BENCH_VALUES,bench_want);
+    BENCH_Match("mV line",BENCH_VALUES,bench_line,bench_want);
+    if(len != strlen(bench_want)){
+        printf("mV line length %u want %u\n",len,(uint32_t)strlen(bench_want));
+        bench_mismatches++;
+    }
+
+    len = MIL_ADCFormatHex(bench_raw,BENCH_VALUES,',',bench_line,sizeof(bench_line));
+    BENCH_SprintfHex(bench_raw,BENCH_VALUES,bench_want);
+    BENCH_Match("hex line",BENCH_VALUES,bench_line,bench_want);
+    if(len != strlen(bench_want)){
+        printf("hex line length %u want %u\n",len,(uint32_t)strlen(bench_want));
+        bench_mismatches++;
+    }
+
+    //needs the line plus the 0, one less has to be refused
+    if(!MIL_ADCFormatMilliVolts(bench_mv,3,',',bench_line,3 * 5 + 2) ||
+       MIL_ADCFormatMilliVolts(bench_mv,3,',',bench_line,3 * 5 + 1) ||
+       !MIL_ADCFormatHex(bench_raw,3,',',bench_line,3 * 4 + 2) ||
+       MIL_ADCFormatHex(bench_raw,3,',',bench_line,3 * 4 + 1)){
+        printf("buffer size check\n");
+        bench_mismatches++;
+    }
+
+    printf("mismatches against sprintf %u\n\n",bench_mismatches);
+
+    /*********************THROUGHPUT****************/
+
+    printf("%u values per line     batch ns/value   old ns/value   sprintf ns/value\n",BENCH_VALUES);
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        MIL_ADCFormatMilliVolts(bench_mv,BENCH_VALUES,',',bench_line,sizeof(bench_line));
+    }
+    batch_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_VALUES);
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        BENCH_OldMilliVolts(bench_raw,BENCH_VALUES,bench_line);
+    }
+    old_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_VALUES);
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        BENCH_SprintfMilliVolts(bench_mv,BENCH_VALUES,bench_want);
+    }
+    sprintf_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_VALUES);
+
+    printf("mV(vs FloattoASCII)    %14.2f   %12.2f   %16.2f\n",batch_ns,old_ns,sprintf_ns);
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        MIL_ADCFormatHex(bench_raw,BENCH_VALUES,',',bench_line,sizeof(bench_line));
+    }
+    batch_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_VALUES);
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        BENCH_OldHex(bench_raw,BENCH_VALUES,bench_line);
+    }
+    old_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_VALUES);
+
+    start = BENCH_NowNs();
+    for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+        BENCH_SprintfHex(bench_raw,BENCH_VALUES,bench_want);
+    }
+    sprintf_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_VALUES);
+
+    printf("hex(vs HEXtoASCII)     %14.2f   %12.2f   %16.2f\n",batch_ns,old_ns,sprintf_ns);
+
+    return bench_mismatches ? 1 : 0;
+
+}
@@ -0,0 +1,99 @@
+/*
+ * Name: MIL_ADC host stubs
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Empty stand ins for the driverlib calls MIL_ADC.c makes so it
+ *       links on a PC, for the host tests and benchmarks in this folder
+ *
+ * Note: nothing here touches hardware or pretends to convert, so only
+ *       the parts of MIL_ADC that are plain math can be tested with it
+ *       (calibration, MIL_ADCToMilliVolts, the formatters). Sequences
+ *       can still be set up with MIL_ADCSeqInit, which is how the
+ *       buffer conversions learn which channel each step reads.
+ *       SysCtlPeripheralReady always says ready and ADCIntStatus and
+ *       ADCSequenceDataGet always say nothing happened.
+ *
+ * HOW TO USE:
+ * build it next to MIL_ADC.c against the TivaWare headers instead of
+ * linking driverlib, see the HOW TO BUILD of each test
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
+
+/**************************ADC****/
+
+void ADCHardwareOversampleConfigure(uint32_t ui32Base,uint32_t ui32Factor){}
+void ADCIntClear(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCIntDisable(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCIntEnable(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCIntRegister(uint32_t ui32Base,uint32_t ui32SequenceNum,void (*pfnHandler)(void)){}
+void ADCIntUnregister(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCSequenceConfigure(uint32_t ui32Base,uint32_t ui32SequenceNum,uint32_t ui32Trigger,uint32_t ui32Priority){}
+void ADCSequenceDMADisable(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCSequenceDMAEnable(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCSequenceDisable(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCSequenceEnable(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCSequenceOverflowClear(uint32_t ui32Base,uint32_t ui32SequenceNum){}
+void ADCSequenceStepConfigure(uint32_t ui32Base,uint32_t ui32SequenceNum,uint32_t ui32Step,uint32_t ui32Config){}
+
+uint32_t ADCIntStatus(uint32_t ui32Base,uint32_t ui32SequenceNum,bool bMasked){
+
+    return 0;
+
+}
+
+int32_t ADCSequenceDataGet(uint32_t ui32Base,uint32_t ui32SequenceNum,uint32_t *pui32Buffer){
+
+    return 0;
+
+}
+
+/**************************GPIO AND SYSCTL****/
+
+void GPIOPinTypeADC(uint32_t ui32Port,uint8_t ui8Pins){}
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral){}
+void SysCtlPeripheralReset(uint32_t ui32Peripheral){}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral){
+
+    return true;
+
+}
+
+uint32_t SysCtlClockGet(void){
+
+    return 80000000;
+
+}
+
+/**************************TIMER****/
+
+void TimerConfigure(uint32_t ui32Base,uint32_t ui32Config){}
+void TimerControlTrigger(uint32_t ui32Base,uint32_t ui32Timer,bool bEnable){}
+void TimerDisable(uint32_t ui32Base,uint32_t ui32Timer){}
+void TimerEnable(uint32_t ui32Base,uint32_t ui32Timer){}
+void TimerLoadSet(uint32_t ui32Base,uint32_t ui32Timer,uint32_t ui32Value){}
+
+/**************************UDMA****/
+
+void uDMAChannelAssign(uint32_t ui32Mapping){}
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum,uint32_t ui32Attr){}
+void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex,uint32_t ui32Control){}
+void uDMAChannelDisable(uint32_t ui32ChannelNum){}
+void uDMAChannelEnable(uint32_t ui32ChannelNum){}
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex,uint32_t ui32Mode,void *pvSrcAddr,void *pvDstAddr,uint32_t ui32TransferSize){}
+void uDMAControlBaseSet(void *pControlTable){}
+void uDMAEnable(void){}
+
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex){
+
+    return UDMA_MODE_STOP;
+
+}
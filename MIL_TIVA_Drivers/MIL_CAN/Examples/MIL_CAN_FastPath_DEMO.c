@@ -0,0 +1,176 @@
+/*
+ * Name: MIL_CAN fast path example
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Cycle count comparison of MIL_CAN_FastWrite/MIL_CAN_FastRead
+ *       against CANMessageSet/MIL_CAN_GetMail
+ *
+ * HARDWARE NOTES:
+ * none, CAN1 runs in loopback test mode so it hears its own frames
+ * and no transceiver or second board is needed
+ *
+ * DEMO NOTES:
+ * Run it under the debugger, let it go for a second, pause and look at
+ * fast_results. Every number is the average cycles for one call over
+ * DEMO_ROUNDS rounds measured with the Cortex-M4 cycle counter(DWT),
+ * the cost of reading the counter itself is already taken out.
+ * mismatches should be 0, it counts frames that came back different
+ * from what was sent.
+ *
+ * Build with the same optimization level you use for real code, the
+ * driverlib calls come out of ROM/flash either way but the fast path
+ * gets inlined differently at -O0.
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_can.h"
+#include "driverlib/can.h"
+#include "driverlib/sysctl.h"
+
+#include "MIL_CLK.h"
+#include "MIL_CAN.h"
+#include "MIL_CAN_Fast.h"
+
+/********DEFINES START******/
+#define DEMO_CANID      0x38
+#define DEMO_TX_OBJ     1
+#define DEMO_RX_OBJ     2
+#define DEMO_MSG_LEN    8
+#define DEMO_ROUNDS     1000
+
+//Cortex-M4 debug registers for the cycle counter
+#define DEMO_DEMCR      0xE000EDFC
+#define DEMO_DEMCR_TRCENA 0x01000000
+#define DEMO_DWT_CTRL   0xE0001000
+#define DEMO_DWT_CYCCNT 0xE0001004
+/********DEFINES END********/
+
+typedef struct{
+
+    uint32_t driverlib_write;   //CANMessageSet
+    uint32_t fast_write;        //MIL_CAN_FastWrite
+    uint32_t driverlib_read;    //MIL_CAN_GetMail(CANStatusGet + CANMessageGet)
+    uint32_t fast_read;         //MIL_CAN_FastRead
+    uint32_t mismatches;
+
+}demo_results_t;
+
+//watch this in the debugger
+volatile demo_results_t fast_results;
+
+static uint32_t demo_overhead;
+
+static inline uint32_t demo_cycles(void){
+    return HWREG(DEMO_DWT_CYCCNT);
+}
+
+//waits until the looped back frame lands in the receive object
+static void demo_wait_rx(void){
+    while(!(CANStatusGet(CAN1_BASE,CAN_STS_NEWDAT) & (0x01UL << (DEMO_RX_OBJ - 1)))){}
+}
+
+static void demo_check(const uint8_t *ptx,const uint8_t *prx){
+
+    for(uint8_t i = 0;i < DEMO_MSG_LEN;i++){
+        if(ptx[i] != prx[i]){
+            fast_results.mismatches++;
+            return;
+        }
+    }
+
+}
+
+/*********************************************MAIN*************************************************/
+
+int main(void){
+
+    uint8_t tx_data[DEMO_MSG_LEN];
+    uint8_t rx_data[DEMO_MSG_LEN];
+    uint64_t totals[4] = {0,0,0,0};
+    uint32_t start;
+    tCANMsgObject tx_obj;
+    MIL_CAN_MailBox_t rx_box;
+
+    MIL_ClkSetInt_16MHz();
+
+    //start the cycle counter
+    HWREG(DEMO_DEMCR) |= DEMO_DEMCR_TRCENA;
+    HWREG(DEMO_DWT_CYCCNT) = 0;
+    HWREG(DEMO_DWT_CTRL) |= 0x01;
+
+    //cost of two back to back counter reads
+    start = demo_cycles();
+    demo_overhead = demo_cycles() - start;
+
+    MIL_InitCAN(MIL_CAN_PORT_A,CAN1_BASE,500000);
+
+    //loopback, the controller acks and receives its own frames
+    HWREG(CAN1_BASE + CAN_O_CTL) |= CAN_CTL_TEST;
+    HWREG(CAN1_BASE + CAN_O_TST) |= CAN_TST_LBACK;
+
+    rx_box.canid = DEMO_CANID;
+    rx_box.filt_mask = 0x7FF;
+    rx_box.base = CAN1_BASE;
+    rx_box.msg_len = DEMO_MSG_LEN;
+    rx_box.obj_num = DEMO_RX_OBJ;
+    rx_box.rx_flag_int = 0;
+    rx_box.buffer = rx_data;
+    MIL_InitMailBox(&rx_box);
+
+    tx_obj.ui32MsgID = DEMO_CANID;
+    tx_obj.ui32MsgIDMask = 0;
+    tx_obj.ui32Flags = 0;
+    tx_obj.ui32MsgLen = DEMO_MSG_LEN;
+    tx_obj.pui8MsgData = tx_data;
+
+    for(uint32_t round = 0;round < DEMO_ROUNDS;round++){
+
+        for(uint8_t i = 0;i < DEMO_MSG_LEN;i++){
+            tx_data[i] = (uint8_t)(round + i);
+        }
+
+        /*************DRIVERLIB*************/
+        start = demo_cycles();
+        CANMessageSet(CAN1_BASE,DEMO_TX_OBJ,&tx_obj,MSG_OBJ_TYPE_TX);
+        totals[0] += demo_cycles() - start - demo_overhead;
+
+        demo_wait_rx();
+
+        start = demo_cycles();
+        MIL_CAN_GetMail(&rx_box);
+        totals[2] += demo_cycles() - start - demo_overhead;
+
+        demo_check(tx_data,rx_data);
+
+        /*************FAST PATH*************/
+        tx_data[0] ^= 0xFF;
+
+        //the CANMessageSet above rewrote the object, put the fixed setup back
+        MIL_CAN_FastTxInit(CAN1_BASE,DEMO_TX_OBJ,DEMO_CANID,DEMO_MSG_LEN);
+
+        start = demo_cycles();
+        MIL_CAN_FastWrite(CAN1_BASE,DEMO_TX_OBJ,tx_data,DEMO_MSG_LEN);
+        totals[1] += demo_cycles() - start - demo_overhead;
+
+        demo_wait_rx();
+
+        start = demo_cycles();
+        MIL_CAN_FastRead(CAN1_BASE,DEMO_RX_OBJ,rx_data,0);
+        totals[3] += demo_cycles() - start - demo_overhead;
+
+        demo_check(tx_data,rx_data);
+
+    }
+
+    fast_results.driverlib_write = (uint32_t)(totals[0] / DEMO_ROUNDS);
+    fast_results.fast_write = (uint32_t)(totals[1] / DEMO_ROUNDS);
+    fast_results.driverlib_read = (uint32_t)(totals[2] / DEMO_ROUNDS);
+    fast_results.fast_read = (uint32_t)(totals[3] / DEMO_ROUNDS);
+
+    while(1){}
+
+}
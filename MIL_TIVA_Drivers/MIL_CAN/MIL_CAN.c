@@ -1,307 +1,2436 @@
-/*
- * Name: MIL_CAN.c
- * Author: Marquez Jones0
- * Date Modified: 11/2/2019
- * Desc: A set of wrapper functions I designed
- *       to standardized CAN use in the Lab
- *       this primarily is to reduce the number
- *       of bugs caused by the CAN bus
- *
- * Notes: CAN devices should be run at 200k bps
- *        and PCBs on the network should have on
- *        board termination resistors
- * BAUD UPDATE: CAN INIT NOW HAS CONFIGURABLE BAUD RATE
- */
-
-/* INCLUDES */
-//includes
-#include <stdbool.h>
-#include <stdint.h>
-#include "inc/hw_can.h"
-#include "inc/hw_ints.h"
-#include "inc/hw_memmap.h"
-#include "inc/hw_types.h"
-#include "driverlib/can.h"
-#include "driverlib/gpio.h"
-#include "driverlib/interrupt.h"
-#include "driverlib/pin_map.h"
-#include "driverlib/sysctl.h"
-
-//MIL includes
-#include"MIL_CAN.h"
-
-/*
- * Desc: enables CAN which can be enabled on
- *       Ports B,E, or F for CAN0 
- * 		 or Port A for CAN1
- *
- * Notes: Does not enable interrupts
- *        or port clocks
- *        PORT and Interrupts
- *        must be enabled outside funciton
- *	
- *		  IF YOU SET CAN1_BASE AS YOUR BASE
- *   	  FUNCTION WILL DEFAULT TO CONFIGURING PORT A
- *
- * Hardware Notes:
- * CAN0:
- * PF0 - CANRX  PB4 - CANRX  PE4 - CANRX
- * PF3 - CANTX  PB5 - CANTX  PE5 - CANTX
- * CAN1:
- * PA0 - CANRX
- * PA1 - CANTX
- *
- * Inputs: 
- * port - from mil_port enum
- * base - CAN base(CAN0_BASE or CAN1_BASE) from tivaware
- * Assumes: Port clocks are enabled
- */
-void MIL_InitCAN(mil_can_port_t port,uint32_t base,uint32_t bps){
-
-
-    //pin configuration
-    /*
-     * Depending on the port, different pins
-     * need to be configured
-	 * 
-	 * 
-     */
-    switch(port){
-        case MIL_CAN_PORT_B:
-            GPIOPinConfigure(GPIO_PB4_CAN0RX);
-            GPIOPinConfigure(GPIO_PB5_CAN0TX);
-            GPIOPinTypeCAN(GPIO_PORTB_BASE, GPIO_PIN_4 | GPIO_PIN_5);
-            break;
-        case MIL_CAN_PORT_E:
-            GPIOPinConfigure(GPIO_PE4_CAN0RX);
-            GPIOPinConfigure(GPIO_PE5_CAN0TX);
-            GPIOPinTypeCAN(GPIO_PORTE_BASE, GPIO_PIN_4 | GPIO_PIN_5);
-            break;
-        case MIL_CAN_PORT_F:
-            GPIOPinConfigure(GPIO_PF0_CAN0RX);
-            GPIOPinConfigure(GPIO_PF3_CAN0TX);
-            GPIOPinTypeCAN(GPIO_PORTF_BASE, GPIO_PIN_0 | GPIO_PIN_3);
-            break;
-    }
-	
-	/*
-	 * Enable can peripheral
-	 * in case of CAN1 being selected, this section of code
-	 * will also configure the CAN1 pins
-	 */
-	switch(base){
-		case CAN0_BASE:
-			SysCtlPeripheralEnable(SYSCTL_PERIPH_CAN0);
-			break;
-		case CAN1_BASE:
-			SysCtlPeripheralEnable(SYSCTL_PERIPH_CAN1);
-			GPIOPinConfigure(GPIO_PA0_CAN1RX);
-			GPIOPinConfigure(GPIO_PA1_CAN1TX);
-			GPIOPinTypeCAN(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
-		
-	}
-
-		
-
-    //Initialize CAN controller
-    CANInit(base);
-
-    //Set can retry to true
-    CANRetrySet(base,1);
-
-    //Set bit rates
-    CANBitRateSet(base, SysCtlClockGet(), bps);
-
-    //enable CAN
-    CANEnable(base);
-
-}
-
-/*
- * Desc: Enables interrupts on CAN0
- *
- * Notes: The Tiva CAN system has two
- *        separate interrupt sources.
- *        Either a controller error has
- *        occured(Tiva side) or there's
- *        a status change which can result
- *        from message transfer or a system
- *        bus error.
- *
- *        Further diagnostics in required in
- *        the external program
- *
- * Inputs: A pointer to your custom ISR
- * Assumes: Nothing
- */
-void MIL_CANIntEnable(void (*func_ptr)(void),uint32_t base){
-
-    //set a custom ISR
-    CANIntRegister(base, func_ptr);
-
-    //enable status interrupts
-    //errors due to controller errors are ignored
-    CANIntEnable(base, CAN_INT_MASTER | CAN_INT_STATUS);
-
-	switch(base){
-		case CAN0_BASE:
-			IntEnable(INT_CAN0);
-			break;
-			
-		case CAN1_BASE:
-			IntEnable(INT_CAN1);
-			break;
-	}
-
-}
-
-/*
- * Desc: Enables the Port associated with the CAN system
- *
- * Note: For sake of your program making sense,
- *       only call this function if your CAN shares the
- *       port with no other GPIOs or peripherals
- *
- *       This just called the GPIO clock enable for
- *       the port
- */
-void MIL_CANPortClkEnable(mil_can_port_t port){
-
-    switch(port){
-
-        case MIL_CAN_PORT_A:
-            SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
-            break;
-        case MIL_CAN_PORT_B:
-            SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
-            break;
-        case MIL_CAN_PORT_E:
-            SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-            break;
-        case MIL_CAN_PORT_F:
-            SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-            break;
-
-    }
-
-}
-
-/*
- * Desc: Easy to use function to transmit a message to the CAN bus
- * 	     This function declares a temporary Can message object and uses
- *	     object 0 to transmit the message
- * 
- * Inputs: 
- * canid - ID of your CAN node
- * pMsg  - pointer to your message 
- * MsgLen - the number of bytes in your message(up to 8 bytes)
- * base - which CAN module you want to use(CAN1_BASE or CAN0_BASE from tivaWare)
- */
-void MIL_CANSimpleTX(uint32_t canid,uint8_t *pMsg,uint8_t MsgLen,uint32_t base){
-	
-	tCANMsgObject SimpleTXObj;
-	SimpleTXObj.ui32MsgID = canid;
-	SimpleTXObj.ui32Flags = 0;
-	SimpleTXObj.ui32MsgLen = MsgLen;
-	SimpleTXObj.pui8MsgData = pMsg;
-	CANMessageSet(base, 0, &SimpleTXObj, MSG_OBJ_TYPE_TX);
-
-}
-
-/*
- * Desc: after configureing your mailbox struct
- *       pass it into this function in order to
- *       intialize reception
- *
- * Parameters:
- * pmailbox - a pointer to your mailbox
- * outBuffer- a pointer to your CAN output array
- */
-void MIL_InitMailBox(MIL_CAN_MailBox_t *pmailbox){
-
-    //basically copy mailbox parameters to TI CAN object
-    pmailbox->msg_obj.ui32MsgID = pmailbox->canid;
-    pmailbox->msg_obj.ui32MsgIDMask = pmailbox->filt_mask;
-    pmailbox->msg_obj.pui8MsgData = pmailbox->buffer;
-
-    //check for rx_flag_int
-    if(pmailbox->rx_flag_int){
-        pmailbox->msg_obj.ui32Flags = MSG_OBJ_RX_INT_ENABLE | MSG_OBJ_USE_ID_FILTER;
-    }
-    else{
-        pmailbox->msg_obj.ui32Flags = MSG_OBJ_USE_ID_FILTER;
-    }
-    pmailbox->msg_obj.ui32MsgLen = pmailbox->msg_len;
-
-    CANMessageSet(pmailbox->base, pmailbox->obj_num, &pmailbox->msg_obj, MSG_OBJ_TYPE_RX);
-}
-
-/*
- * Desc: if there is mail to be received
- *       this function will return that data
- *       to your buffer(pdata) this function
- *       will check if there is data but will
- *       not wait for new data
- *
- *       If there is data, it will return MIL_CAN_OK
- *       otherwise it will return MIL_CAN_NOK
- *
- * Parameters:
- * pmailbox - a pointer to your mailbox object struct
- *
- * Returns:
- * mil_can_status_t - MIL_CAN_OK if there was new data
- *                    MIL_CAN_NOK if there is no data
- *
- * NOTE: DATA WILL BE LOADED TO YOUR DESIGNATED OUTPUT BUFFER IN THE
- * MAILBOX INIT
- *
- */
-mil_can_status_t MIL_CAN_GetMail(MIL_CAN_MailBox_t *pmailbox){
-
-
-        if(CANStatusGet(pmailbox->base,CAN_STS_NEWDAT) & (0x01<<(pmailbox->obj_num-1))){
-
-            //receive message and clear flag
-            CANMessageGet(pmailbox->base,pmailbox->obj_num,&pmailbox->msg_obj,1);
-
-//            for(uint8_t i = 0;i < pmailbox->msg_len;i++){
-//
-//                pdata[i] = pmailbox->msg_obj.pui8MsgData[i];
-//
-//            }
-
-            return MIL_CAN_OK;
-        }
-
-    else{
-
-        return MIL_CAN_NOK;
-
-    }
-
-}
-/*
- * Desc: Will return MIL_CAN_OK for new data
- *       or MIL_CAN_NOK if there is no data
- *
- * Paramters:
- * pmailbox - a pointer to your initialized mailbox
- *
- * Returns:
- * a mil_can_status_t depending on whether or not there's data
- *
- */
-mil_can_status_t MIL_CAN_CheckMail(MIL_CAN_MailBox_t *pmailbox){
-
-    if(CANStatusGet(pmailbox->base,CAN_STS_NEWDAT) & (0x01 << (pmailbox->obj_num-1))){return MIL_CAN_OK;}
-    else{return MIL_CAN_NOK;}
-
-}
-
-
-
-
-
-
-
+/*
+ * Name: MIL_CAN.c
+ * Author: Marquez Jones0
+ * Date Modified: 11/2/2019
+ * Desc: A set of wrapper functions I designed
+ *       to standardized CAN use in the Lab
+ *       this primarily is to reduce the number
+ *       of bugs caused by the CAN bus
+ *
+ * Notes: CAN devices should be run at 200k bps
+ *        and PCBs on the network should have on
+ *        board termination resistors
+ * BAUD UPDATE: CAN INIT NOW HAS CONFIGURABLE BAUD RATE
+ */
+
+/* INCLUDES */
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_can.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/can.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+
+//MIL includes
+#include"MIL_CAN.h"
+#ifdef MIL_CAN_STATS
+#include "MIL_CAN_Stats.h"
+#endif
+
+//internal functions defined further down
+static bool MIL_CAN_TxQueueReady(uint32_t base);
+static void MIL_CAN_LatestUpdate(uint32_t base,uint8_t obj_num);
+static void MIL_CAN_CoalOpen(uint32_t base);
+
+/*
+ * Desc: enables CAN which can be enabled on
+ *       Ports B,E, or F for CAN0 
+ * 		 or Port A for CAN1
+ *
+ * Notes: Does not enable interrupts
+ *        or port clocks
+ *        PORT and Interrupts
+ *        must be enabled outside funciton
+ *	
+ *		  IF YOU SET CAN1_BASE AS YOUR BASE
+ *   	  FUNCTION WILL DEFAULT TO CONFIGURING PORT A
+ *
+ * Hardware Notes:
+ * CAN0:
+ * PF0 - CANRX  PB4 - CANRX  PE4 - CANRX
+ * PF3 - CANTX  PB5 - CANTX  PE5 - CANTX
+ * CAN1:
+ * PA0 - CANRX
+ * PA1 - CANTX
+ *
+ * Inputs: 
+ * port - from mil_port enum
+ * base - CAN base(CAN0_BASE or CAN1_BASE) from tivaware
+ * Assumes: Port clocks are enabled
+ */
+void MIL_InitCAN(mil_can_port_t port,uint32_t base,uint32_t bps){
+
+
+    //pin configuration
+    /*
+     * Depending on the port, different pins
+     * need to be configured
+	 * 
+	 * 
+     */
+    switch(port){
+        case MIL_CAN_PORT_B:
+            GPIOPinConfigure(GPIO_PB4_CAN0RX);
+            GPIOPinConfigure(GPIO_PB5_CAN0TX);
+            GPIOPinTypeCAN(GPIO_PORTB_BASE, GPIO_PIN_4 | GPIO_PIN_5);
+            break;
+        case MIL_CAN_PORT_E:
+            GPIOPinConfigure(GPIO_PE4_CAN0RX);
+            GPIOPinConfigure(GPIO_PE5_CAN0TX);
+            GPIOPinTypeCAN(GPIO_PORTE_BASE, GPIO_PIN_4 | GPIO_PIN_5);
+            break;
+        case MIL_CAN_PORT_F:
+            GPIOPinConfigure(GPIO_PF0_CAN0RX);
+            GPIOPinConfigure(GPIO_PF3_CAN0TX);
+            GPIOPinTypeCAN(GPIO_PORTF_BASE, GPIO_PIN_0 | GPIO_PIN_3);
+            break;
+    }
+	
+	/*
+	 * Enable can peripheral
+	 * in case of CAN1 being selected, this section of code
+	 * will also configure the CAN1 pins
+	 */
+	switch(base){
+		case CAN0_BASE:
+			SysCtlPeripheralEnable(SYSCTL_PERIPH_CAN0);
+			break;
+		case CAN1_BASE:
+			SysCtlPeripheralEnable(SYSCTL_PERIPH_CAN1);
+			GPIOPinConfigure(GPIO_PA0_CAN1RX);
+			GPIOPinConfigure(GPIO_PA1_CAN1TX);
+			GPIOPinTypeCAN(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+		
+	}
+
+		
+
+    //Initialize CAN controller
+    CANInit(base);
+
+    //Set can retry to true
+    CANRetrySet(base,1);
+
+    //Set bit rates
+    CANBitRateSet(base, SysCtlClockGet(), bps);
+
+    //enable CAN
+    CANEnable(base);
+
+}
+
+/*
+ * Desc: Enables interrupts on CAN0
+ *
+ * Notes: The Tiva CAN system has two
+ *        separate interrupt sources.
+ *        Either a controller error has
+ *        occured(Tiva side) or there's
+ *        a status change which can result
+ *        from message transfer or a system
+ *        bus error.
+ *
+ *        Further diagnostics in required in
+ *        the external program
+ *
+ * Inputs: A pointer to your custom ISR
+ * Assumes: Nothing
+ */
+void MIL_CANIntEnable(void (*func_ptr)(void),uint32_t base){
+
+    //set a custom ISR
+    CANIntRegister(base, func_ptr);
+
+    //enable status interrupts
+    //errors due to controller errors are ignored
+    CANIntEnable(base, CAN_INT_MASTER | CAN_INT_STATUS);
+
+	switch(base){
+		case CAN0_BASE:
+			IntEnable(INT_CAN0);
+			break;
+			
+		case CAN1_BASE:
+			IntEnable(INT_CAN1);
+			break;
+	}
+
+}
+
+/*
+ * Desc: Enables the Port associated with the CAN system
+ *
+ * Note: For sake of your program making sense,
+ *       only call this function if your CAN shares the
+ *       port with no other GPIOs or peripherals
+ *
+ *       This just called the GPIO clock enable for
+ *       the port
+ */
+void MIL_CANPortClkEnable(mil_can_port_t port){
+
+    switch(port){
+
+        case MIL_CAN_PORT_A:
+            SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+            break;
+        case MIL_CAN_PORT_B:
+            SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
+            break;
+        case MIL_CAN_PORT_E:
+            SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
+            break;
+        case MIL_CAN_PORT_F:
+            SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+            break;
+
+    }
+
+}
+
+/*
+ * Desc: Easy to use function to transmit a message to the CAN bus
+ * 	     This function declares a temporary Can message object and uses
+ *	     object 0 to transmit the message
+ * 
+ *	     If MIL_CAN_TxQueueInit was called for this base, the message
+ *	     goes through the transmit queue instead
+ * 
+ * Inputs: 
+ * canid - ID of your CAN node
+ * pMsg  - pointer to your message 
+ * MsgLen - the number of bytes in your message(up to 8 bytes)
+ * base - which CAN module you want to use(CAN1_BASE or CAN0_BASE from tivaWare)
+ */
+void MIL_CANSimpleTX(uint32_t canid,uint8_t *pMsg,uint8_t MsgLen,uint32_t base){
+	
+	//don't stomp on the transmit pool if there is one
+	if(MIL_CAN_TxQueueReady(base)){
+		MIL_CAN_TxQueueSend(base,canid,pMsg,MsgLen);
+		return;
+	}
+
+	tCANMsgObject SimpleTXObj;
+	SimpleTXObj.ui32MsgID = canid;
+	SimpleTXObj.ui32Flags = 0;
+	SimpleTXObj.ui32MsgLen = MsgLen;
+	SimpleTXObj.pui8MsgData = pMsg;
+
+	uint32_t lock = MIL_CAN_IfLock();
+	CANMessageSet(base, 0, &SimpleTXObj, MSG_OBJ_TYPE_TX);
+	MIL_CAN_IfUnlock(lock);
+
+}
+
+/*
+ * Desc: after configureing your mailbox struct
+ *       pass it into this function in order to
+ *       intialize reception
+ *
+ * Parameters:
+ * pmailbox - a pointer to your mailbox
+ * outBuffer- a pointer to your CAN output array
+ */
+void MIL_InitMailBox(MIL_CAN_MailBox_t *pmailbox){
+
+    //basically copy mailbox parameters to TI CAN object
+    pmailbox->msg_obj.ui32MsgID = pmailbox->canid;
+    pmailbox->msg_obj.ui32MsgIDMask = pmailbox->filt_mask;
+    pmailbox->msg_obj.pui8MsgData = pmailbox->buffer;
+
+    //check for rx_flag_int
+    if(pmailbox->rx_flag_int){
+        pmailbox->msg_obj.ui32Flags = MSG_OBJ_RX_INT_ENABLE | MSG_OBJ_USE_ID_FILTER;
+    }
+    else{
+        pmailbox->msg_obj.ui32Flags = MSG_OBJ_USE_ID_FILTER;
+    }
+    pmailbox->msg_obj.ui32MsgLen = pmailbox->msg_len;
+
+    uint32_t lock = MIL_CAN_IfLock();
+    CANMessageSet(pmailbox->base, pmailbox->obj_num, &pmailbox->msg_obj, MSG_OBJ_TYPE_RX);
+    MIL_CAN_IfUnlock(lock);
+}
+
+/*
+ * Desc: if there is mail to be received
+ *       this function will return that data
+ *       to your buffer(pdata) this function
+ *       will check if there is data but will
+ *       not wait for new data
+ *
+ *       If there is data, it will return MIL_CAN_OK
+ *       otherwise it will return MIL_CAN_NOK
+ *
+ * Parameters:
+ * pmailbox - a pointer to your mailbox object struct
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if there was new data
+ *                    MIL_CAN_NOK if there is no data
+ *
+ * NOTE: DATA WILL BE LOADED TO YOUR DESIGNATED OUTPUT BUFFER IN THE
+ * MAILBOX INIT
+ *
+ */
+mil_can_status_t MIL_CAN_GetMail(MIL_CAN_MailBox_t *pmailbox){
+
+
+        if(CANStatusGet(pmailbox->base,CAN_STS_NEWDAT) & (0x01<<(pmailbox->obj_num-1))){
+
+            //receive message and clear flag
+            uint32_t lock = MIL_CAN_IfLock();
+            CANMessageGet(pmailbox->base,pmailbox->obj_num,&pmailbox->msg_obj,1);
+            MIL_CAN_IfUnlock(lock);
+
+//            for(uint8_t i = 0;i < pmailbox->msg_len;i++){
+//
+//                pdata[i] = pmailbox->msg_obj.pui8MsgData[i];
+//
+//            }
+
+            return MIL_CAN_OK;
+        }
+
+    else{
+
+        return MIL_CAN_NOK;
+
+    }
+
+}
+/*
+ * Desc: Will return MIL_CAN_OK for new data
+ *       or MIL_CAN_NOK if there is no data
+ *
+ * Paramters:
+ * pmailbox - a pointer to your initialized mailbox
+ *
+ * Returns:
+ * a mil_can_status_t depending on whether or not there's data
+ *
+ */
+mil_can_status_t MIL_CAN_CheckMail(MIL_CAN_MailBox_t *pmailbox){
+
+    if(CANStatusGet(pmailbox->base,CAN_STS_NEWDAT) & (0x01 << (pmailbox->obj_num-1))){return MIL_CAN_OK;}
+    else{return MIL_CAN_NOK;}
+
+}
+
+/**************************INTERRUPT DRIVEN RECEPTION********************/
+
+//CAN0 and CAN1
+#define MIL_CAN_MODULES 2
+
+#if (MIL_CAN_RXQ_SIZE & (MIL_CAN_RXQ_SIZE - 1)) != 0
+#error "MIL_CAN_RXQ_SIZE must be a power of 2"
+#endif
+
+/*
+ * Desc: stops the compiler from moving memory accesses across this point
+ *       used to make sure a queue slot is fully written before the index
+ *       that publishes it is updated
+ */
+#if defined(__GNUC__)
+#define MIL_CAN_BARRIER() __asm volatile("" ::: "memory")
+#else
+#define MIL_CAN_BARRIER() __asm(" dmb")
+#endif
+
+/*
+ * Desc: receive queue state for one CAN module
+ *
+ * Note: head is only ever written by the ISR and tail is only
+ *       ever written by the main loop, that's what lets both
+ *       sides run without disabling interrupts
+ */
+typedef struct{
+
+    MIL_CAN_Frame_t frames[MIL_CAN_RXQ_SIZE];
+    volatile uint32_t head;       //next slot the ISR fills
+    volatile uint32_t tail;       //next slot the main loop reads
+    volatile uint32_t obj_mask;   //bit n-1 set = message object n feeds the queue
+    volatile uint32_t latest_mask;//bit n-1 set = message object n feeds a latest value box
+    mil_can_rx_hook_t hook;
+    volatile uint32_t rx_frames;
+    volatile uint32_t overflows;
+    volatile uint32_t lost;
+    uint8_t  coal_frames;         //0 = coalescing off
+    uint32_t coal_delay_us;
+    volatile bool coal_open;      //frames are waiting for a deferred drain
+    volatile bool coal_drain;     //the tick pended the CAN ISR to drain
+    uint32_t coal_start_us;
+    MIL_CAN_RxCoalesceStats_t coal_stats;
+
+}mil_can_rxq_t;
+
+static mil_can_rxq_t MIL_CAN_RxQueue[MIL_CAN_MODULES];
+
+/*
+ * Desc: maps a CAN base to the index of its state
+ */
+static uint8_t MIL_CAN_ModuleIdx(uint32_t base){
+
+    if(base == CAN1_BASE){return 1;}
+    else{return 0;}
+
+}
+
+/*
+ * Desc: returns the index of the lowest set bit
+ *
+ * Note: val must not be 0
+ */
+static uint32_t MIL_CAN_Ctz(uint32_t val){
+
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(val);
+#else
+    //de Bruijn lookup of the isolated lowest bit
+    static const uint8_t debruijn[32] = {
+        0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+        31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+    };
+    return debruijn[((val & -val) * 0x077CB531u) >> 27];
+#endif
+
+}
+
+/*
+ * Desc: reads one message object into the receive queue
+ *
+ * Note: the object is always read, even with a full queue,
+ *       so its new data and interrupt flags get cleared
+ */
+static void MIL_CAN_RxQueuePush(uint32_t base,mil_can_rxq_t *prxq,uint8_t obj_num){
+
+    uint32_t head = prxq->head;
+    MIL_CAN_Frame_t frame;
+    tCANMsgObject msg;
+
+    msg.pui8MsgData = frame.data;
+    CANMessageGet(base,obj_num,&msg,1);
+
+    frame.canid = msg.ui32MsgID;
+    frame.len = (uint8_t)msg.ui32MsgLen;
+    frame.obj_num = obj_num;
+    frame.flags = 0;
+
+    if(msg.ui32Flags & MSG_OBJ_DATA_LOST){
+        frame.flags |= MIL_CAN_FRAME_LOST;
+        prxq->lost++;
+    }
+
+#ifdef MIL_CAN_STATS
+    //the frame was on the bus whether or not there's room for it
+    MIL_CAN_StatsRecord(base,&frame);
+#endif
+
+    //the hook runs before the room check so a full queue can't
+    //starve it, a frame the hook takes never shows up in the queue
+    if(prxq->hook && prxq->hook(base,&frame)){
+        return;
+    }
+
+    if((head - prxq->tail) >= MIL_CAN_RXQ_SIZE){
+        prxq->overflows++;
+        return;
+    }
+
+    prxq->frames[head & (MIL_CAN_RXQ_SIZE - 1)] = frame;
+
+    //publish the slot only after it's completely written
+    MIL_CAN_BARRIER();
+    prxq->head = head + 1;
+    prxq->rx_frames++;
+
+}
+
+/*
+ * Desc: empties the receive queue for a CAN module,
+ *       detaches every mailbox and clears the counters
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_RxQueueInit(uint32_t base){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+
+    prxq->obj_mask = 0;
+    prxq->head = 0;
+    prxq->tail = 0;
+    prxq->rx_frames = 0;
+    prxq->overflows = 0;
+    prxq->lost = 0;
+
+}
+
+/*
+ * Desc: initializes a mailbox like MIL_InitMailBox but
+ *       routes everything it receives into the receive queue
+ *
+ * Note: the rx_flag_int parameter is forced to 1
+ *       and the buffer parameter is ignored
+ *
+ * Parameters:
+ * pmailbox - a pointer to your configured mailbox
+ */
+void MIL_CAN_RxQueueAttach(MIL_CAN_MailBox_t *pmailbox){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(pmailbox->base)];
+
+    pmailbox->rx_flag_int = 1;
+    MIL_InitMailBox(pmailbox);
+
+    prxq->obj_mask |= (0x01UL << (pmailbox->obj_num - 1));
+
+}
+
+/*
+ * Desc: pops the oldest frame out of the receive queue
+ *       this will not wait for new frames
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pframe - where the frame will be copied to
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if a frame was copied to pframe
+ *                    MIL_CAN_NOK if the queue is empty
+ */
+mil_can_status_t MIL_CAN_RxQueueGet(uint32_t base,MIL_CAN_Frame_t *pframe){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+    uint32_t tail = prxq->tail;
+
+    if(tail == prxq->head){
+        return MIL_CAN_NOK;
+    }
+
+    //read the slot before handing it back to the ISR
+    MIL_CAN_BARRIER();
+    *pframe = prxq->frames[tail & (MIL_CAN_RXQ_SIZE - 1)];
+    MIL_CAN_BARRIER();
+    prxq->tail = tail + 1;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: number of frames currently waiting in the receive queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+uint32_t MIL_CAN_RxQueueCount(uint32_t base){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+
+    return prxq->head - prxq->tail;
+
+}
+
+/*
+ * Desc: copies out the receive queue counters
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pstats - where the counters will be copied to
+ */
+void MIL_CAN_RxQueueStatsGet(uint32_t base,MIL_CAN_RxQueueStats_t *pstats){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+
+    pstats->rx_frames = prxq->rx_frames;
+    pstats->overflows = prxq->overflows;
+    pstats->lost = prxq->lost;
+
+}
+
+/*
+ * Desc: runs a function on every frame headed for the receive queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * hook - your function(0 to remove it), return true to keep the
+ *        frame out of the queue
+ */
+void MIL_CAN_RxHookSet(uint32_t base,mil_can_rx_hook_t hook){
+
+    MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)].hook = hook;
+
+}
+
+/**************************QUEUED TRANSMISSION***************************/
+
+#if (MIL_CAN_TXQ_SIZE & (MIL_CAN_TXQ_SIZE - 1)) != 0
+#error "MIL_CAN_TXQ_SIZE must be a power of 2"
+#endif
+
+#if (MIL_CAN_TXCLASS_SIZE & (MIL_CAN_TXCLASS_SIZE - 1)) != 0
+#error "MIL_CAN_TXCLASS_SIZE must be a power of 2"
+#endif
+
+/*
+ * Desc: transmit queue state for one class on one CAN module
+ *
+ * Note: head is only written by the sender and tail is only written
+ *       by the refill, which runs with the CAN interrupt masked
+ *       whenever it's called outside the ISR
+ */
+typedef struct{
+
+    MIL_CAN_Frame_t *frames;
+    uint32_t size_mask;           //queue size - 1
+    volatile uint32_t head;       //next slot the sender fills
+    volatile uint32_t tail;       //next slot loaded into an object
+    uint32_t pool_mask;           //bit n-1 set = message object n is reserved for TX
+    volatile uint32_t busy_mask;  //reserved objects we loaded that haven't finished
+    volatile uint32_t queued;
+    volatile uint32_t sent;
+    volatile uint32_t dropped;
+    mil_can_tx_policy_t policy;
+    uint32_t deadline_us;
+    uint32_t armed_mask;          //one shot objects that have had their chance
+    volatile uint32_t abandoned;
+
+}mil_can_txq_t;
+
+static mil_can_txq_t MIL_CAN_TxQueue[MIL_CAN_MODULES][MIL_CAN_TX_NUM_CLASSES];
+
+//bulk is the general purpose queue so it gets the deep buffer
+static MIL_CAN_Frame_t MIL_CAN_TxBulkFrames[MIL_CAN_MODULES][MIL_CAN_TXQ_SIZE];
+static MIL_CAN_Frame_t MIL_CAN_TxClassFrames[MIL_CAN_MODULES][MIL_CAN_TX_BULK][MIL_CAN_TXCLASS_SIZE];
+
+//when each transmit object was loaded, only kept for deadline classes
+static uint32_t MIL_CAN_TxLoadUs[MIL_CAN_MODULES][32];
+static uint32_t (*MIL_CAN_TxTime)(void);
+
+/*
+ * Desc: returns the index of the highest set bit
+ *
+ * Note: val must not be 0
+ */
+static uint32_t MIL_CAN_Msb(uint32_t val){
+
+#if defined(__GNUC__)
+    return 31 - (uint32_t)__builtin_clz(val);
+#else
+    uint32_t idx = 0;
+    while(val >>= 1){idx++;}
+    return idx;
+#endif
+
+}
+
+/*
+ * Desc: number of set bits
+ */
+static uint32_t MIL_CAN_PopCount(uint32_t val){
+
+    uint32_t count = 0;
+
+    while(val){
+        count++;
+        val &= val - 1;
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: pulls frames a one shot or deadline class gave up on out of
+ *       their objects
+ *
+ * Returns:
+ * uint32_t - objects that were cancelled
+ */
+static uint32_t MIL_CAN_TxPolicyEnforce(uint32_t base,mil_can_txq_t *ptxq,uint32_t pending,bool bus_event){
+
+    uint32_t cancel = 0;
+
+    if(ptxq->policy == MIL_CAN_TX_ONESHOT){
+
+        /*
+         * something finished on the bus(or failed), so anything that was
+         * already waiting at the last bus event has had its attempt
+         *
+         * frames are only marked here and not when they're loaded, a frame
+         * loaded while another one is on the wire would otherwise be pulled
+         * without a try. The cost is a frame loaded between frames gets
+         * a second try, and one pulled after it won arbitration still goes
+         * out but is counted as abandoned
+         */
+        if(bus_event){
+            cancel = pending & ptxq->armed_mask;
+            ptxq->armed_mask = pending & ~cancel;
+        }
+
+    }
+    else if((ptxq->policy == MIL_CAN_TX_DEADLINE) && MIL_CAN_TxTime){
+
+        uint32_t now = MIL_CAN_TxTime();
+        uint32_t *pload_us = MIL_CAN_TxLoadUs[MIL_CAN_ModuleIdx(base)];
+        uint32_t objs = pending;
+
+        while(objs){
+            uint32_t obj = MIL_CAN_Ctz(objs);
+            if((now - pload_us[obj]) > ptxq->deadline_us){
+                cancel |= 0x01UL << obj;
+            }
+            objs &= objs - 1;
+        }
+
+    }
+
+    //an invalid object stops requesting the bus
+    pending = cancel;
+    while(pending){
+        CANMessageClear(base,MIL_CAN_Ctz(pending) + 1);
+        pending &= pending - 1;
+    }
+
+    return cancel;
+
+}
+
+/*
+ * Desc: retires finished transmit objects and loads queued
+ *       frames into the free ones
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * ptxq - class to refill
+ * bus_event - a frame finished or failed since the last call(status interrupt)
+ *
+ * Note: must run with the CAN interrupt masked or from the ISR
+ */
+static void MIL_CAN_TxQueueRefill(uint32_t base,mil_can_txq_t *ptxq,bool bus_event){
+
+    uint32_t pending = CANStatusGet(base,CAN_STS_TXREQUEST) & ptxq->pool_mask;
+    uint32_t cancel = 0;
+    uint32_t done;
+    uint32_t free_objs;
+    tCANMsgObject msg;
+
+    if(ptxq->policy != MIL_CAN_TX_RETRY){
+        cancel = MIL_CAN_TxPolicyEnforce(base,ptxq,pending,bus_event);
+        pending &= ~cancel;
+    }
+
+    //count objects that finished since last time
+    done = ptxq->busy_mask & ~pending;
+    ptxq->sent += MIL_CAN_PopCount(done & ~cancel);
+    ptxq->abandoned += MIL_CAN_PopCount(cancel);
+    ptxq->busy_mask &= pending;
+
+    /*
+     * lower objects transmit first, so only objects above the
+     * highest pending one can be loaded without reordering frames
+     */
+    free_objs = ptxq->pool_mask;
+    if(pending){
+        uint32_t top = MIL_CAN_Msb(pending);
+        free_objs &= (top >= 31) ? 0 : ~((0x02UL << top) - 1);
+    }
+
+    while(free_objs && (ptxq->tail != ptxq->head)){
+
+        uint32_t tail = ptxq->tail;
+        MIL_CAN_Frame_t *pframe = &ptxq->frames[tail & ptxq->size_mask];
+        uint32_t obj_bit = free_objs & -free_objs;
+
+        msg.ui32MsgID = pframe->canid;
+        msg.ui32MsgIDMask = 0;
+        msg.ui32Flags = 0;
+        msg.ui32MsgLen = pframe->len;
+        msg.pui8MsgData = pframe->data;
+        CANMessageSet(base,MIL_CAN_Ctz(obj_bit) + 1,&msg,MSG_OBJ_TYPE_TX);
+
+        if((ptxq->policy == MIL_CAN_TX_DEADLINE) && MIL_CAN_TxTime){
+            MIL_CAN_TxLoadUs[MIL_CAN_ModuleIdx(base)][MIL_CAN_Ctz(obj_bit)] = MIL_CAN_TxTime();
+        }
+
+        ptxq->busy_mask |= obj_bit;
+        ptxq->tail = tail + 1;
+        free_objs &= ~obj_bit;
+
+    }
+
+}
+
+/*
+ * Desc: true if a transmit pool has been reserved on this base
+ */
+static bool MIL_CAN_TxQueueReady(uint32_t base){
+
+    return MIL_CAN_TxQueue[MIL_CAN_ModuleIdx(base)][MIL_CAN_TX_BULK].pool_mask != 0;
+
+}
+
+/*
+ * Desc: reserves message objects first_obj to first_obj + num_objs - 1
+ *       for transmission and empties the transmit queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * first_obj - first reserved message object(1 to 32)
+ * num_objs - how many objects to reserve
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the objects run past object 32
+ */
+mil_can_status_t MIL_CAN_TxQueueInit(uint32_t base,uint8_t first_obj,uint8_t num_objs){
+
+    return MIL_CAN_TxClassInit(base,MIL_CAN_TX_BULK,first_obj,num_objs);
+
+}
+
+/*
+ * Desc: queues a frame for transmission, this never waits on the bus
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * canid - ID to send with
+ * pMsg - pointer to your message(copied, you can reuse it right away)
+ * MsgLen - number of bytes in your message(up to 8 bytes)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if the frame was queued
+ *                    MIL_CAN_NOK if the queue is full or not initialized
+ */
+mil_can_status_t MIL_CAN_TxQueueSend(uint32_t base,uint32_t canid,const uint8_t *pMsg,uint8_t MsgLen){
+
+    return MIL_CAN_TxClassSend(base,MIL_CAN_TX_BULK,canid,pMsg,MsgLen);
+
+}
+
+/*
+ * Desc: number of frames waiting for a free message object
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+uint32_t MIL_CAN_TxQueueCount(uint32_t base){
+
+    return MIL_CAN_TxClassCount(base,MIL_CAN_TX_BULK);
+
+}
+
+/*
+ * Desc: copies out the transmit queue counters
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pstats - where the counters will be copied to
+ */
+void MIL_CAN_TxQueueStatsGet(uint32_t base,MIL_CAN_TxQueueStats_t *pstats){
+
+    MIL_CAN_TxClassStatsGet(base,MIL_CAN_TX_BULK,pstats);
+
+}
+
+/**************************PRIORITY TRANSMIT CLASSES*********************/
+
+/*
+ * Desc: reserves message objects first_obj to first_obj + num_objs - 1
+ *       for a class and empties its queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * tx_class - class to set up
+ * first_obj - first reserved message object(1 to 32)
+ * num_objs - how many objects to reserve
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the objects run past object 32,
+ *                    overlap another class or sit below a more urgent class
+ */
+mil_can_status_t MIL_CAN_TxClassInit(uint32_t base,mil_can_tx_class_t tx_class,uint8_t first_obj,uint8_t num_objs){
+
+    uint8_t idx = MIL_CAN_ModuleIdx(base);
+    mil_can_txq_t *ptxq;
+    uint32_t pool_mask = 0;
+
+    if((tx_class >= MIL_CAN_TX_NUM_CLASSES) || (first_obj < 1) || (num_objs < 1) ||
+       ((first_obj + num_objs - 1) > 32)){
+        return MIL_CAN_NOK;
+    }
+
+    for(uint8_t i = 0;i < num_objs;i++){
+        pool_mask |= 0x01UL << (first_obj - 1 + i);
+    }
+
+    /*
+     * the band has to sit above every more urgent class and below every
+     * less urgent one, otherwise the controller's object order would
+     * put a less urgent frame first
+     */
+    for(uint8_t c = 0;c < MIL_CAN_TX_NUM_CLASSES;c++){
+
+        uint32_t other = MIL_CAN_TxQueue[idx][c].pool_mask;
+
+        if((c == tx_class) || !other){
+            continue;
+        }
+
+        if(other & pool_mask){
+            return MIL_CAN_NOK;
+        }
+
+        if((c < tx_class) && (MIL_CAN_Msb(other) > MIL_CAN_Ctz(pool_mask))){
+            return MIL_CAN_NOK;
+        }
+
+        if((c > tx_class) && (MIL_CAN_Ctz(other) < MIL_CAN_Msb(pool_mask))){
+            return MIL_CAN_NOK;
+        }
+
+    }
+
+    ptxq = &MIL_CAN_TxQueue[idx][tx_class];
+
+    //stop the ISR from touching the class while it's reset
+    ptxq->pool_mask = 0;
+
+    if(tx_class == MIL_CAN_TX_BULK){
+        ptxq->frames = MIL_CAN_TxBulkFrames[idx];
+        ptxq->size_mask = MIL_CAN_TXQ_SIZE - 1;
+    }
+    else{
+        ptxq->frames = MIL_CAN_TxClassFrames[idx][tx_class];
+        ptxq->size_mask = MIL_CAN_TXCLASS_SIZE - 1;
+    }
+
+    ptxq->head = 0;
+    ptxq->tail = 0;
+    ptxq->busy_mask = 0;
+    ptxq->queued = 0;
+    ptxq->sent = 0;
+    ptxq->dropped = 0;
+    ptxq->armed_mask = 0;
+    ptxq->abandoned = 0;
+
+    MIL_CAN_BARRIER();
+    ptxq->pool_mask = pool_mask;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: queues a frame in a class, this never waits on the bus
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * tx_class - class to send in
+ * canid - ID to send with
+ * pMsg - pointer to your message(copied, you can reuse it right away)
+ * MsgLen - number of bytes in your message(up to 8 bytes)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if the frame was queued
+ *                    MIL_CAN_NOK if the class is full or not initialized
+ */
+mil_can_status_t MIL_CAN_TxClassSend(uint32_t base,mil_can_tx_class_t tx_class,uint32_t canid,const uint8_t *pMsg,uint8_t MsgLen){
+
+    uint8_t idx = MIL_CAN_ModuleIdx(base);
+    mil_can_txq_t *ptxq;
+    uint32_t head;
+    uint32_t lock;
+
+    if(tx_class >= MIL_CAN_TX_NUM_CLASSES){
+        return MIL_CAN_NOK;
+    }
+
+    ptxq = &MIL_CAN_TxQueue[idx][tx_class];
+    head = ptxq->head;
+
+    if(!ptxq->pool_mask){
+        return MIL_CAN_NOK;
+    }
+
+    if((head - ptxq->tail) > ptxq->size_mask){
+        ptxq->dropped++;
+        return MIL_CAN_NOK;
+    }
+
+    if(MsgLen > 8){MsgLen = 8;}
+
+    MIL_CAN_Frame_t *pframe = &ptxq->frames[head & ptxq->size_mask];
+    pframe->canid = canid;
+    pframe->len = MsgLen;
+    pframe->obj_num = 0;
+    pframe->flags = 0;
+    for(uint8_t i = 0;i < MsgLen;i++){
+        pframe->data[i] = pMsg[i];
+    }
+
+    MIL_CAN_BARRIER();
+    ptxq->head = head + 1;
+    ptxq->queued++;
+
+    //start the transfer now instead of waiting for the next TXOK,
+    //the lock also keeps the other module's ISR off IF1 when a
+    //gateway hook sends from there
+    lock = MIL_CAN_IfLock();
+    MIL_CAN_TxQueueRefill(base,ptxq,false);
+    MIL_CAN_IfUnlock(lock);
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: number of frames a class has waiting for a free message object,
+ *       0 for a class that doesn't exist
+ */
+uint32_t MIL_CAN_TxClassCount(uint32_t base,mil_can_tx_class_t tx_class){
+
+    mil_can_txq_t *ptxq;
+
+    if(tx_class >= MIL_CAN_TX_NUM_CLASSES){
+        return 0;
+    }
+
+    ptxq = &MIL_CAN_TxQueue[MIL_CAN_ModuleIdx(base)][tx_class];
+
+    return ptxq->head - ptxq->tail;
+
+}
+
+/*
+ * Desc: copies out a class's counters, pstats is left alone for a class
+ *       that doesn't exist
+ */
+void MIL_CAN_TxClassStatsGet(uint32_t base,mil_can_tx_class_t tx_class,MIL_CAN_TxQueueStats_t *pstats){
+
+    mil_can_txq_t *ptxq;
+
+    if(tx_class >= MIL_CAN_TX_NUM_CLASSES){
+        return;
+    }
+
+    ptxq = &MIL_CAN_TxQueue[MIL_CAN_ModuleIdx(base)][tx_class];
+
+    pstats->queued = ptxq->queued;
+    pstats->sent = ptxq->sent;
+    pstats->dropped = ptxq->dropped;
+    pstats->abandoned = ptxq->abandoned;
+
+}
+
+/**************************TRANSMIT POLICIES*****************************/
+
+/*
+ * Desc: picks what a class does with a frame that can't get onto the bus
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * tx_class - class to change
+ * policy - MIL_CAN_TX_RETRY, MIL_CAN_TX_ONESHOT or MIL_CAN_TX_DEADLINE
+ * deadline_us - how long a frame may wait in its object(MIL_CAN_TX_DEADLINE only)
+ * time_us - function returning a free running microsecond count
+ *           (MIL_CAN_TX_DEADLINE only, shared by every class)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK for a deadline policy without a clock
+ */
+mil_can_status_t MIL_CAN_TxClassPolicy(uint32_t base,mil_can_tx_class_t tx_class,mil_can_tx_policy_t policy,uint32_t deadline_us,uint32_t (*time_us)(void)){
+
+    mil_can_txq_t *ptxq;
+
+    if(tx_class >= MIL_CAN_TX_NUM_CLASSES){
+        return MIL_CAN_NOK;
+    }
+
+    if(policy == MIL_CAN_TX_DEADLINE){
+        if(!time_us){
+            return MIL_CAN_NOK;
+        }
+        MIL_CAN_TxTime = time_us;
+    }
+
+    ptxq = &MIL_CAN_TxQueue[MIL_CAN_ModuleIdx(base)][tx_class];
+    ptxq->deadline_us = deadline_us;
+    ptxq->armed_mask = 0;
+    ptxq->policy = policy;
+
+    return MIL_CAN_OK;
+
+}
+
+/**************************ERROR HANDLING AND BUS-OFF RECOVERY***********/
+
+/*
+ * Desc: error handler state for one CAN module
+ */
+typedef struct{
+
+    uint32_t (*time_us)(void);       //0 until MIL_CAN_ErrInit is called
+    uint32_t recovery_us;
+    uint32_t entered_us;             //when the current state started
+    uint32_t mark_us;                //last time time_in_state_us was updated
+    volatile uint8_t restart_pending;
+    MIL_CAN_ErrStats_t stats;
+
+}mil_can_err_t;
+
+static mil_can_err_t MIL_CAN_Err[MIL_CAN_MODULES];
+
+/*
+ * Desc: books the time since the last call to the current state
+ *
+ * Note: only clock differences are used, so the clock can wrap as long
+ *       as this runs more often than it does
+ *
+ * Returns:
+ * the clock reading
+ */
+static uint32_t MIL_CAN_ErrClock(mil_can_err_t *perr){
+
+    uint32_t now = perr->time_us();
+
+    perr->stats.time_in_state_us[perr->stats.state] += (uint32_t)(now - perr->mark_us);
+    perr->mark_us = now;
+
+    return now;
+
+}
+
+/*
+ * Desc: moves to a new error state and books the time spent in the old one
+ */
+static void MIL_CAN_ErrEnter(mil_can_err_t *perr,mil_can_err_state_t state){
+
+    if(state == perr->stats.state){
+        return;
+    }
+
+    perr->entered_us = MIL_CAN_ErrClock(perr);
+
+    switch(state){
+        case MIL_CAN_ERR_WARNING:
+            perr->stats.warning_count++;
+            break;
+        case MIL_CAN_ERR_PASSIVE:
+            perr->stats.passive_count++;
+            break;
+        case MIL_CAN_ERR_BUS_OFF:
+            perr->stats.bus_off_count++;
+            break;
+        case MIL_CAN_ERR_ACTIVE:
+            if(perr->stats.state == MIL_CAN_ERR_RECOVERING){
+                perr->stats.recoveries++;
+            }
+            break;
+        default:
+            break;
+    }
+
+    perr->stats.state = state;
+
+}
+
+/*
+ * Desc: brings a bus off controller back, it rejoins the bus on its
+ *       own after seeing 128 idle periods
+ */
+static void MIL_CAN_ErrRestart(uint32_t base,mil_can_err_t *perr){
+
+    perr->restart_pending = 0;
+    CANEnable(base);
+    MIL_CAN_ErrEnter(perr,MIL_CAN_ERR_RECOVERING);
+
+}
+
+/*
+ * Desc: runs the state machine on a freshly read status register
+ */
+static void MIL_CAN_ErrUpdate(uint32_t base,uint32_t status){
+
+    mil_can_err_t *perr = &MIL_CAN_Err[MIL_CAN_ModuleIdx(base)];
+    uint32_t lec = status & CAN_STATUS_LEC_MSK;
+    mil_can_err_state_t next;
+
+    if(!perr->time_us){
+        return;
+    }
+
+    //7 means no new event since the last read
+    if((lec != CAN_STATUS_LEC_NONE) && (lec != CAN_STATUS_LEC_MASK)){
+        perr->stats.lec_count[lec]++;
+    }
+
+    CANErrCntrGet(base,&perr->stats.rx_err_cnt,&perr->stats.tx_err_cnt);
+
+    if(status & CAN_STATUS_BUS_OFF){
+
+        //still waiting out the 128 idle periods after a restart
+        if((perr->stats.state == MIL_CAN_ERR_RECOVERING) && !perr->restart_pending){
+            return;
+        }
+
+        if(perr->stats.state != MIL_CAN_ERR_BUS_OFF){
+
+            MIL_CAN_ErrEnter(perr,MIL_CAN_ERR_BUS_OFF);
+
+            if(perr->recovery_us == 0){
+                MIL_CAN_ErrRestart(base,perr);
+            }
+            else{
+                perr->restart_pending = 1;
+            }
+
+        }
+        return;
+
+    }
+
+    if(status & CAN_STATUS_EPASS){next = MIL_CAN_ERR_PASSIVE;}
+    else if(status & CAN_STATUS_EWARN){next = MIL_CAN_ERR_WARNING;}
+    else{next = MIL_CAN_ERR_ACTIVE;}
+
+    //coming back from recovery always passes through error active first
+    if(perr->stats.state == MIL_CAN_ERR_RECOVERING){
+        MIL_CAN_ErrEnter(perr,MIL_CAN_ERR_ACTIVE);
+    }
+
+    MIL_CAN_ErrEnter(perr,next);
+
+}
+
+/*
+ * Desc: starts the error handler and enables controller error interrupts
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * recovery_ms - how long to stay off the bus before restarting
+ * time_us - function returning a free running microsecond count
+ */
+void MIL_CAN_ErrInit(uint32_t base,uint32_t recovery_ms,uint32_t (*time_us)(void)){
+
+    mil_can_err_t *perr = &MIL_CAN_Err[MIL_CAN_ModuleIdx(base)];
+
+    perr->time_us = 0;
+    perr->recovery_us = recovery_ms * 1000;
+    perr->restart_pending = 0;
+
+    perr->stats.state = MIL_CAN_ERR_ACTIVE;
+    perr->stats.tx_err_cnt = 0;
+    perr->stats.rx_err_cnt = 0;
+    perr->stats.warning_count = 0;
+    perr->stats.passive_count = 0;
+    perr->stats.bus_off_count = 0;
+    perr->stats.recoveries = 0;
+    for(uint8_t i = 0;i < 8;i++){
+        perr->stats.lec_count[i] = 0;
+    }
+    for(uint8_t i = 0;i < MIL_CAN_ERR_NUM_STATES;i++){
+        perr->stats.time_in_state_us[i] = 0;
+    }
+
+    perr->entered_us = time_us();
+    perr->mark_us = perr->entered_us;
+    perr->time_us = time_us;
+
+    //error passive and bus off only raise an interrupt with this set
+    CANIntEnable(base,CAN_INT_ERROR | CAN_INT_STATUS);
+
+}
+
+/*
+ * Desc: restarts the controller once the recovery delay has passed
+ *       and polls the controller status
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_ErrService(uint32_t base){
+
+    mil_can_err_t *perr = &MIL_CAN_Err[MIL_CAN_ModuleIdx(base)];
+    uint32_t lock;
+
+    if(!perr->time_us){
+        return;
+    }
+
+    //the ISR runs the same error handler
+    lock = MIL_CAN_IfLock();
+
+    MIL_CAN_ErrClock(perr);
+    MIL_CAN_ErrUpdate(base,CANStatusGet(base,CAN_STS_CONTROL));
+
+    if(perr->restart_pending &&
+       ((perr->time_us() - perr->entered_us) >= perr->recovery_us)){
+        MIL_CAN_ErrRestart(base,perr);
+    }
+
+    MIL_CAN_IfUnlock(lock);
+
+}
+
+/*
+ * Desc: current error state
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+mil_can_err_state_t MIL_CAN_ErrState(uint32_t base){
+
+    return MIL_CAN_Err[MIL_CAN_ModuleIdx(base)].stats.state;
+
+}
+
+/*
+ * Desc: copies out the error handler counters, time_in_state_us
+ *       includes the time spent in the current state so far
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pstats - where the counters will be copied to
+ */
+void MIL_CAN_ErrStatsGet(uint32_t base,MIL_CAN_ErrStats_t *pstats){
+
+    mil_can_err_t *perr = &MIL_CAN_Err[MIL_CAN_ModuleIdx(base)];
+    uint32_t lock;
+
+    //the ISR updates the same 64 bit totals
+    lock = MIL_CAN_IfLock();
+
+    if(perr->time_us){
+        MIL_CAN_ErrClock(perr);
+    }
+    *pstats = perr->stats;
+
+    MIL_CAN_IfUnlock(lock);
+
+}
+
+/*
+ * Desc: everything the CAN interrupt does, the ISR runs it straight
+ *       away and coalescing runs it from the drain
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * bus_event - the status interrupt was already acknowledged this time
+ */
+static void MIL_CAN_Service(uint32_t base,bool bus_event){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+    mil_can_txq_t *ptxq = MIL_CAN_TxQueue[MIL_CAN_ModuleIdx(base)];
+    uint32_t cause;
+
+    //one NEWDAT read covers every attached object
+    uint32_t pending = CANStatusGet(base,CAN_STS_NEWDAT) & (prxq->obj_mask | prxq->latest_mask);
+
+    while(pending){
+
+        uint8_t obj_num = (uint8_t)(MIL_CAN_Ctz(pending) + 1);
+
+        if(prxq->latest_mask & (0x01UL << (obj_num - 1))){
+            MIL_CAN_LatestUpdate(base,obj_num);
+        }
+        else{
+            MIL_CAN_RxQueuePush(base,prxq,obj_num);
+        }
+
+        pending &= pending - 1;
+
+    }
+
+    //whatever is still pending arrived during the drain or isn't ours
+    while((cause = CANIntStatus(base,CAN_INT_STS_CAUSE)) != 0){
+
+        if(cause == CAN_INT_INTID_STATUS){
+
+            //reading the status register acknowledges the interrupt
+            MIL_CAN_ErrUpdate(base,CANStatusGet(base,CAN_STS_CONTROL));
+            bus_event = true;
+
+        }
+        else if((cause <= 32) && (prxq->obj_mask & (0x01UL << (cause - 1)))){
+
+            MIL_CAN_RxQueuePush(base,prxq,(uint8_t)cause);
+
+        }
+        else if((cause <= 32) && (prxq->latest_mask & (0x01UL << (cause - 1)))){
+
+            MIL_CAN_LatestUpdate(base,(uint8_t)cause);
+
+        }
+        else{
+
+            //not a queued object, clear it so the ISR doesn't refire forever
+            CANIntClear(base,cause);
+
+        }
+
+    }
+
+    //TXOK landed us here, keep the transmit objects busy
+    for(uint8_t c = 0;c < MIL_CAN_TX_NUM_CLASSES;c++){
+        if(ptxq[c].pool_mask){
+            MIL_CAN_TxQueueRefill(base,&ptxq[c],bus_event);
+        }
+    }
+
+}
+
+/*
+ * Desc: the body of the MIL CAN interrupt
+ *
+ * Note: acknowledges status interrupts(running the error handler),
+ *       drains every attached message object with new data into the
+ *       receive queue,
+ *       reloads free transmit objects from the transmit queue and
+ *       clears interrupts from objects MIL_CAN doesn't own
+ *
+ *       Only call this from the CAN interrupt for that module
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_ISRHandler(uint32_t base){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+    bool bus_event = false;
+    uint32_t lock;
+
+    prxq->coal_stats.isr_calls++;
+
+    //a hook sending on the other module, or a timer, must not land
+    //in the middle of this module's interface accesses
+    lock = MIL_CAN_IfLock();
+
+    //the coalescing tick pended us, drain everything in one pass
+    if(prxq->coal_drain){
+        prxq->coal_drain = false;
+    }
+    else if(prxq->coal_frames && !prxq->coal_open){
+
+        uint32_t cause = CANIntStatus(base,CAN_INT_STS_CAUSE);
+        uint32_t rx_objs = prxq->obj_mask | prxq->latest_mask;
+
+        //every received frame raises RXOK first, see if that's all it is
+        if(cause == CAN_INT_INTID_STATUS){
+
+            uint32_t status = CANStatusGet(base,CAN_STS_CONTROL);
+            uint32_t lec = status & CAN_STATUS_LEC_MSK;
+
+            MIL_CAN_ErrUpdate(base,status);
+            bus_event = true;
+
+            if(!(status & (CAN_STATUS_TXOK | CAN_STATUS_BUS_OFF)) &&
+               ((lec == CAN_STATUS_LEC_NONE) || (lec == CAN_STATUS_LEC_MSK))){
+                cause = CANIntStatus(base,CAN_INT_STS_CAUSE);
+            }
+
+        }
+
+        //a frame for us and nothing else going on, leave it for the drain
+        if((cause >= 1) && (cause <= 32) && (rx_objs & (0x01UL << (cause - 1)))){
+            MIL_CAN_CoalOpen(base);
+            MIL_CAN_IfUnlock(lock);
+            return;
+        }
+
+    }
+
+    MIL_CAN_Service(base,bus_event);
+
+    MIL_CAN_IfUnlock(lock);
+
+}
+
+/*
+ * Desc: ready made ISRs to pass into MIL_CANIntEnable
+ *       these just call MIL_CAN_ISRHandler with the right base
+ */
+void MIL_CAN0_ISR(void){
+
+    MIL_CAN_ISRHandler(CAN0_BASE);
+
+}
+
+void MIL_CAN1_ISR(void){
+
+    MIL_CAN_ISRHandler(CAN1_BASE);
+
+}
+
+/**************************MESSAGE OBJECT LOCKING************************/
+
+//CAN0 and CAN1 always take part, the rest come from MIL_CAN_IfLockAdd
+static uint32_t MIL_CAN_LockInts[MIL_CAN_LOCK_MAX_INTS] = {INT_CAN0,INT_CAN1};
+static uint8_t MIL_CAN_LockNumInts = 2;
+
+/*
+ * Desc: adds an interrupt that touches message objects to the lock
+ *
+ * Parameters:
+ * int_num - INT_xxx number from hw_ints.h
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if MIL_CAN_LOCK_MAX_INTS are already in
+ *
+ * Note: adding the same interrupt twice is fine
+ */
+mil_can_status_t MIL_CAN_IfLockAdd(uint32_t int_num){
+
+    for(uint8_t i = 0;i < MIL_CAN_LockNumInts;i++){
+        if(MIL_CAN_LockInts[i] == int_num){
+            return MIL_CAN_OK;
+        }
+    }
+
+    if(MIL_CAN_LockNumInts >= MIL_CAN_LOCK_MAX_INTS){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_LockInts[MIL_CAN_LockNumInts] = int_num;
+    MIL_CAN_LockNumInts++;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: masks every interrupt that touches message objects
+ *
+ * Returns:
+ * uint32_t - the ones this call masked, hand it to MIL_CAN_IfUnlock
+ *
+ * Note: only what was enabled gets masked and unmasked again, so locks
+ *       nest and an interrupt somebody else turned off stays off
+ */
+uint32_t MIL_CAN_IfLock(void){
+
+    uint32_t saved = 0;
+
+    for(uint8_t i = 0;i < MIL_CAN_LockNumInts;i++){
+        if(IntIsEnabled(MIL_CAN_LockInts[i])){
+            IntDisable(MIL_CAN_LockInts[i]);
+            saved |= 0x01UL << i;
+        }
+    }
+
+    return saved;
+
+}
+
+/*
+ * Desc: undoes MIL_CAN_IfLock
+ *
+ * Parameters:
+ * saved - what MIL_CAN_IfLock returned
+ */
+void MIL_CAN_IfUnlock(uint32_t saved){
+
+    for(uint8_t i = 0;i < MIL_CAN_LockNumInts;i++){
+        if(saved & (0x01UL << i)){
+            IntEnable(MIL_CAN_LockInts[i]);
+        }
+    }
+
+}
+
+/**************************RECEIVE INTERRUPT COALESCING******************/
+
+static uint32_t MIL_CAN_CoalTimer;
+static uint32_t (*MIL_CAN_CoalTime)(void);
+
+static uint32_t MIL_CAN_CoalInt(uint32_t base){
+
+    return (base == CAN1_BASE) ? INT_CAN1 : INT_CAN0;
+
+}
+
+/*
+ * Desc: starts a batch, the module stays quiet until the drain
+ */
+static void MIL_CAN_CoalOpen(uint32_t base){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+
+    prxq->coal_start_us = MIL_CAN_CoalTime();
+    prxq->coal_open = true;
+
+    //gate the module's own interrupt line, the NVIC enable belongs
+    //to MIL_CAN_IfLock
+    CANIntDisable(base,CAN_INT_MASTER);
+
+    if(MIL_CAN_CoalTimer){
+        TimerEnable(MIL_CAN_CoalTimer,TIMER_A);
+    }
+
+}
+
+static void MIL_CAN_CoalTimerISR(void){
+
+    TimerIntClear(MIL_CAN_CoalTimer,TIMER_TIMA_TIMEOUT);
+    MIL_CAN_RxCoalesceTick();
+
+}
+
+/*
+ * Desc: sets up the timer that runs deferred drains
+ *
+ * Parameters:
+ * timer_base - TIMER0_BASE to TIMER5_BASE(timer A is used), 0 if you'll
+ *              call MIL_CAN_RxCoalesceTick from your own periodic timer
+ * tick_us - tick period in microseconds
+ * time_us - function returning a free running microsecond count
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK for an unknown timer, a missing time_us
+ *                    or if the message object lock is full
+ *
+ * Note: the timer only runs while a batch is open
+ */
+mil_can_status_t MIL_CAN_RxCoalesceInit(uint32_t timer_base,uint32_t tick_us,uint32_t (*time_us)(void)){
+
+    uint32_t periph;
+    uint32_t int_num;
+
+    //batches are timed with this, nothing works without it
+    if(!time_us){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_CoalTime = time_us;
+    MIL_CAN_CoalTimer = 0;
+
+    if(!timer_base){
+        return MIL_CAN_OK;
+    }
+
+    switch(timer_base){
+        case TIMER0_BASE: periph = SYSCTL_PERIPH_TIMER0; int_num = INT_TIMER0A; break;
+        case TIMER1_BASE: periph = SYSCTL_PERIPH_TIMER1; int_num = INT_TIMER1A; break;
+        case TIMER2_BASE: periph = SYSCTL_PERIPH_TIMER2; int_num = INT_TIMER2A; break;
+        case TIMER3_BASE: periph = SYSCTL_PERIPH_TIMER3; int_num = INT_TIMER3A; break;
+        case TIMER4_BASE: periph = SYSCTL_PERIPH_TIMER4; int_num = INT_TIMER4A; break;
+        case TIMER5_BASE: periph = SYSCTL_PERIPH_TIMER5; int_num = INT_TIMER5A; break;
+        default: return MIL_CAN_NOK;
+    }
+
+    //the tick flips the modules' interrupt enables, keep it out of
+    //everybody else's critical sections
+    if(MIL_CAN_IfLockAdd(int_num) != MIL_CAN_OK){
+        return MIL_CAN_NOK;
+    }
+
+    SysCtlPeripheralEnable(periph);
+    while(!SysCtlPeripheralReady(periph));
+
+    //periodic but left stopped, opening a batch starts it
+    TimerConfigure(timer_base,TIMER_CFG_PERIODIC);
+    TimerLoadSet(timer_base,TIMER_A,(SysCtlClockGet() / 1000000) * tick_us - 1);
+    TimerIntRegister(timer_base,TIMER_A,MIL_CAN_CoalTimerISR);
+    TimerIntEnable(timer_base,TIMER_TIMA_TIMEOUT);
+
+    MIL_CAN_CoalTimer = timer_base;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: turns coalescing on or off for a module
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * max_frames - drain once this many attached objects have new data,
+ *              0 turns coalescing off
+ * max_delay_us - drain once a batch has been open this long
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if MIL_CAN_RxCoalesceInit hasn't set up
+ *                    a clock yet(coalescing stays off)
+ */
+mil_can_status_t MIL_CAN_RxCoalesce(uint32_t base,uint8_t max_frames,uint32_t max_delay_us){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+
+    //the ISR stamps every batch it opens with the clock
+    if(max_frames && !MIL_CAN_CoalTime){
+        return MIL_CAN_NOK;
+    }
+
+    //a batch that's already open still gets its drain on the next tick
+    prxq->coal_delay_us = max_delay_us;
+    prxq->coal_frames = max_frames;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: checks open batches and pends the CAN interrupt for the ones
+ *       that are due
+ *
+ * Note: MIL_CAN_RxCoalesceInit's timer does this for you, only call
+ *       it if you passed timer_base 0
+ */
+void MIL_CAN_RxCoalesceTick(void){
+
+    bool still_open = false;
+    uint32_t lock = MIL_CAN_IfLock();
+
+    for(uint8_t m = 0;m < MIL_CAN_MODULES;m++){
+
+        mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[m];
+        MIL_CAN_RxCoalesceStats_t *pstats = &prxq->coal_stats;
+        uint32_t base = m ? CAN1_BASE : CAN0_BASE;
+        uint32_t waiting;
+        uint32_t waited;
+
+        if(!prxq->coal_open){
+            continue;
+        }
+
+        waiting = MIL_CAN_PopCount(CANStatusGet(base,CAN_STS_NEWDAT) & (prxq->obj_mask | prxq->latest_mask));
+        waited = MIL_CAN_CoalTime() - prxq->coal_start_us;
+
+        if(waiting >= prxq->coal_frames){
+            pstats->full_drains++;
+        }
+        else if(waited >= prxq->coal_delay_us){
+            pstats->deadline_drains++;
+        }
+        else{
+            still_open = true;
+            continue;
+        }
+
+        pstats->drains++;
+        pstats->frames += waiting;
+        pstats->total_latency_us += waited;
+        if(waited > pstats->max_latency_us){
+            pstats->max_latency_us = waited;
+        }
+
+        //the drain itself runs in the CAN ISR so it never lands in the
+        //middle of a send, the ISR listens again right after
+        prxq->coal_open = false;
+        prxq->coal_drain = true;
+        CANIntEnable(base,CAN_INT_MASTER);
+        IntPendSet(MIL_CAN_CoalInt(base));
+
+    }
+
+    if(!still_open && MIL_CAN_CoalTimer){
+        TimerDisable(MIL_CAN_CoalTimer,TIMER_A);
+    }
+
+    MIL_CAN_IfUnlock(lock);
+
+}
+
+/*
+ * Desc: copies out the coalescing counters
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pstats - where the counters will be copied to
+ */
+void MIL_CAN_RxCoalesceStatsGet(uint32_t base,MIL_CAN_RxCoalesceStats_t *pstats){
+
+    *pstats = MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)].coal_stats;
+
+}
+
+/**************************MAILBOX REGISTRY******************************/
+
+/*
+ * Desc: empties a registry
+ *
+ * Parameters:
+ * pregistry - a pointer to your registry
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_RegistryInit(MIL_CAN_MailRegistry_t *pregistry,uint32_t base){
+
+    pregistry->base = base;
+    pregistry->obj_mask = 0;
+
+    for(uint8_t i = 0;i < 32;i++){
+        pregistry->pmailbox[i] = 0;
+        pregistry->handler[i] = 0;
+    }
+
+}
+
+/*
+ * Desc: initializes the mailbox(like MIL_InitMailBox) and registers
+ *       its handler
+ *
+ * Parameters:
+ * pregistry - a pointer to your registry
+ * pmailbox - a pointer to your configured mailbox
+ * handler - function to call when the mailbox has new data
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the mailbox is on another base,
+ *                    has a bad obj_num or the object is already registered
+ */
+mil_can_status_t MIL_CAN_RegistryAdd(MIL_CAN_MailRegistry_t *pregistry,
+                                     MIL_CAN_MailBox_t *pmailbox,
+                                     mil_can_mail_handler_t handler){
+
+    uint8_t slot = pmailbox->obj_num - 1;
+
+    if((pmailbox->base != pregistry->base) ||
+       (pmailbox->obj_num < 1) || (pmailbox->obj_num > 32) ||
+       (pregistry->obj_mask & (0x01UL << slot))){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_InitMailBox(pmailbox);
+
+    pregistry->pmailbox[slot] = pmailbox;
+    pregistry->handler[slot] = handler;
+    pregistry->obj_mask |= 0x01UL << slot;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: reads NEWDAT once, loads every registered mailbox that has
+ *       new data into its buffer and calls its handler
+ *
+ * Note: mailboxes are handled from lowest to highest object number
+ *
+ * Parameters:
+ * pregistry - a pointer to your registry
+ *
+ * Returns:
+ * number of mailboxes that were handled
+ */
+uint8_t MIL_CAN_RegistryDispatch(MIL_CAN_MailRegistry_t *pregistry){
+
+    uint32_t pending = CANStatusGet(pregistry->base,CAN_STS_NEWDAT) & pregistry->obj_mask;
+    uint8_t handled = 0;
+
+    while(pending){
+
+        uint32_t slot = MIL_CAN_Ctz(pending);
+        MIL_CAN_MailBox_t *pmailbox = pregistry->pmailbox[slot];
+
+        //receive message and clear flag
+        uint32_t lock = MIL_CAN_IfLock();
+        CANMessageGet(pregistry->base,slot + 1,&pmailbox->msg_obj,1);
+        MIL_CAN_IfUnlock(lock);
+
+        if(pregistry->handler[slot]){
+            pregistry->handler[slot](pmailbox);
+        }
+
+        handled++;
+        pending &= pending - 1;
+
+    }
+
+    return handled;
+
+}
+
+/**************************PACKED MAILBOX REGISTRY***********************/
+
+/*
+ * Desc: builds the TI message object for a packed box on the caller's stack
+ */
+static void MIL_CAN_PackedMsgObj(const MIL_CAN_PackedBox_t *pbox,uint8_t *pdata,tCANMsgObject *pmsg_obj){
+
+    pmsg_obj->ui32MsgID = pbox->canid;
+    pmsg_obj->ui32MsgIDMask = pbox->filt_mask;
+    pmsg_obj->ui32MsgLen = pbox->msg_len;
+    pmsg_obj->pui8MsgData = pdata;
+
+    if(pbox->flags & MIL_CAN_PACKED_RX_INT){
+        pmsg_obj->ui32Flags = MSG_OBJ_RX_INT_ENABLE | MSG_OBJ_USE_ID_FILTER;
+    }
+    else{
+        pmsg_obj->ui32Flags = MSG_OBJ_USE_ID_FILTER;
+    }
+
+}
+
+/*
+ * Desc: loads every box of a packed registry into the controller
+ *
+ * Parameters:
+ * pregistry - a pointer to your const registry
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if a box has a bad obj_num, length
+ *                    or slot, or two boxes use the same object
+ *                    (nothing is loaded in that case)
+ */
+mil_can_status_t MIL_CAN_PackedInit(const MIL_CAN_PackedRegistry_t *pregistry){
+
+    uint32_t used = 0;
+    tCANMsgObject msg_obj;
+
+    //check the whole table before touching the hardware
+    for(uint8_t i = 0;i < pregistry->num_boxes;i++){
+
+        const MIL_CAN_PackedBox_t *pbox = &pregistry->pboxes[i];
+
+        if((pbox->obj_num < 1) || (pbox->obj_num > 32) ||
+           (pbox->msg_len < 1) || (pbox->msg_len > 8) ||
+           (pbox->slot >= pregistry->num_slots) ||
+           (used & (0x01UL << (pbox->obj_num - 1)))){
+            return MIL_CAN_NOK;
+        }
+
+        used |= 0x01UL << (pbox->obj_num - 1);
+
+    }
+
+    for(uint8_t i = 0;i < pregistry->num_boxes;i++){
+
+        const MIL_CAN_PackedBox_t *pbox = &pregistry->pboxes[i];
+
+        MIL_CAN_PackedMsgObj(pbox,pregistry->pslots[pbox->slot],&msg_obj);
+
+        uint32_t lock = MIL_CAN_IfLock();
+        CANMessageSet(pregistry->base,pbox->obj_num,&msg_obj,MSG_OBJ_TYPE_RX);
+        MIL_CAN_IfUnlock(lock);
+
+    }
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: reads NEWDAT once, copies every box that has new data into its
+ *       slot and calls the handler
+ *
+ * Note: boxes are handled in table order
+ *
+ * Parameters:
+ * pregistry - a pointer to your const registry
+ *
+ * Returns:
+ * number of boxes that were handled
+ */
+uint8_t MIL_CAN_PackedDispatch(const MIL_CAN_PackedRegistry_t *pregistry){
+
+    uint32_t pending = CANStatusGet(pregistry->base,CAN_STS_NEWDAT);
+    uint8_t handled = 0;
+    tCANMsgObject msg_obj;
+
+    for(uint8_t i = 0;(i < pregistry->num_boxes) && pending;i++){
+
+        const MIL_CAN_PackedBox_t *pbox = &pregistry->pboxes[i];
+        uint32_t bit = 0x01UL << (pbox->obj_num - 1);
+        uint8_t *pdata;
+
+        if(!(pending & bit)){
+            continue;
+        }
+        pending &= ~bit;
+
+        pdata = pregistry->pslots[pbox->slot];
+
+        //receive message and clear flag
+        msg_obj.pui8MsgData = pdata;
+        uint32_t lock = MIL_CAN_IfLock();
+        CANMessageGet(pregistry->base,pbox->obj_num,&msg_obj,1);
+        MIL_CAN_IfUnlock(lock);
+
+        if(pregistry->handler){
+            pregistry->handler(pbox,msg_obj.ui32MsgID,pdata,(uint8_t)msg_obj.ui32MsgLen);
+        }
+
+        handled++;
+
+    }
+
+    return handled;
+
+}
+
+/**************************ID ROUTING TABLE******************************/
+
+/*
+ * Desc: calls the handler for the frame's ID
+ *
+ * Parameters:
+ * table - your const routing table
+ * pframe - a received frame
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if a handler was called
+ *                    MIL_CAN_NOK if no handler exists for that ID
+ */
+mil_can_status_t MIL_CAN_Route(const mil_can_frame_handler_t *table,const MIL_CAN_Frame_t *pframe){
+
+    mil_can_frame_handler_t handler;
+
+    if(pframe->canid >= MIL_CAN_ROUTE_ID_SPACE){
+        return MIL_CAN_NOK;
+    }
+
+    handler = table[pframe->canid];
+    if(!handler){
+        return MIL_CAN_NOK;
+    }
+
+    handler(pframe);
+    return MIL_CAN_OK;
+
+}
+
+/**************************HARDWARE FIFO MAILBOXES***********************/
+
+/*
+ * Desc: bitmask of the message objects a FIFO mailbox spans
+ */
+static uint32_t MIL_CAN_FifoMask(const MIL_CAN_FifoBox_t *pfifo){
+
+    uint32_t mask = 0;
+
+    for(uint8_t i = 0;i < pfifo->depth;i++){
+        mask |= 0x01UL << (pfifo->first_obj - 1 + i);
+    }
+
+    return mask;
+
+}
+
+/*
+ * Desc: configures the chained message objects for a FIFO mailbox
+ *
+ * Parameters:
+ * pfifo - a pointer to your FIFO mailbox
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the FIFO runs past object 32
+ *                    or depth is less than 2
+ */
+mil_can_status_t MIL_InitFifoBox(MIL_CAN_FifoBox_t *pfifo){
+
+    tCANMsgObject msg;
+    uint8_t dummy[8];
+    uint32_t lock;
+
+    if((pfifo->first_obj < 1) || (pfifo->depth < 2) ||
+       ((pfifo->first_obj + pfifo->depth - 1) > 32)){
+        return MIL_CAN_NOK;
+    }
+
+    msg.ui32MsgID = pfifo->canid;
+    msg.ui32MsgIDMask = pfifo->filt_mask;
+    msg.ui32MsgLen = pfifo->msg_len;
+    msg.pui8MsgData = dummy;
+
+    pfifo->lost = 0;
+
+    lock = MIL_CAN_IfLock();
+
+    for(uint8_t i = 0;i < pfifo->depth;i++){
+
+        msg.ui32Flags = MSG_OBJ_USE_ID_FILTER;
+
+        if(pfifo->rx_flag_int){
+            msg.ui32Flags |= MSG_OBJ_RX_INT_ENABLE;
+        }
+
+        //every object but the last one chains to the next
+        if((i + 1) < pfifo->depth){
+            msg.ui32Flags |= MSG_OBJ_FIFO;
+        }
+
+        CANMessageSet(pfifo->base,pfifo->first_obj + i,&msg,MSG_OBJ_TYPE_RX);
+
+    }
+
+    MIL_CAN_IfUnlock(lock);
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: reads every frame waiting in the FIFO, oldest first
+ *       this will not wait for new frames
+ *
+ * Note: oldest first only holds when max_frames covers everything
+ *       waiting(pass depth). Frames left behind stay in the higher
+ *       objects, the controller puts the next frame in the lowest
+ *       object that was freed, and the next drain returns that newer
+ *       frame ahead of the older ones left behind
+ *
+ * Parameters:
+ * pfifo - a pointer to your initialized FIFO mailbox
+ * pframes - array the frames are copied to
+ * max_frames - size of that array(depth gets you everything)
+ *
+ * Returns:
+ * the number of frames copied to pframes
+ */
+uint8_t MIL_CAN_FifoDrain(MIL_CAN_FifoBox_t *pfifo,MIL_CAN_Frame_t *pframes,uint8_t max_frames){
+
+    uint32_t pending = CANStatusGet(pfifo->base,CAN_STS_NEWDAT) & MIL_CAN_FifoMask(pfifo);
+    uint8_t count = 0;
+    tCANMsgObject msg;
+
+    //the controller fills from the lowest object up, so that's arrival order
+    while(pending && (count < max_frames)){
+
+        uint8_t obj_num = (uint8_t)(MIL_CAN_Ctz(pending) + 1);
+        MIL_CAN_Frame_t *pframe = &pframes[count];
+
+        msg.pui8MsgData = pframe->data;
+        uint32_t lock = MIL_CAN_IfLock();
+        CANMessageGet(pfifo->base,obj_num,&msg,1);
+        MIL_CAN_IfUnlock(lock);
+
+        pframe->canid = msg.ui32MsgID;
+        pframe->len = (uint8_t)msg.ui32MsgLen;
+        pframe->obj_num = obj_num;
+        pframe->flags = 0;
+
+        if(msg.ui32Flags & MSG_OBJ_DATA_LOST){
+            pframe->flags |= MIL_CAN_FRAME_LOST;
+            pfifo->lost++;
+        }
+
+        count++;
+        pending &= pending - 1;
+
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: initializes a FIFO mailbox and routes everything it receives
+ *       into the receive queue
+ *
+ * Note: the rx_flag_int parameter is forced to 1
+ *
+ * Parameters:
+ * pfifo - a pointer to your configured FIFO mailbox
+ *
+ * Returns:
+ * mil_can_status_t - same as MIL_InitFifoBox
+ */
+mil_can_status_t MIL_CAN_RxQueueAttachFifo(MIL_CAN_FifoBox_t *pfifo){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(pfifo->base)];
+
+    pfifo->rx_flag_int = 1;
+    if(MIL_InitFifoBox(pfifo) == MIL_CAN_NOK){
+        return MIL_CAN_NOK;
+    }
+
+    //the ISR already drains from the lowest object up
+    prxq->obj_mask |= MIL_CAN_FifoMask(pfifo);
+
+    return MIL_CAN_OK;
+
+}
+
+/**************************ZERO COPY RECEPTION***************************/
+
+#if (MIL_CAN_SLOT_POOL_SIZE < 1) || (MIL_CAN_SLOT_POOL_SIZE > 32)
+#error "MIL_CAN_SLOT_POOL_SIZE must be 1 to 32"
+#endif
+
+static MIL_CAN_Frame_t MIL_CAN_SlotPool[MIL_CAN_SLOT_POOL_SIZE];
+
+//bit n set = slot n is free
+static uint32_t MIL_CAN_SlotFreeMask = 0xFFFFFFFFUL >> (32 - MIL_CAN_SLOT_POOL_SIZE);
+
+/*
+ * Desc: if the mailbox has new data, borrows a slot from the pool and
+ *       reads the frame straight into it
+ *
+ * Note: if the pool is empty the frame stays in the message object
+ *       so you can try again after releasing a slot
+ *
+ * Parameters:
+ * pmailbox - a pointer to your initialized mailbox(buffer isn't used)
+ *
+ * Returns:
+ * pointer to the filled slot or 0 if there was no data or no free slot
+ */
+MIL_CAN_Frame_t *MIL_CAN_GetMailSlot(MIL_CAN_MailBox_t *pmailbox){
+
+    MIL_CAN_Frame_t *pframe;
+    uint32_t slot;
+    tCANMsgObject msg;
+
+    if(!MIL_CAN_SlotFreeMask){
+        return 0;
+    }
+
+    if(!(CANStatusGet(pmailbox->base,CAN_STS_NEWDAT) & (0x01UL << (pmailbox->obj_num - 1)))){
+        return 0;
+    }
+
+    slot = MIL_CAN_Ctz(MIL_CAN_SlotFreeMask);
+    MIL_CAN_SlotFreeMask &= ~(0x01UL << slot);
+    pframe = &MIL_CAN_SlotPool[slot];
+
+    //hardware read lands directly in the slot
+    msg.pui8MsgData = pframe->data;
+    uint32_t lock = MIL_CAN_IfLock();
+    CANMessageGet(pmailbox->base,pmailbox->obj_num,&msg,1);
+    MIL_CAN_IfUnlock(lock);
+
+    pframe->canid = msg.ui32MsgID;
+    pframe->len = (uint8_t)msg.ui32MsgLen;
+    pframe->obj_num = pmailbox->obj_num;
+    pframe->flags = (msg.ui32Flags & MSG_OBJ_DATA_LOST) ? MIL_CAN_FRAME_LOST : 0;
+
+    return pframe;
+
+}
+
+/*
+ * Desc: hands a slot from MIL_CAN_GetMailSlot back to the pool
+ *
+ * Parameters:
+ * pframe - the slot you were lent
+ */
+void MIL_CAN_SlotRelease(MIL_CAN_Frame_t *pframe){
+
+    uint32_t slot = (uint32_t)(pframe - MIL_CAN_SlotPool);
+
+    //ignore anything that didn't come from the pool
+    if(slot < MIL_CAN_SLOT_POOL_SIZE){
+        MIL_CAN_SlotFreeMask |= 0x01UL << slot;
+    }
+
+}
+
+/*
+ * Desc: number of slots left in the pool
+ */
+uint8_t MIL_CAN_SlotsFree(void){
+
+    uint32_t free_mask = MIL_CAN_SlotFreeMask;
+    uint8_t count = 0;
+
+    while(free_mask){
+        count++;
+        free_mask &= free_mask - 1;
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: lends you the oldest frame in the receive queue without copying it
+ *
+ * Note: the frame stays in the queue until MIL_CAN_RxQueueRelease
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ *
+ * Returns:
+ * pointer to the oldest frame or 0 if the queue is empty
+ */
+MIL_CAN_Frame_t *MIL_CAN_RxQueuePeek(uint32_t base){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+    uint32_t tail = prxq->tail;
+
+    if(tail == prxq->head){
+        return 0;
+    }
+
+    MIL_CAN_BARRIER();
+    return &prxq->frames[tail & (MIL_CAN_RXQ_SIZE - 1)];
+
+}
+
+/*
+ * Desc: removes the frame lent by MIL_CAN_RxQueuePeek from the queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_RxQueueRelease(uint32_t base){
+
+    mil_can_rxq_t *prxq = &MIL_CAN_RxQueue[MIL_CAN_ModuleIdx(base)];
+    uint32_t tail = prxq->tail;
+
+    if(tail == prxq->head){
+        return;
+    }
+
+    //done with the slot before the ISR can reuse it
+    MIL_CAN_BARRIER();
+    prxq->tail = tail + 1;
+
+}
+
+/**************************LATEST VALUE MAILBOXES************************/
+
+static MIL_CAN_LatestBox_t *MIL_CAN_LatestBoxes[MIL_CAN_MODULES][32];
+
+/*
+ * Desc: ISR side of a latest value box, the sequence is odd for
+ *       the whole time the data is being rewritten
+ */
+static void MIL_CAN_LatestUpdate(uint32_t base,uint8_t obj_num){
+
+    MIL_CAN_LatestBox_t *pbox = MIL_CAN_LatestBoxes[MIL_CAN_ModuleIdx(base)][obj_num - 1];
+
+    pbox->seq++;
+    MIL_CAN_BARRIER();
+
+    CANMessageGet(base,obj_num,&pbox->msg_obj,1);
+    pbox->len = (uint8_t)pbox->msg_obj.ui32MsgLen;
+    pbox->rx_id = pbox->msg_obj.ui32MsgID;
+    pbox->updates++;
+
+    //the controller overwrote a frame before we got here, count it too
+    //so the reader's skipped count includes it
+    if(pbox->msg_obj.ui32Flags & MSG_OBJ_DATA_LOST){
+        pbox->updates++;
+    }
+
+    MIL_CAN_BARRIER();
+    pbox->seq++;
+
+#ifdef MIL_CAN_STATS
+    {
+        MIL_CAN_Frame_t frame;
+
+        frame.canid = pbox->rx_id;
+        frame.len = pbox->len;
+        frame.obj_num = obj_num;
+        frame.flags = 0;
+        MIL_CAN_StatsRecord(base,&frame);
+    }
+#endif
+
+}
+
+/*
+ * Desc: sets up a latest value box and hooks it into the CAN ISR
+ *
+ * Parameters:
+ * pbox - a pointer to your latest value box
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if obj_num isn't 1 to 32
+ */
+mil_can_status_t MIL_InitLatestBox(MIL_CAN_LatestBox_t *pbox){
+
+    uint8_t idx = MIL_CAN_ModuleIdx(pbox->base);
+
+    if((pbox->obj_num < 1) || (pbox->obj_num > 32)){
+        return MIL_CAN_NOK;
+    }
+
+    pbox->seq = 0;
+    pbox->updates = 0;
+    pbox->read_updates = 0;
+    pbox->len = 0;
+    pbox->rx_id = 0;
+
+    pbox->msg_obj.ui32MsgID = pbox->canid;
+    pbox->msg_obj.ui32MsgIDMask = pbox->filt_mask;
+    pbox->msg_obj.ui32Flags = MSG_OBJ_RX_INT_ENABLE | MSG_OBJ_USE_ID_FILTER;
+    pbox->msg_obj.ui32MsgLen = pbox->msg_len;
+    pbox->msg_obj.pui8MsgData = pbox->data;
+
+    MIL_CAN_LatestBoxes[idx][pbox->obj_num - 1] = pbox;
+    MIL_CAN_BARRIER();
+    MIL_CAN_RxQueue[idx].latest_mask |= 0x01UL << (pbox->obj_num - 1);
+
+    uint32_t lock = MIL_CAN_IfLock();
+    CANMessageSet(pbox->base,pbox->obj_num,&pbox->msg_obj,MSG_OBJ_TYPE_RX);
+    MIL_CAN_IfUnlock(lock);
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: copies out the newest frame without ever masking interrupts
+ *
+ * Parameters:
+ * pbox - a pointer to your latest value box
+ * pframe - where the newest frame is copied to(obj_num is filled in,
+ *          flags gets MIL_CAN_FRAME_LOST if updates were skipped)
+ * pskipped - how many updates came and went since your last read(can be 0)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if the frame is new since your last read
+ *                    MIL_CAN_NOK if nothing changed(pframe still gets the
+ *                    newest value, which may be nothing if no frame came yet)
+ */
+mil_can_status_t MIL_CAN_LatestRead(MIL_CAN_LatestBox_t *pbox,MIL_CAN_Frame_t *pframe,uint32_t *pskipped){
+
+    uint32_t seq;
+    uint32_t updates;
+    uint32_t skipped;
+
+    /*
+     * the ISR can only land between our reads, never the other way
+     * around, so if the sequence didn't move the copy is whole and
+     * at worst this goes around once per frame that interrupted it
+     */
+    do{
+
+        seq = pbox->seq;
+        MIL_CAN_BARRIER();
+
+        pframe->canid = pbox->rx_id;
+        pframe->len = pbox->len;
+        for(uint8_t i = 0;i < 8;i++){
+            pframe->data[i] = pbox->data[i];
+        }
+        updates = pbox->updates;
+
+        MIL_CAN_BARRIER();
+
+    }while((seq & 1) || (seq != pbox->seq));
+
+    pframe->obj_num = pbox->obj_num;
+    pframe->flags = 0;
+
+    if(updates == pbox->read_updates){
+        if(pskipped){
+            *pskipped = 0;
+        }
+        return MIL_CAN_NOK;
+    }
+
+    skipped = updates - pbox->read_updates - 1;
+    pbox->read_updates = updates;
+
+    if(skipped){
+        pframe->flags = MIL_CAN_FRAME_LOST;
+    }
+
+    if(pskipped){
+        *pskipped = skipped;
+    }
+
+    return MIL_CAN_OK;
+
+}
@@ -1,212 +1,1567 @@
-/*
- * Name: MIL_CAN.c
- * Author: Marquez Jones0
- * Date Modified: 11/2/2019
- * Desc: A set of wrapper functions I designed
- *       to standardized CAN use in the Lab
- *       this primarily is to reduce the number
- *       of bugs caused by the CAN bus
- *
- * Notes: CAN devices should be run at 200k bps
- *        and PCBs on the network should have on
- *        board termination resistors
- * BAUD UPDATE: CAN INIT NOW HAS CONFIGURABLE BAUD RATE
- */
-
-#include "driverlib/can.h"
-
-#ifndef MIL_CAN_H_
-#define MIL_CAN_H_
-
-/*
- *Desc: Port selection will come from this enum
- */
-typedef enum {
-    MIL_CAN_PORT_A,
-    MIL_CAN_PORT_B,
-	MIL_CAN_PORT_C,
-	MIL_CAN_PORT_D,
-    MIL_CAN_PORT_E,
-    MIL_CAN_PORT_F
-}mil_can_port_t;
-
-/*
- *Desc: status flags
- */
-typedef enum {
-   MIL_CAN_NOK, //operation failed
-   MIL_CAN_OK   //operation succeeded
-}mil_can_status_t;
-
-/*
- * Desc: Contains mailbox attributes
- *       a mailbox is simply where you
- *       will receive data from the CAN bus
- *
- * WHAT YOU NEED TO UNDERSTAND ABOUT CAN:
- * In effect every ECE is sharing the same
- * communication line, in this every ECE can
- * "hear" all messages. With this, your device
- * may not care about every single message on the
- * bus. Given this, you can choose to filter for
- * certain message IDs.
- *
- * NOTE:
- * This is an alternate struct to use for
- * configuring CAN message objects
- *
- * This struct is actually slightly more
- * complex than the TI one, but I believe is
- * more organized. I also believe it'll make
- * function use more streamlined. You can choose
- * either method ,but this is what I created to
- * interface with other reception functions I made
- *
- * This just encompasses more relevant CAN paramters
- * like the object number
- *
- * PARAMETERS NOTE:
- * FOR USE IN MIL_CAN FUNCTIONS, COMPLETELY
- * IGNORE THE msg_obj PARAMETER. IT'S CONFIGURED
- * FOR YOU IN OTHER MIL_CAN FUNCTIONS
- *
- * PARAMETERS:
- * canid - the target ID you wish to filter for
- * filt_mask - which bits matter in the canid
- * base - TIVA CANx_BASE from tivaware
- * msg_len - how long the expected CAN data is
- * obj_num - each unique mailbox needs a unique number
- * rx_flag - only set this variable if you intend on setting up
- *               CAN interrupts otherwise make it 0
- * buffer  - a pointer to your out data (MUST BE SET)
- *
- * OBJ_NUM NOTE: CAN OBJECTS ARE ENUMERATED 1 TO 32 NOT 0 TO 31
- *
- */
-typedef struct{
-
-  uint32_t canid;          //ALL IDs should be 8 bits long
-  uint32_t filt_mask;      //bit mask
-  uint32_t base;           //TI CANx_BASE value
-  uint8_t  msg_len;         //values 1 to 8
-  uint8_t  obj_num;         //values 1 to 32
-  uint8_t  rx_flag_int;         //value 0 or 1
-  uint8_t *buffer;           //pointer to your out array
-  tCANMsgObject msg_obj;    //used to interface with other TI functions(you do not configure this)
-
-} MIL_CAN_MailBox_t;
-
-/*
- * Desc: enables CAN0 which can be enabled on
- *       Ports B,E, or F
- *
- * Notes: Does not enable interrupts
- *        or port clocks
- *        PORT and Interrupts
- *        must be enabled outside funciton
- *
- * Hardware Notes:
- * CAN0:
- * PF0 - CANRX  PB4 - CANRX  PE4 - CANRX
- * PF3 - CANTX  PB5 - CANTX  PE5 - CANTX
- * CAN1:
- * PA0 - CANRX
- * PA1 - CANTX
- *
- * Inputs: port from mil_port enum
- * Assumes: Port clocks are enabled
- */
-void MIL_InitCAN(mil_can_port_t port,uint32_t base,uint32_t bps);
-
-/*
- * Desc: Enables interrupts on CAN0
- *
- * Notes: The Tiva CAN system has two
- *        separate interrupt sources.
- *        Either a controller error has
- *        occured(Tiva side) or there's
- *        a status change which can result
- *        from message transfer or a system
- *        bus error.
- *
- *        Further diagnostics in required in
- *        the external program
- *
- * Inputs: A pointer to your custom ISR
- * Assumes: Nothing
- */
-void MIL_CANIntEnable(void (*func_ptr)(void),uint32_t base);
-
-
-/*
- * Desc: Enables the Port associated with the CAN system
- *
- * Note: For sake of your program making sense,
- *       only call this function if your CAN shares the
- *       port with no other GPIOs or peripherals
- *
- *       This just called the GPIO clock enable for
- *       the port
- */
-void MIL_CANPortClkEnable(mil_can_port_t port);
-
-
-/*
- * Desc: Easy to use function to transmit a message to the CAN bus
- * 	     This function declares a temporary Can message object and uses
- *	     object 0 to transmit the message
- * 
- * Inputs: 
- * canid - ID of your CAN node
- * pMsg  - pointer to your message 
- * MsgLen - the number of bytes in your message(up to 8 bytes)
- * base - which CAN module you want to use(CAN1_BASE or CAN0_BASE from tivaWare)
- */
-void MIL_CANSimpleTX(uint32_t canid,uint8_t *pMsg,uint8_t MsgLen, uint32_t base);
-
-
-/*
- * Desc: after configureing your mailbox struct
- *       pass it into this function in order to
- *       intialize reception
- *
- * Parameters:
- * pmailbox - a pointer to your mailbox
- */
-void MIL_InitMailBox(MIL_CAN_MailBox_t *pmailbox);
-
-/*
- * Desc: if there is mail to be received
- *       this function will return that data
- *       to your buffer(pdata) this function
- *       will check if there is data but will
- *       not wait for new data
- *
- *       If there is data, it will return MIL_CAN_OK
- *       otherwise it will return MIL_CAN_NOK
- *
- * Parameters:
- * pmailbox - a pointer to your mailbox object struct
- * pdata - a pointer to your data buffer(an array)
- *
- * Returns:
- * mil_can_status_t - MIL_CAN_OK if there was new data
- *                    MIL_CAN_NOK if there is no data
- */
-mil_can_status_t MIL_CAN_GetMail(MIL_CAN_MailBox_t *pmailbox);
-
-/*
- * Desc: Will return MIL_CAN_OK for new data
- *       or MIL_CAN_NOK if there is no data
- *
- * Paramters:
- * pmailbox - a pointer to your initialized mailbox
- *
- * Returns:
- * a mil_can_status_t depending on whether or not there's data
- *
- * NOTE - DATA WILL BE RETURNED TO YOUR OUT BUFFER
- */
-mil_can_status_t MIL_CAN_CheckMail(MIL_CAN_MailBox_t *pmailbox);
-
-#endif /* MIL_CAN_H_ */
+/*
+ * Name: MIL_CAN.c
+ * Author: Marquez Jones0
+ * Date Modified: 11/2/2019
+ * Desc: A set of wrapper functions I designed
+ *       to standardized CAN use in the Lab
+ *       this primarily is to reduce the number
+ *       of bugs caused by the CAN bus
+ *
+ * Notes: CAN devices should be run at 200k bps
+ *        and PCBs on the network should have on
+ *        board termination resistors
+ * BAUD UPDATE: CAN INIT NOW HAS CONFIGURABLE BAUD RATE
+ */
+
+#include "driverlib/can.h"
+
+#ifndef MIL_CAN_H_
+#define MIL_CAN_H_
+
+/*
+ *Desc: Port selection will come from this enum
+ */
+typedef enum {
+    MIL_CAN_PORT_A,
+    MIL_CAN_PORT_B,
+	MIL_CAN_PORT_C,
+	MIL_CAN_PORT_D,
+    MIL_CAN_PORT_E,
+    MIL_CAN_PORT_F
+}mil_can_port_t;
+
+/*
+ *Desc: status flags
+ */
+typedef enum {
+   MIL_CAN_NOK, //operation failed
+   MIL_CAN_OK   //operation succeeded
+}mil_can_status_t;
+
+/*
+ * Desc: Contains mailbox attributes
+ *       a mailbox is simply where you
+ *       will receive data from the CAN bus
+ *
+ * WHAT YOU NEED TO UNDERSTAND ABOUT CAN:
+ * In effect every ECE is sharing the same
+ * communication line, in this every ECE can
+ * "hear" all messages. With this, your device
+ * may not care about every single message on the
+ * bus. Given this, you can choose to filter for
+ * certain message IDs.
+ *
+ * NOTE:
+ * This is an alternate struct to use for
+ * configuring CAN message objects
+ *
+ * This struct is actually slightly more
+ * complex than the TI one, but I believe is
+ * more organized. I also believe it'll make
+ * function use more streamlined. You can choose
+ * either method ,but this is what I created to
+ * interface with other reception functions I made
+ *
+ * This just encompasses more relevant CAN paramters
+ * like the object number
+ *
+ * PARAMETERS NOTE:
+ * FOR USE IN MIL_CAN FUNCTIONS, COMPLETELY
+ * IGNORE THE msg_obj PARAMETER. IT'S CONFIGURED
+ * FOR YOU IN OTHER MIL_CAN FUNCTIONS
+ *
+ * PARAMETERS:
+ * canid - the target ID you wish to filter for
+ * filt_mask - which bits matter in the canid
+ * base - TIVA CANx_BASE from tivaware
+ * msg_len - how long the expected CAN data is
+ * obj_num - each unique mailbox needs a unique number
+ * rx_flag - only set this variable if you intend on setting up
+ *               CAN interrupts otherwise make it 0
+ * buffer  - a pointer to your out data (MUST BE SET)
+ *
+ * OBJ_NUM NOTE: CAN OBJECTS ARE ENUMERATED 1 TO 32 NOT 0 TO 31
+ *
+ */
+typedef struct{
+
+  uint32_t canid;          //ALL IDs should be 8 bits long
+  uint32_t filt_mask;      //bit mask
+  uint32_t base;           //TI CANx_BASE value
+  uint8_t  msg_len;         //values 1 to 8
+  uint8_t  obj_num;         //values 1 to 32
+  uint8_t  rx_flag_int;         //value 0 or 1
+  uint8_t *buffer;           //pointer to your out array
+  tCANMsgObject msg_obj;    //used to interface with other TI functions(you do not configure this)
+
+} MIL_CAN_MailBox_t;
+
+/*
+ * Desc: enables CAN0 which can be enabled on
+ *       Ports B,E, or F
+ *
+ * Notes: Does not enable interrupts
+ *        or port clocks
+ *        PORT and Interrupts
+ *        must be enabled outside funciton
+ *
+ * Hardware Notes:
+ * CAN0:
+ * PF0 - CANRX  PB4 - CANRX  PE4 - CANRX
+ * PF3 - CANTX  PB5 - CANTX  PE5 - CANTX
+ * CAN1:
+ * PA0 - CANRX
+ * PA1 - CANTX
+ *
+ * Inputs: port from mil_port enum
+ * Assumes: Port clocks are enabled
+ */
+void MIL_InitCAN(mil_can_port_t port,uint32_t base,uint32_t bps);
+
+/*
+ * Desc: Enables interrupts on CAN0
+ *
+ * Notes: The Tiva CAN system has two
+ *        separate interrupt sources.
+ *        Either a controller error has
+ *        occured(Tiva side) or there's
+ *        a status change which can result
+ *        from message transfer or a system
+ *        bus error.
+ *
+ *        Further diagnostics in required in
+ *        the external program
+ *
+ * Inputs: A pointer to your custom ISR
+ * Assumes: Nothing
+ */
+void MIL_CANIntEnable(void (*func_ptr)(void),uint32_t base);
+
+
+/*
+ * Desc: Enables the Port associated with the CAN system
+ *
+ * Note: For sake of your program making sense,
+ *       only call this function if your CAN shares the
+ *       port with no other GPIOs or peripherals
+ *
+ *       This just called the GPIO clock enable for
+ *       the port
+ */
+void MIL_CANPortClkEnable(mil_can_port_t port);
+
+
+/*
+ * Desc: Easy to use function to transmit a message to the CAN bus
+ * 	     This function declares a temporary Can message object and uses
+ *	     object 0 to transmit the message
+ *
+ *	     If MIL_CAN_TxQueueInit was called for this base, the message
+ *	     goes through the transmit queue instead
+ * 
+ * Inputs: 
+ * canid - ID of your CAN node
+ * pMsg  - pointer to your message 
+ * MsgLen - the number of bytes in your message(up to 8 bytes)
+ * base - which CAN module you want to use(CAN1_BASE or CAN0_BASE from tivaWare)
+ */
+void MIL_CANSimpleTX(uint32_t canid,uint8_t *pMsg,uint8_t MsgLen, uint32_t base);
+
+
+/*
+ * Desc: after configureing your mailbox struct
+ *       pass it into this function in order to
+ *       intialize reception
+ *
+ * Parameters:
+ * pmailbox - a pointer to your mailbox
+ */
+void MIL_InitMailBox(MIL_CAN_MailBox_t *pmailbox);
+
+/*
+ * Desc: if there is mail to be received
+ *       this function will return that data
+ *       to your buffer(pdata) this function
+ *       will check if there is data but will
+ *       not wait for new data
+ *
+ *       If there is data, it will return MIL_CAN_OK
+ *       otherwise it will return MIL_CAN_NOK
+ *
+ * Parameters:
+ * pmailbox - a pointer to your mailbox object struct
+ * pdata - a pointer to your data buffer(an array)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if there was new data
+ *                    MIL_CAN_NOK if there is no data
+ */
+mil_can_status_t MIL_CAN_GetMail(MIL_CAN_MailBox_t *pmailbox);
+
+/*
+ * Desc: Will return MIL_CAN_OK for new data
+ *       or MIL_CAN_NOK if there is no data
+ *
+ * Paramters:
+ * pmailbox - a pointer to your initialized mailbox
+ *
+ * Returns:
+ * a mil_can_status_t depending on whether or not there's data
+ *
+ * NOTE - DATA WILL BE RETURNED TO YOUR OUT BUFFER
+ */
+mil_can_status_t MIL_CAN_CheckMail(MIL_CAN_MailBox_t *pmailbox);
+
+/**************************INTERRUPT DRIVEN RECEPTION********************/
+
+/*
+ * WHAT THIS IS FOR:
+ * MIL_CAN_GetMail only sees a message object when the main loop
+ * gets around to polling it. If two frames land in the same object
+ * before then, the first one is overwritten and gone.
+ *
+ * The receive queue fixes that by letting the CAN interrupt pull every
+ * message object with new data into a software queue the moment it
+ * arrives. Your main loop then empties the queue whenever it's free,
+ * one frame at a time or in batches.
+ *
+ * The queue is single producer(the ISR) and single consumer(your main loop)
+ * so no interrupts are disabled while reading from it.
+ *
+ * HOW TO USE:
+ * 1) MIL_InitCAN like normal
+ * 2) MIL_CAN_RxQueueInit(base)
+ * 3) fill out a mailbox per filter and pass it to MIL_CAN_RxQueueAttach
+ *    (the buffer parameter is not used in this mode)
+ * 4) MIL_CANIntEnable(MIL_CAN0_ISR,CAN0_BASE) or
+ *    MIL_CANIntEnable(MIL_CAN1_ISR,CAN1_BASE)
+ *    if you already have your own CAN ISR, call MIL_CAN_ISRHandler(base)
+ *    from it instead
+ * 5) call MIL_CAN_RxQueueGet in your loop until it returns MIL_CAN_NOK
+ */
+
+/*
+ * Desc: number of frames the receive queue can hold per CAN module
+ *
+ * Note: MUST BE A POWER OF 2
+ *       each frame costs 16 bytes of SRAM and there's one queue
+ *       for CAN0 and one for CAN1. Define this in your project's
+ *       predefined symbols to change it
+ */
+#ifndef MIL_CAN_RXQ_SIZE
+#define MIL_CAN_RXQ_SIZE 32
+#endif
+
+//frame flags
+#define MIL_CAN_FRAME_LOST 0x01 //the hardware object overwrote an older frame before this one was read
+
+/*
+ * Desc: a single received CAN frame
+ *
+ * PARAMETERS:
+ * canid - ID the frame was sent with
+ * len - number of valid bytes in data(0 to 8)
+ * obj_num - message object(1 to 32) that received the frame
+ * flags - MIL_CAN_FRAME_x flags
+ * data - frame payload
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint8_t  len;
+  uint8_t  obj_num;
+  uint8_t  flags;
+  uint8_t  data[8];
+
+} MIL_CAN_Frame_t;
+
+/*
+ * Desc: receive queue counters
+ *
+ * PARAMETERS:
+ * rx_frames - frames placed into the queue
+ * overflows - frames thrown away because the queue was full
+ * lost - frames overwritten inside a message object before the ISR read them
+ */
+typedef struct{
+
+  uint32_t rx_frames;
+  uint32_t overflows;
+  uint32_t lost;
+
+} MIL_CAN_RxQueueStats_t;
+
+/*
+ * Desc: empties the receive queue for a CAN module,
+ *       detaches every mailbox and clears the counters
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_RxQueueInit(uint32_t base);
+
+/*
+ * Desc: initializes a mailbox like MIL_InitMailBox but
+ *       routes everything it receives into the receive queue
+ *
+ * Note: the rx_flag_int parameter is forced to 1
+ *       and the buffer parameter is ignored
+ *
+ * Parameters:
+ * pmailbox - a pointer to your configured mailbox
+ */
+void MIL_CAN_RxQueueAttach(MIL_CAN_MailBox_t *pmailbox);
+
+/*
+ * Desc: pops the oldest frame out of the receive queue
+ *       this will not wait for new frames
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pframe - where the frame will be copied to
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if a frame was copied to pframe
+ *                    MIL_CAN_NOK if the queue is empty
+ */
+mil_can_status_t MIL_CAN_RxQueueGet(uint32_t base,MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: number of frames currently waiting in the receive queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+uint32_t MIL_CAN_RxQueueCount(uint32_t base);
+
+/*
+ * Desc: copies out the receive queue counters
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pstats - where the counters will be copied to
+ */
+void MIL_CAN_RxQueueStatsGet(uint32_t base,MIL_CAN_RxQueueStats_t *pstats);
+
+/*
+ * Desc: function the CAN ISR runs on every frame headed for the receive
+ *       queue, before your main loop can see it. It runs even when the
+ *       queue is full, so a busy main loop never starves it
+ *
+ * Parameters:
+ * base - module the frame came in on
+ * pframe - a copy of the frame on the ISR's stack, it only goes into the
+ *          queue after the hook returns false
+ *
+ * Returns:
+ * bool - true if the hook took the frame and it should stay out of the queue
+ *
+ * Note: this runs inside the CAN ISR, keep it short
+ */
+typedef bool (*mil_can_rx_hook_t)(uint32_t base,MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: runs a function on every frame headed for the receive queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * hook - your function(0 to remove it), return true to keep the
+ *        frame out of the queue
+ */
+void MIL_CAN_RxHookSet(uint32_t base,mil_can_rx_hook_t hook);
+
+/**************************QUEUED TRANSMISSION***************************/
+
+/*
+ * WHAT THIS IS FOR:
+ * MIL_CANSimpleTX writes straight into one message object, so calling it
+ * again before the last frame went out overwrites the frame that was
+ * still waiting.
+ *
+ * The transmit queue reserves a block of message objects for sending and
+ * puts everything else into a software queue. Each time a frame finishes,
+ * the CAN status interrupt(TXOK) loads the next frames into the free objects,
+ * so the bus never waits on your main loop.
+ *
+ * Frames leave in the order you queued them. The controller always sends
+ * the lowest numbered pending object first, so a free object is only reloaded
+ * once every object below it has finished.
+ *
+ * HOW TO USE:
+ * 1) MIL_InitCAN like normal
+ * 2) MIL_CAN_TxQueueInit(base,first_obj,num_objs) to reserve objects
+ *    (don't use those objects for mailboxes)
+ * 3) MIL_CANIntEnable(MIL_CANx_ISR,base) (or call MIL_CAN_ISRHandler in yours)
+ * 4) send with MIL_CAN_TxQueueSend, MIL_CANSimpleTX also goes through the
+ *    queue once it's initialized
+ *
+ * Need some frames to skip the line? see PRIORITY TRANSMIT CLASSES below
+ */
+
+/*
+ * Desc: number of frames the transmit queue can hold per CAN module
+ *
+ * Note: MUST BE A POWER OF 2
+ *       each frame costs 16 bytes of SRAM
+ */
+#ifndef MIL_CAN_TXQ_SIZE
+#define MIL_CAN_TXQ_SIZE 32
+#endif
+
+/*
+ * Desc: transmit queue counters
+ *
+ * PARAMETERS:
+ * queued - frames accepted by MIL_CAN_TxQueueSend
+ * sent - frames the controller finished transmitting
+ * dropped - frames refused because the queue was full
+ * abandoned - frames pulled by a one shot or deadline policy
+ *             (see TRANSMIT POLICIES)
+ */
+typedef struct{
+
+  uint32_t queued;
+  uint32_t sent;
+  uint32_t dropped;
+  uint32_t abandoned;
+
+} MIL_CAN_TxQueueStats_t;
+
+/*
+ * Desc: reserves message objects first_obj to first_obj + num_objs - 1
+ *       for transmission and empties the transmit queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * first_obj - first reserved message object(1 to 32)
+ * num_objs - how many objects to reserve
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the objects run past object 32
+ */
+mil_can_status_t MIL_CAN_TxQueueInit(uint32_t base,uint8_t first_obj,uint8_t num_objs);
+
+/*
+ * Desc: queues a frame for transmission, this never waits on the bus
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * canid - ID to send with
+ * pMsg - pointer to your message(copied, you can reuse it right away)
+ * MsgLen - number of bytes in your message(up to 8 bytes)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if the frame was queued
+ *                    MIL_CAN_NOK if the queue is full or not initialized
+ */
+mil_can_status_t MIL_CAN_TxQueueSend(uint32_t base,uint32_t canid,const uint8_t *pMsg,uint8_t MsgLen);
+
+/*
+ * Desc: number of frames waiting for a free message object
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+uint32_t MIL_CAN_TxQueueCount(uint32_t base);
+
+/*
+ * Desc: copies out the transmit queue counters
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pstats - where the counters will be copied to
+ */
+void MIL_CAN_TxQueueStatsGet(uint32_t base,MIL_CAN_TxQueueStats_t *pstats);
+
+/**************************PRIORITY TRANSMIT CLASSES*********************/
+
+/*
+ * WHAT THIS IS FOR:
+ * Everything in the transmit queue goes out in the order it was queued, so
+ * a kill command queued behind 30 frames of telemetry waits for all 30.
+ * Arbitration doesn't help with that, a frame still sitting in the
+ * software queue never makes it onto the bus to arbitrate.
+ *
+ * Priority classes give each kind of traffic its own queue and its own
+ * band of message objects. The controller always starts the lowest
+ * numbered pending object, so as long as the more urgent bands sit below
+ * the less urgent ones a kill frame is loaded and sent next no matter how
+ * much bulk traffic is waiting.
+ *
+ * WORST CASE WAIT FOR A CLASS:
+ * the frame already on the wire(the controller won't abort it) plus every
+ * frame already loaded in a more urgent class, then arbitration against
+ * the other boards. With the kill class alone in objects 1-2 that is one
+ * frame time(~135 bits) when nobody else on the bus is sending kills.
+ *
+ * HOW TO USE:
+ * 1) MIL_CAN_TxClassInit for each class you use, most urgent class in the
+ *    lowest objects, e.g.
+ *      MIL_CAN_TxClassInit(CAN0_BASE,MIL_CAN_TX_KILL,1,2);
+ *      MIL_CAN_TxClassInit(CAN0_BASE,MIL_CAN_TX_THRUSTER,3,4);
+ *      MIL_CAN_TxClassInit(CAN0_BASE,MIL_CAN_TX_TELEMETRY,7,4);
+ *      MIL_CAN_TxClassInit(CAN0_BASE,MIL_CAN_TX_BULK,11,4);
+ * 2) MIL_CANIntEnable(MIL_CANx_ISR,base) like the transmit queue
+ * 3) MIL_CAN_TxClassSend(base,MIL_CAN_TX_KILL,canid,data,len)
+ *
+ * The bulk class IS the transmit queue above, MIL_CAN_TxQueueInit and
+ * MIL_CAN_TxQueueSend are the same as the bulk class calls.
+ *
+ * Each class is its own queue, so one class can be fed from an ISR while
+ * another is fed from the main loop, just don't send to the SAME class
+ * from two places that can interrupt each other. MIL_CAN_TxClassSend
+ * takes the message object lock, so sending from the other module's CAN
+ * ISR is fine, any other ISR has to be added to the lock first(see
+ * MESSAGE OBJECT LOCKING).
+ */
+
+/*
+ * Desc: transmit classes, most urgent first
+ */
+typedef enum{
+    MIL_CAN_TX_KILL,        //kill switch/estop
+    MIL_CAN_TX_THRUSTER,    //thruster and actuator commands
+    MIL_CAN_TX_TELEMETRY,   //periodic status
+    MIL_CAN_TX_BULK,        //logs, config blobs, anything that can wait
+    MIL_CAN_TX_NUM_CLASSES
+}mil_can_tx_class_t;
+
+/*
+ * Desc: frames each class other than bulk can hold per CAN module
+ *       (bulk uses MIL_CAN_TXQ_SIZE)
+ *
+ * Note: MUST BE A POWER OF 2
+ */
+#ifndef MIL_CAN_TXCLASS_SIZE
+#define MIL_CAN_TXCLASS_SIZE 8
+#endif
+
+/*
+ * Desc: reserves message objects first_obj to first_obj + num_objs - 1
+ *       for a class and empties its queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * tx_class - class to set up
+ * first_obj - first reserved message object(1 to 32)
+ * num_objs - how many objects to reserve
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the objects run past object 32,
+ *                    overlap another class or sit below a more urgent class
+ */
+mil_can_status_t MIL_CAN_TxClassInit(uint32_t base,mil_can_tx_class_t tx_class,uint8_t first_obj,uint8_t num_objs);
+
+/*
+ * Desc: queues a frame in a class, this never waits on the bus
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * tx_class - class to send in
+ * canid - ID to send with
+ * pMsg - pointer to your message(copied, you can reuse it right away)
+ * MsgLen - number of bytes in your message(up to 8 bytes)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if the frame was queued
+ *                    MIL_CAN_NOK if the class is full or not initialized
+ */
+mil_can_status_t MIL_CAN_TxClassSend(uint32_t base,mil_can_tx_class_t tx_class,uint32_t canid,const uint8_t *pMsg,uint8_t MsgLen);
+
+/*
+ * Desc: number of frames a class has waiting for a free message object,
+ *       0 for a class that doesn't exist
+ */
+uint32_t MIL_CAN_TxClassCount(uint32_t base,mil_can_tx_class_t tx_class);
+
+/*
+ * Desc: copies out a class's counters, pstats is left alone for a class
+ *       that doesn't exist
+ */
+void MIL_CAN_TxClassStatsGet(uint32_t base,mil_can_tx_class_t tx_class,MIL_CAN_TxQueueStats_t *pstats);
+
+/**************************TRANSMIT POLICIES*****************************/
+
+/*
+ * WHAT THIS IS FOR:
+ * MIL_InitCAN turns on automatic retransmission, so a frame that keeps
+ * losing arbitration(or keeps failing) sits in its object retrying
+ * forever. For a thruster command that's the wrong call, by the time it
+ * gets out there's a newer one stuck behind it.
+ *
+ * Each class can pick what happens to frames that can't get out:
+ * MIL_CAN_TX_RETRY    - keep trying until it's sent(the default)
+ * MIL_CAN_TX_ONESHOT  - one or two tries(see below), if it lost
+ *                       arbitration or failed it's pulled and the next
+ *                       frame in the class moves up
+ * MIL_CAN_TX_DEADLINE - keep trying for deadline_us after it was loaded
+ *                       into its object, then pull it
+ *
+ * Pulled frames are counted in the class's abandoned counter.
+ *
+ * HOW IT WORKS:
+ * The controller's retry switch(CANRetrySet) covers every object at once,
+ * so it stays on and the policies are enforced from the CAN ISR instead.
+ * Every frame on the bus ends in a status interrupt(TXOK, RXOK or an
+ * error), one shot frames still waiting after a whole frame went by since
+ * they were loaded lost their try and get invalidated. Deadline frames are
+ * checked on the same interrupts.
+ *
+ * A one shot frame is marked at the first status interrupt after it was
+ * loaded and pulled at the second, so it gets one or two tries. It isn't
+ * marked when it's loaded because it may be loaded while another frame is
+ * already on the wire, and that frame's status interrupt would pull it
+ * before it ever got a try. Frames loaded between frames(from the ISR
+ * right after a status interrupt) usually get two.
+ *
+ * Note: needs the status interrupt(MIL_CANIntEnable turns it on)
+ *       a frame pulled while it's already on the wire(it won arbitration
+ *       on its last try) still finishes, it's counted as abandoned and not
+ *       as sent, so abandoned can over count frames that actually went out
+ */
+
+typedef enum{
+    MIL_CAN_TX_RETRY,
+    MIL_CAN_TX_ONESHOT,
+    MIL_CAN_TX_DEADLINE
+}mil_can_tx_policy_t;
+
+/*
+ * Desc: picks what a class does with a frame that can't get onto the bus
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * tx_class - class to change
+ * policy - MIL_CAN_TX_RETRY, MIL_CAN_TX_ONESHOT or MIL_CAN_TX_DEADLINE
+ * deadline_us - how long a frame may wait in its object(MIL_CAN_TX_DEADLINE only)
+ * time_us - function returning a free running microsecond count
+ *           (MIL_CAN_TX_DEADLINE only, shared by every class)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK for a deadline policy without a clock
+ */
+mil_can_status_t MIL_CAN_TxClassPolicy(uint32_t base,mil_can_tx_class_t tx_class,mil_can_tx_policy_t policy,uint32_t deadline_us,uint32_t (*time_us)(void));
+
+/**************************ERROR HANDLING AND BUS-OFF RECOVERY***********/
+
+/*
+ * WHAT YOU NEED TO UNDERSTAND ABOUT CAN ERRORS:
+ * Every node keeps a transmit and a receive error counter. Errors on the
+ * bus push them up and good frames bring them back down.
+ *
+ * ERROR ACTIVE  - normal operation
+ * ERROR WARNING - a counter passed 96, still normal but something's wrong
+ * ERROR PASSIVE - a counter passed 127, the node stops flagging errors loudly
+ * BUS OFF       - transmit counter passed 255, the controller takes itself
+ *                 off the bus completely and stays off until told to come back
+ *
+ * Before this, a node that went bus off stayed silent until a power cycle.
+ * The error handler watches the controller status from the CAN interrupt,
+ * keeps count of every transition and error code, and brings the
+ * controller back after a recovery delay. Once restarted, the controller
+ * still has to see 128 idle periods on the bus(about 1.4ms at 1Mbps)
+ * before it's allowed to send again, that is the RECOVERING state.
+ *
+ * HOW TO USE:
+ * 1) MIL_InitCAN like normal
+ * 2) MIL_CAN_ErrInit(base,recovery_ms,your_microsecond_clock)
+ *    recovery_ms = 0 restarts the controller right inside the ISR
+ * 3) MIL_CANIntEnable(MIL_CANx_ISR,base) (or call MIL_CAN_ISRHandler in yours)
+ * 4) if recovery_ms isn't 0, call MIL_CAN_ErrService(base) every
+ *    millisecond or so(main loop or a timer ISR)
+ */
+
+/*
+ * Desc: error states
+ */
+typedef enum{
+    MIL_CAN_ERR_ACTIVE,
+    MIL_CAN_ERR_WARNING,
+    MIL_CAN_ERR_PASSIVE,
+    MIL_CAN_ERR_BUS_OFF,
+    MIL_CAN_ERR_RECOVERING,
+    MIL_CAN_ERR_NUM_STATES
+}mil_can_err_state_t;
+
+/*
+ * Desc: error handler counters
+ *
+ * PARAMETERS:
+ * state - current error state
+ * tx_err_cnt - transmit error counter at the last update
+ * rx_err_cnt - receive error counter at the last update
+ * lec_count - how many times each last error code was seen, indexed by
+ *             CAN_STATUS_LEC_x(stuff, form, ack, bit1, bit0, crc)
+ * warning_count - times the node entered error warning
+ * passive_count - times the node entered error passive
+ * bus_off_count - times the node went bus off
+ * recoveries - times the node came back from bus off
+ * time_in_state_us - total time spent in each mil_can_err_state_t, 64 bit
+ *                    so it holds years. It's added up from clock
+ *                    differences, so MIL_CAN_ErrService or
+ *                    MIL_CAN_ErrStatsGet has to run at least once every
+ *                    ~71 minutes for a 32 bit microsecond clock
+ */
+typedef struct{
+
+  mil_can_err_state_t state;
+  uint32_t tx_err_cnt;
+  uint32_t rx_err_cnt;
+  uint32_t lec_count[8];
+  uint32_t warning_count;
+  uint32_t passive_count;
+  uint32_t bus_off_count;
+  uint32_t recoveries;
+  uint64_t time_in_state_us[MIL_CAN_ERR_NUM_STATES];
+
+} MIL_CAN_ErrStats_t;
+
+/*
+ * Desc: starts the error handler and enables controller error interrupts
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * recovery_ms - how long to stay off the bus before restarting
+ * time_us - function returning a free running microsecond count
+ */
+void MIL_CAN_ErrInit(uint32_t base,uint32_t recovery_ms,uint32_t (*time_us)(void));
+
+/*
+ * Desc: restarts the controller once the recovery delay has passed
+ *       and polls the controller status
+ *
+ * Note: the state machine also works without the CAN interrupt as long
+ *       as this gets called regularly
+ *
+ *       Also books the time spent in the current state, call this(or
+ *       MIL_CAN_ErrStatsGet) at least once before the microsecond clock
+ *       wraps
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_ErrService(uint32_t base);
+
+/*
+ * Desc: current error state
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+mil_can_err_state_t MIL_CAN_ErrState(uint32_t base);
+
+/*
+ * Desc: copies out the error handler counters, time_in_state_us
+ *       includes the time spent in the current state so far
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pstats - where the counters will be copied to
+ */
+void MIL_CAN_ErrStatsGet(uint32_t base,MIL_CAN_ErrStats_t *pstats);
+
+/*
+ * Desc: the body of the MIL CAN interrupt
+ *
+ * Note: acknowledges status interrupts(running the error handler),
+ *       drains every attached message object with new data into the
+ *       receive queue,
+ *       reloads free transmit objects from the transmit queue and
+ *       clears interrupts from objects MIL_CAN doesn't own
+ *
+ *       Only call this from the CAN interrupt for that module
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_ISRHandler(uint32_t base);
+
+/*
+ * Desc: ready made ISRs to pass into MIL_CANIntEnable
+ *       these just call MIL_CAN_ISRHandler with the right base
+ */
+void MIL_CAN0_ISR(void);
+void MIL_CAN1_ISR(void);
+
+/**************************MESSAGE OBJECT LOCKING************************/
+
+/*
+ * WHAT THIS IS FOR:
+ * Every CANMessageSet goes through the module's IF1 registers and every
+ * CANMessageGet through IF2. A call is several register writes long, so if
+ * something interrupts it halfway and uses the same interface on the same
+ * module, both end up with a mix of each other's ID, data and object
+ * number.
+ *
+ * Masking only your own module's interrupt isn't enough. The gateway hook
+ * runs in the CAN0 ISR and sends on CAN1, the schedule timer loads objects
+ * on both modules, so any of these can land in the middle of somebody
+ * else's interface access.
+ *
+ * THE RULE:
+ * Everything that touches message objects(CANMessageSet/Get, the
+ * MIL_CAN_Fast calls, CANStatusGet on NEWDAT/TXREQUEST followed by one of
+ * those) does it between MIL_CAN_IfLock and MIL_CAN_IfUnlock. The lock
+ * masks INT_CAN0, INT_CAN1 and every interrupt added with
+ * MIL_CAN_IfLockAdd, so nothing else that uses an interface can run
+ * until you're done.
+ *
+ * MIL_CAN's own functions already do this, including the ISR, the
+ * coalescing timer and the schedule timer. You only need it for your own
+ * driverlib calls or MIL_CAN_Fast calls:
+ *      uint32_t lock = MIL_CAN_IfLock();
+ *      MIL_CAN_FastWrite(CAN1_BASE,5,data,8);
+ *      MIL_CAN_IfUnlock(lock);
+ * and if you touch message objects from an interrupt of your own(not a
+ * CAN interrupt), add it once at start up:
+ *      MIL_CAN_IfLockAdd(INT_TIMER2A);
+ */
+
+/*
+ * Desc: most interrupts the lock can mask, CAN0 and CAN1 included
+ */
+#ifndef MIL_CAN_LOCK_MAX_INTS
+#define MIL_CAN_LOCK_MAX_INTS 8
+#endif
+
+/*
+ * Desc: adds an interrupt that touches message objects to the lock
+ *
+ * Parameters:
+ * int_num - INT_xxx number from hw_ints.h
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if MIL_CAN_LOCK_MAX_INTS are already in
+ *
+ * Note: adding the same interrupt twice is fine
+ */
+mil_can_status_t MIL_CAN_IfLockAdd(uint32_t int_num);
+
+/*
+ * Desc: masks every interrupt that touches message objects
+ *
+ * Returns:
+ * uint32_t - the ones this call masked, hand it to MIL_CAN_IfUnlock
+ *
+ * Note: only what was enabled gets masked and unmasked again, so locks
+ *       nest and an interrupt somebody else turned off stays off
+ */
+uint32_t MIL_CAN_IfLock(void);
+
+/*
+ * Desc: undoes MIL_CAN_IfLock
+ *
+ * Parameters:
+ * saved - what MIL_CAN_IfLock returned
+ */
+void MIL_CAN_IfUnlock(uint32_t saved);
+
+/**************************RECEIVE INTERRUPT COALESCING******************/
+
+/*
+ * WHAT THIS IS FOR:
+ * Every frame into an interrupt driven mailbox costs an interrupt(two
+ * really, RXOK raises a status interrupt too). At 1M with a bus full
+ * of 8 byte frames that's ~8000 frames a second per module and the core
+ * spends a good chunk of its time getting into and out of the CAN ISR.
+ *
+ * With coalescing on, the first frame only opens a batch: the ISR turns
+ * off the module's interrupt line(CAN_INT_MASTER) and starts a timer.
+ * Frames keep landing in their message objects without interrupting
+ * anybody, and as soon as either
+ *   -max_frames attached objects are holding new data, or
+ *   -max_delay_us has passed since the batch opened
+ * the timer tick turns the line back on and pends the CAN interrupt, which
+ * drains all of them in one pass. The drain always runs in the CAN ISR,
+ * so it can't land in the middle of a send from the main loop.
+ *
+ * Anything else that interrupts(TXOK, errors, bus off) is still handled
+ * right away when no batch is open. While a batch is open transmit
+ * refills and error handling wait for the drain too, so don't turn this
+ * on for a module carrying a class with tight latency(MIL_CAN_TX_KILL)
+ * unless max_delay_us is small.
+ *
+ * TUNING:
+ * max_frames has to stay below the number of attached objects or an
+ * object gets overwritten before the drain(watch overflows/lost in the
+ * receive queue stats). max_delay_us is the most latency a frame picks
+ * up, the tick period adds up to one more tick on top.
+ * MIL_CAN_RxCoalesceStatsGet shows how it's going:
+ *   isr_calls per second - interrupt rate, compare with coalescing off
+ *   frames / drains      - frames handled per drain
+ *   full vs deadline     - which limit is doing the work
+ *   max/total latency    - how long batches stay open
+ *
+ * HOW TO USE:
+ * 1) set up the receive queue like normal
+ * 2) MIL_CAN_RxCoalesceInit(TIMER1_BASE,100,time_us), 100us tick
+ * 3) MIL_CAN_RxCoalesce(CAN1_BASE,6,1000), drain at 6 frames or 1ms
+ *
+ * Note: MIL_CAN_RxCoalesceInit adds its timer to the message object lock
+ *       (see MESSAGE OBJECT LOCKING). If you call MIL_CAN_RxCoalesceTick
+ *       from your own timer, add that timer's interrupt with
+ *       MIL_CAN_IfLockAdd
+ */
+
+/*
+ * Desc: coalescing counters
+ *
+ * PARAMETERS:
+ * isr_calls - CAN interrupts taken by this module(counted with coalescing
+ *             off too so you have something to compare against)
+ * drains - deferred drains run
+ * full_drains - drains started because max_frames objects were waiting
+ * deadline_drains - drains started because max_delay_us ran out
+ * frames - objects with new data found by the drains
+ * max_latency_us - longest a batch stayed open
+ * total_latency_us - sum over all drains(divide by drains for the average)
+ */
+typedef struct{
+
+  uint32_t isr_calls;
+  uint32_t drains;
+  uint32_t full_drains;
+  uint32_t deadline_drains;
+  uint32_t frames;
+  uint32_t max_latency_us;
+  uint32_t total_latency_us;
+
+} MIL_CAN_RxCoalesceStats_t;
+
+/*
+ * Desc: sets up the timer that runs deferred drains
+ *
+ * Parameters:
+ * timer_base - TIMER0_BASE to TIMER5_BASE(timer A is used), 0 if you'll
+ *              call MIL_CAN_RxCoalesceTick from your own periodic timer
+ * tick_us - tick period in microseconds
+ * time_us - function returning a free running microsecond count
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK for an unknown timer, a missing time_us
+ *                    or if the message object lock is full
+ *
+ * Note: the timer only runs while a batch is open
+ */
+mil_can_status_t MIL_CAN_RxCoalesceInit(uint32_t timer_base,uint32_t tick_us,uint32_t (*time_us)(void));
+
+/*
+ * Desc: turns coalescing on or off for a module
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * max_frames - drain once this many attached objects have new data,
+ *              0 turns coalescing off
+ * max_delay_us - drain once a batch has been open this long
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if MIL_CAN_RxCoalesceInit hasn't set up
+ *                    a clock yet(coalescing stays off)
+ */
+mil_can_status_t MIL_CAN_RxCoalesce(uint32_t base,uint8_t max_frames,uint32_t max_delay_us);
+
+/*
+ * Desc: checks open batches and pends the CAN interrupt for the ones
+ *       that are due
+ *
+ * Note: MIL_CAN_RxCoalesceInit's timer does this for you, only call
+ *       it if you passed timer_base 0
+ */
+void MIL_CAN_RxCoalesceTick(void);
+
+/*
+ * Desc: copies out the coalescing counters
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pstats - where the counters will be copied to
+ */
+void MIL_CAN_RxCoalesceStatsGet(uint32_t base,MIL_CAN_RxCoalesceStats_t *pstats);
+
+/**************************MAILBOX REGISTRY******************************/
+
+/*
+ * WHAT THIS IS FOR:
+ * MIL_CAN_CheckMail and MIL_CAN_GetMail each read the NEWDAT status
+ * (two 16 bit register reads through the CAN interface) so polling N
+ * mailboxes that way reads the same status 2N times every loop.
+ *
+ * The registry reads NEWDAT once per dispatch, walks only the set bits
+ * and calls the handler you registered for that mailbox.
+ *
+ * Register cost per dispatch(CANStatusGet = 2 register reads):
+ *   CheckMail + GetMail on N mailboxes - 4N reads + 1 CANMessageGet per new frame
+ *   MIL_CAN_RegistryDispatch           - 2 reads  + 1 CANMessageGet per new frame
+ * so 20 mailboxes goes from 80 status reads down to 2 no matter how many you add
+ *
+ * HOW TO USE:
+ * 1) MIL_CAN_RegistryInit(&registry,base)
+ * 2) fill out each mailbox like normal(buffer MUST be set) then
+ *    MIL_CAN_RegistryAdd(&registry,&mailbox,your_handler)
+ * 3) call MIL_CAN_RegistryDispatch(&registry) in your loop
+ *    the mailbox buffer holds the new data when your handler is called
+ */
+
+/*
+ * Desc: called by the registry when its mailbox has new data
+ */
+typedef void (*mil_can_mail_handler_t)(MIL_CAN_MailBox_t *pmailbox);
+
+/*
+ * Desc: holds every mailbox that should be dispatched together
+ *
+ * Note: you do not configure these parameters, use the
+ *       registry functions
+ *
+ * PARAMETERS:
+ * base - TIVA CANx_BASE the mailboxes live on
+ * obj_mask - bit n-1 set = message object n is registered
+ * pmailbox - registered mailbox, indexed by obj_num - 1
+ * handler - handler for that mailbox, indexed by obj_num - 1
+ */
+typedef struct{
+
+  uint32_t base;
+  uint32_t obj_mask;
+  MIL_CAN_MailBox_t *pmailbox[32];
+  mil_can_mail_handler_t handler[32];
+
+} MIL_CAN_MailRegistry_t;
+
+/*
+ * Desc: empties a registry
+ *
+ * Parameters:
+ * pregistry - a pointer to your registry
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_RegistryInit(MIL_CAN_MailRegistry_t *pregistry,uint32_t base);
+
+/*
+ * Desc: initializes the mailbox(like MIL_InitMailBox) and registers
+ *       its handler
+ *
+ * Parameters:
+ * pregistry - a pointer to your registry
+ * pmailbox - a pointer to your configured mailbox
+ * handler - function to call when the mailbox has new data
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the mailbox is on another base,
+ *                    has a bad obj_num or the object is already registered
+ */
+mil_can_status_t MIL_CAN_RegistryAdd(MIL_CAN_MailRegistry_t *pregistry,
+                                     MIL_CAN_MailBox_t *pmailbox,
+                                     mil_can_mail_handler_t handler);
+
+/*
+ * Desc: reads NEWDAT once, loads every registered mailbox that has
+ *       new data into its buffer and calls its handler
+ *
+ * Note: mailboxes are handled from lowest to highest object number
+ *
+ * Parameters:
+ * pregistry - a pointer to your registry
+ *
+ * Returns:
+ * number of mailboxes that were handled
+ */
+uint8_t MIL_CAN_RegistryDispatch(MIL_CAN_MailRegistry_t *pregistry);
+
+/**************************PACKED MAILBOX REGISTRY***********************/
+
+/*
+ * WHAT THIS IS FOR:
+ * Every MIL_CAN_MailBox_t carries its ID, mask, length and buffer
+ * pointer and then a whole tCANMsgObject holding the same things again,
+ * around 40 bytes of SRAM per mailbox(plus the registry's two pointers
+ * per object). With 20 mailboxes that's close to 1KB of a 32KB part
+ * spent on copies of constants.
+ *
+ * The packed registry keeps one 8 byte entry per mailbox with just the
+ * ID, mask, length, object number and which data slot it fills. The
+ * table is const so it lives in flash and is laid out by the compiler,
+ * the only SRAM used is the 8 byte data slots. The tCANMsgObject is built
+ * on the stack whenever the driver talks to the hardware.
+ *
+ *   MIL_CAN_MailBox_t + MIL_CAN_RegistryAdd - ~48 bytes SRAM per mailbox
+ *   MIL_CAN_PackedBox_t                     -   8 bytes flash per mailbox
+ *                                               8 bytes SRAM per slot
+ *
+ * Note: standard(11 bit) IDs only, which is all MIL_CAN uses
+ *
+ * HOW TO USE:
+ * 1) write the boxes and the registry as const tables
+ *
+ *      static uint8_t can_slots[3][8];
+ *
+ *      static const MIL_CAN_PackedBox_t can_boxes[] = {
+ *          MIL_CAN_PACKED_BOX(MIL_CAN_ID(3,7),0x7FF,8,1,0),
+ *          MIL_CAN_PACKED_BOX(MIL_CAN_ID(4,0),0x7F0,8,2,1),  //whole group 4
+ *          MIL_CAN_PACKED_BOX(MIL_CAN_ID(5,1),0x7FF,2,3,2),
+ *      };
+ *
+ *      static const MIL_CAN_PackedRegistry_t can_reg =
+ *          MIL_CAN_PACKED_REGISTRY(CAN1_BASE,can_boxes,can_slots,your_handler);
+ *
+ * 2) MIL_CAN_PackedInit(&can_reg) after MIL_InitCAN
+ * 3) call MIL_CAN_PackedDispatch(&can_reg) in your loop, your handler
+ *    gets the box that fired and its slot
+ *
+ * Two boxes can share a slot if they carry the same kind of data.
+ */
+
+/*
+ * Desc: one mailbox of a packed registry(8 bytes)
+ *
+ * Note: build these with MIL_CAN_PACKED_BOX
+ *
+ * PARAMETERS:
+ * canid - 11 bit ID
+ * filt_mask - 11 bit mask
+ * msg_len - values 1 to 8
+ * obj_num - values 1 to 32
+ * slot - index of the data slot received frames are copied into
+ * flags - MIL_CAN_PACKED_* flags
+ */
+typedef struct{
+
+  uint16_t canid;
+  uint16_t filt_mask;
+  uint8_t  msg_len;
+  uint8_t  obj_num;
+  uint8_t  slot;
+  uint8_t  flags;
+
+} MIL_CAN_PackedBox_t;
+
+//also fire the CAN interrupt when this box receives(rx_flag_int)
+#define MIL_CAN_PACKED_RX_INT 0x01
+
+#define MIL_CAN_PACKED_BOX(canid,mask,len,obj,slot) \
+    {(uint16_t)(canid),(uint16_t)(mask),(len),(obj),(slot),0}
+
+#define MIL_CAN_PACKED_BOX_INT(canid,mask,len,obj,slot) \
+    {(uint16_t)(canid),(uint16_t)(mask),(len),(obj),(slot),MIL_CAN_PACKED_RX_INT}
+
+/*
+ * Desc: called by MIL_CAN_PackedDispatch when a box has new data
+ *
+ * Parameters:
+ * pbox - the box that received
+ * canid - ID of the frame(differs from pbox->canid when masked)
+ * pdata - its data slot, holds the new data
+ * len - bytes actually received
+ */
+typedef void (*mil_can_packed_handler_t)(const MIL_CAN_PackedBox_t *pbox,uint32_t canid,uint8_t *pdata,uint8_t len);
+
+/*
+ * Desc: a packed registry
+ *
+ * Note: build these with MIL_CAN_PACKED_REGISTRY and declare them const
+ *
+ * PARAMETERS:
+ * base - TIVA CANx_BASE the boxes live on
+ * pboxes - the box table
+ * num_boxes - entries in pboxes
+ * pslots - the data slots
+ * num_slots - entries in pslots
+ * handler - called for every box with new data(can be 0)
+ */
+typedef struct{
+
+  uint32_t base;
+  const MIL_CAN_PackedBox_t *pboxes;
+  uint8_t  num_boxes;
+  uint8_t  (*pslots)[8];
+  uint8_t  num_slots;
+  mil_can_packed_handler_t handler;
+
+} MIL_CAN_PackedRegistry_t;
+
+//counts the boxes and slots for you, boxes and slots must be arrays
+#define MIL_CAN_PACKED_REGISTRY(base,boxes,slots,handler) \
+    {(base),(boxes),(uint8_t)(sizeof(boxes) / sizeof((boxes)[0])), \
+     (slots),(uint8_t)(sizeof(slots) / sizeof((slots)[0])),(handler)}
+
+/*
+ * Desc: loads every box of a packed registry into the controller
+ *
+ * Parameters:
+ * pregistry - a pointer to your const registry
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if a box has a bad obj_num, length
+ *                    or slot, or two boxes use the same object
+ *                    (nothing is loaded in that case)
+ */
+mil_can_status_t MIL_CAN_PackedInit(const MIL_CAN_PackedRegistry_t *pregistry);
+
+/*
+ * Desc: reads NEWDAT once, copies every box that has new data into its
+ *       slot and calls the handler
+ *
+ * Note: boxes are handled in table order
+ *
+ * Parameters:
+ * pregistry - a pointer to your const registry
+ *
+ * Returns:
+ * number of boxes that were handled
+ */
+uint8_t MIL_CAN_PackedDispatch(const MIL_CAN_PackedRegistry_t *pregistry);
+
+/**************************ID ROUTING TABLE******************************/
+
+/*
+ * WHAT THIS IS FOR:
+ * Instead of decoding every frame with a long if/else chain on its ID,
+ * you write one const table that says which function handles which ID.
+ * The compiler lays the table out in flash, indexed directly by ID, so
+ * routing a frame is one array lookup no matter how many IDs you handle
+ * and there's nothing to set up at boot.
+ *
+ * OUR ID CONVENTION:
+ * upper nibble - task group
+ * lower nibble - ECU
+ * MIL_CAN_ID(3,7) builds 0x37
+ *
+ * HOW TO USE:
+ * static const MIL_CAN_RouteTable_t routes = {
+ *     MIL_CAN_ROUTE(MIL_CAN_ID(3,7),thruster_cmd_handler),
+ *     MIL_CAN_ROUTE(MIL_CAN_ID(4,1),sonar_handler)
+ * };
+ *
+ * while(MIL_CAN_RxQueueGet(CAN1_BASE,&frame) == MIL_CAN_OK){
+ *     MIL_CAN_Route(routes,&frame);
+ * }
+ *
+ * Note: any ID left out of the table is simply not routed
+ *
+ * ID WIDTH:
+ * The table has one entry per possible ID, so it only covers IDs below
+ * 2^MIL_CAN_ROUTE_ID_BITS. With the default 8 bits that's 0x00-0xFF, 256
+ * IDs at most, which is all our group/ECU convention can make. A frame
+ * with a bigger ID is never routed(MIL_CAN_Route returns MIL_CAN_NOK) and
+ * a MIL_CAN_ROUTE entry with a bigger ID doesn't compile.
+ *
+ * If you need more IDs, raise MIL_CAN_ROUTE_ID_BITS for the whole project:
+ *   9 bits  - 512 IDs(0x000-0x1FF), 2KB of flash per table
+ *   11 bits - every standard ID(0x000-0x7FF), 8KB per table
+ * The lookup stays one array index either way. 512 IDs can't be squeezed
+ * into the 8 bit table, two IDs that share their low 8 bits would need
+ * the same entry. Extended(29 bit) IDs don't fit a direct table at all,
+ * route those with your own code.
+ *
+ * MIL_CAN/Tests/MIL_CAN_Route_BENCH.c times this against a linear search
+ */
+
+/*
+ * Desc: how many ID bits the routing table covers
+ *
+ * Note: the table costs 4 bytes of flash per possible ID,
+ *       8 bits(our convention) is 1KB, 9 bits is 2KB, 11 bits is 8KB
+ */
+#ifndef MIL_CAN_ROUTE_ID_BITS
+#define MIL_CAN_ROUTE_ID_BITS 8
+#endif
+
+#define MIL_CAN_ROUTE_ID_SPACE (0x01UL << MIL_CAN_ROUTE_ID_BITS)
+
+//builds an ID from our task group/ECU convention
+#define MIL_CAN_ID(group,ecu) ((((group) & 0x0F) << 4) | ((ecu) & 0x0F))
+
+//pulls the task group or ECU back out of an ID
+#define MIL_CAN_ID_GROUP(canid) (((canid) >> 4) & 0x0F)
+#define MIL_CAN_ID_ECU(canid)   ((canid) & 0x0F)
+
+/*
+ * Desc: called when a frame with its ID is routed
+ */
+typedef void (*mil_can_frame_handler_t)(const MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: handler for every possible ID, unused IDs are 0
+ *
+ * Note: always declare these const so they stay in flash
+ */
+typedef mil_can_frame_handler_t MIL_CAN_RouteTable_t[MIL_CAN_ROUTE_ID_SPACE];
+
+//one entry of a routing table initializer, an ID past the end of the
+//table is a compile error instead of landing on some other ID's entry
+#define MIL_CAN_ROUTE(canid,handler) [(canid)] = (handler)
+
+/*
+ * Desc: calls the handler for the frame's ID
+ *
+ * Parameters:
+ * table - your const routing table
+ * pframe - a received frame
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if a handler was called
+ *                    MIL_CAN_NOK if no handler exists for that ID
+ */
+mil_can_status_t MIL_CAN_Route(const mil_can_frame_handler_t *table,const MIL_CAN_Frame_t *pframe);
+
+/**************************HARDWARE FIFO MAILBOXES***********************/
+
+/*
+ * WHAT THIS IS FOR:
+ * A normal mailbox is a single message object, so if one ID sends frames
+ * back to back(sonar, IMU streams) faster than you read them, every frame
+ * but the last is overwritten.
+ *
+ * The TIVA can chain several consecutive message objects into one
+ * receive FIFO. Frames fill the objects from the lowest number up and only
+ * the last object(end of buffer) gets overwritten once they're all full.
+ * MIL_CAN_FifoDrain reads every filled object back in arrival order,
+ * as long as you drain the whole FIFO each time(max_frames = depth).
+ *
+ * HOW TO USE:
+ * fill out a MIL_CAN_FifoBox_t like a mailbox, first_obj is where the FIFO
+ * starts and depth is how many objects it takes(first_obj to first_obj + depth - 1)
+ * MIL_InitFifoBox(&fifo);
+ * count = MIL_CAN_FifoDrain(&fifo,frames,depth);
+ *
+ * or let the receive queue drain it for you with MIL_CAN_RxQueueAttachFifo
+ */
+
+/*
+ * Desc: a mailbox spread across several message objects
+ *
+ * PARAMETERS:
+ * canid - the target ID you wish to filter for
+ * filt_mask - which bits matter in the canid
+ * base - TIVA CANx_BASE from tivaware
+ * msg_len - how long the expected CAN data is
+ * first_obj - first message object of the FIFO(1 to 32)
+ * depth - how many objects the FIFO spans(2 or more)
+ * rx_flag_int - set to 1 to raise an interrupt for every received frame
+ * lost - frames overwritten in the last object because the FIFO was full
+ *        (you do not configure this)
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint32_t filt_mask;
+  uint32_t base;
+  uint8_t  msg_len;
+  uint8_t  first_obj;
+  uint8_t  depth;
+  uint8_t  rx_flag_int;
+  uint32_t lost;
+
+} MIL_CAN_FifoBox_t;
+
+/*
+ * Desc: configures the chained message objects for a FIFO mailbox
+ *
+ * Parameters:
+ * pfifo - a pointer to your FIFO mailbox
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the FIFO runs past object 32
+ *                    or depth is less than 2
+ */
+mil_can_status_t MIL_InitFifoBox(MIL_CAN_FifoBox_t *pfifo);
+
+/*
+ * Desc: reads every frame waiting in the FIFO, oldest first
+ *       this will not wait for new frames
+ *
+ * Note: oldest first only holds when max_frames covers everything
+ *       waiting(pass depth). Frames left behind stay in the higher
+ *       objects, the controller puts the next frame in the lowest
+ *       object that was freed, and the next drain returns that newer
+ *       frame ahead of the older ones left behind
+ *
+ * Parameters:
+ * pfifo - a pointer to your initialized FIFO mailbox
+ * pframes - array the frames are copied to
+ * max_frames - size of that array(depth gets you everything)
+ *
+ * Returns:
+ * the number of frames copied to pframes
+ */
+uint8_t MIL_CAN_FifoDrain(MIL_CAN_FifoBox_t *pfifo,MIL_CAN_Frame_t *pframes,uint8_t max_frames);
+
+/*
+ * Desc: initializes a FIFO mailbox and routes everything it receives
+ *       into the receive queue
+ *
+ * Note: the rx_flag_int parameter is forced to 1
+ *
+ * Parameters:
+ * pfifo - a pointer to your configured FIFO mailbox
+ *
+ * Returns:
+ * mil_can_status_t - same as MIL_InitFifoBox
+ */
+mil_can_status_t MIL_CAN_RxQueueAttachFifo(MIL_CAN_FifoBox_t *pfifo);
+
+/**************************ZERO COPY RECEPTION***************************/
+
+/*
+ * WHAT THIS IS FOR:
+ * MIL_CAN_GetMail reads into the mailbox buffer and most code then copies
+ * that into its own structs. These functions skip the extra buffer: the
+ * hardware read goes straight into a frame slot that you borrow and
+ * hand back when you're done with it.
+ *
+ * Polled mailboxes borrow slots from a static pool:
+ *   MIL_CAN_Frame_t *pframe = MIL_CAN_GetMailSlot(&MailBox);
+ *   if(pframe){ ...use pframe->data...; MIL_CAN_SlotRelease(pframe); }
+ *
+ * The receive queue already reads straight into its own slots, so you can
+ * borrow the oldest one in place instead of copying it out:
+ *   MIL_CAN_Frame_t *pframe = MIL_CAN_RxQueuePeek(CAN1_BASE);
+ *   if(pframe){ ...use pframe...; MIL_CAN_RxQueueRelease(CAN1_BASE); }
+ *
+ * Note: slots are meant to be borrowed and returned from your main loop,
+ *       don't use the slot pool from inside ISRs
+ */
+
+/*
+ * Desc: number of frame slots in the zero copy pool(1 to 32)
+ *
+ * Note: each slot costs 16 bytes of SRAM
+ */
+#ifndef MIL_CAN_SLOT_POOL_SIZE
+#define MIL_CAN_SLOT_POOL_SIZE 8
+#endif
+
+/*
+ * Desc: if the mailbox has new data, borrows a slot from the pool and
+ *       reads the frame straight into it
+ *
+ * Note: if the pool is empty the frame stays in the message object
+ *       so you can try again after releasing a slot
+ *
+ * Parameters:
+ * pmailbox - a pointer to your initialized mailbox(buffer isn't used)
+ *
+ * Returns:
+ * pointer to the filled slot or 0 if there was no data or no free slot
+ */
+MIL_CAN_Frame_t *MIL_CAN_GetMailSlot(MIL_CAN_MailBox_t *pmailbox);
+
+/*
+ * Desc: hands a slot from MIL_CAN_GetMailSlot back to the pool
+ *
+ * Parameters:
+ * pframe - the slot you were lent
+ */
+void MIL_CAN_SlotRelease(MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: number of slots left in the pool
+ */
+uint8_t MIL_CAN_SlotsFree(void);
+
+/*
+ * Desc: lends you the oldest frame in the receive queue without copying it
+ *
+ * Note: the frame stays in the queue until MIL_CAN_RxQueueRelease
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ *
+ * Returns:
+ * pointer to the oldest frame or 0 if the queue is empty
+ */
+MIL_CAN_Frame_t *MIL_CAN_RxQueuePeek(uint32_t base);
+
+/*
+ * Desc: removes the frame lent by MIL_CAN_RxQueuePeek from the queue
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ */
+void MIL_CAN_RxQueueRelease(uint32_t base);
+
+/**************************LATEST VALUE MAILBOXES************************/
+
+/*
+ * WHAT THIS IS FOR:
+ * For setpoints like thruster commands only the newest frame matters,
+ * queueing every frame just means working through stale ones.
+ * MIL_CAN_GetMail gets the newest one but can't tell you whether frames
+ * were skipped, and if you read a buffer the ISR also writes you can get
+ * half of one frame and half of the next.
+ *
+ * A latest value box is written by the CAN ISR every time a frame comes
+ * in and read by you whenever you want, with no interrupt masking on
+ * either side. The ISR bumps a sequence number before and after writing,
+ * the reader copies the frame and checks the sequence didn't move(and
+ * isn't odd) while it copied, trying again if it did. You always get a
+ * whole frame plus how many frames were overwritten since your last read.
+ *
+ * HOW TO USE:
+ * 1) fill out canid, filt_mask, base, msg_len and obj_num like a mailbox
+ * 2) MIL_InitLatestBox(&box)
+ * 3) MIL_CANIntEnable(MIL_CANx_ISR,base) (or call MIL_CAN_ISRHandler in yours)
+ * 4) if(MIL_CAN_LatestRead(&box,&frame,&skipped) == MIL_CAN_OK){ ...new value... }
+ *
+ * Note: read each box from one place only, the skipped count is kept per box
+ */
+
+/*
+ * Desc: latest value box
+ *
+ * PARAMETERS(you configure these):
+ * canid - ID to filter for
+ * filt_mask - bit mask
+ * base - TI CANx_BASE value
+ * msg_len - values 1 to 8
+ * obj_num - values 1 to 32
+ *
+ * Everything else is written by the ISR and MIL_CAN_LatestRead
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint32_t filt_mask;
+  uint32_t base;
+  uint8_t  msg_len;
+  uint8_t  obj_num;
+
+  volatile uint32_t seq;       //odd while the ISR is writing
+  volatile uint32_t updates;   //frames written since init(plus frames the
+                               //controller overwrote before the ISR saw them)
+  volatile uint32_t rx_id;     //ID of the newest frame
+  volatile uint8_t  len;
+  uint8_t  data[8];
+  uint32_t read_updates;       //updates as of the last read
+  tCANMsgObject msg_obj;       //used to interface with other TI functions(you do not configure this)
+
+} MIL_CAN_LatestBox_t;
+
+/*
+ * Desc: sets up a latest value box and hooks it into the CAN ISR
+ *
+ * Parameters:
+ * pbox - a pointer to your latest value box
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if obj_num isn't 1 to 32
+ */
+mil_can_status_t MIL_InitLatestBox(MIL_CAN_LatestBox_t *pbox);
+
+/*
+ * Desc: copies out the newest frame without ever masking interrupts
+ *
+ * Parameters:
+ * pbox - a pointer to your latest value box
+ * pframe - where the newest frame is copied to(obj_num is filled in,
+ *          flags gets MIL_CAN_FRAME_LOST if updates were skipped)
+ * pskipped - how many updates came and went since your last read(can be 0)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if the frame is new since your last read
+ *                    MIL_CAN_NOK if nothing changed(pframe still gets the
+ *                    newest value, which may be nothing if no frame came yet)
+ */
+mil_can_status_t MIL_CAN_LatestRead(MIL_CAN_LatestBox_t *pbox,MIL_CAN_Frame_t *pframe,uint32_t *pskipped);
+
+#endif /* MIL_CAN_H_ */
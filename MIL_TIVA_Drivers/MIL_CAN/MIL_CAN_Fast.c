@@ -0,0 +1,260 @@
+/*
+ * Name: MIL_CAN_Fast.c
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Register level read and write for fixed mailboxes
+ *
+ * Notes: writes use IF1 and reads use IF2 like driverlib, so these can
+ *        be mixed with CANMessageSet/CANMessageGet under the same rules
+ */
+
+/* INCLUDES */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_can.h"
+#include "driverlib/can.h"
+
+//MIL includes
+#include "MIL_CAN.h"
+#include "MIL_CAN_Fast.h"
+
+#ifndef MIL_CAN_FAST_DRIVERLIB
+
+/*
+ * Desc: packs two data bytes the way the data registers hold them
+ *       (first byte in the low half)
+ */
+static uint32_t MIL_CAN_FastPack(const uint8_t *pdata,uint8_t idx,uint8_t len){
+
+    uint32_t val = 0;
+
+    if(idx < len){
+        val = pdata[idx];
+    }
+    if((idx + 1) < len){
+        val |= (uint32_t)pdata[idx + 1] << 8;
+    }
+
+    return val;
+
+}
+
+static void MIL_CAN_FastUnpack(uint32_t val,uint8_t *pdata,uint8_t idx,uint8_t len){
+
+    if(idx < len){
+        pdata[idx] = (uint8_t)val;
+    }
+    if((idx + 1) < len){
+        pdata[idx + 1] = (uint8_t)(val >> 8);
+    }
+
+}
+
+/*
+ * Desc: loads a transmit object with a fixed ID and length without
+ *       sending anything
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * obj_num - message object to use(1 to 32)
+ * canid - 11 bit ID every frame from this object is sent with
+ * len - bytes in every frame(0 to 8)
+ */
+void MIL_CAN_FastTxInit(uint32_t base,uint8_t obj_num,uint32_t canid,uint8_t len){
+
+    while(HWREG(base + CAN_O_IF1CRQ) & CAN_IF1CRQ_BUSY){}
+
+    //standard IDs sit in bits 12:2 of ARB2
+    HWREG(base + CAN_O_IF1ARB1) = 0;
+    HWREG(base + CAN_O_IF1ARB2) = CAN_IF1ARB2_MSGVAL | CAN_IF1ARB2_DIR | ((canid & 0x7FF) << 2);
+
+    //no TXRQST so nothing goes out yet
+    HWREG(base + CAN_O_IF1MCTL) = CAN_IF1MCTL_EOB | (len & CAN_IF1MCTL_DLC_M);
+
+    HWREG(base + CAN_O_IF1CMSK) = CAN_IF1CMSK_WRNRD | CAN_IF1CMSK_ARB | CAN_IF1CMSK_CONTROL;
+    HWREG(base + CAN_O_IF1CRQ) = obj_num;
+
+}
+
+/*
+ * Desc: loads new data into a transmit object and requests a send
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * obj_num - object set up with MIL_CAN_FastTxInit
+ * pdata - your data
+ * len - bytes in pdata, should match MIL_CAN_FastTxInit(the length
+ *       sent is always the one from MIL_CAN_FastTxInit)
+ *
+ * Note: doesn't check if the last frame went out, if it hasn't it's
+ *       replaced by this one
+ */
+void MIL_CAN_FastWrite(uint32_t base,uint8_t obj_num,const uint8_t *pdata,uint8_t len){
+
+    uint32_t cmsk = CAN_IF1CMSK_WRNRD | CAN_IF1CMSK_TXRQST | CAN_IF1CMSK_DATAA;
+
+    while(HWREG(base + CAN_O_IF1CRQ) & CAN_IF1CRQ_BUSY){}
+
+    HWREG(base + CAN_O_IF1DA1) = MIL_CAN_FastPack(pdata,0,len);
+    HWREG(base + CAN_O_IF1DA2) = MIL_CAN_FastPack(pdata,2,len);
+
+    //second half only when it's used
+    if(len > 4){
+        HWREG(base + CAN_O_IF1DB1) = MIL_CAN_FastPack(pdata,4,len);
+        HWREG(base + CAN_O_IF1DB2) = MIL_CAN_FastPack(pdata,6,len);
+        cmsk |= CAN_IF1CMSK_DATAB;
+    }
+
+    //data and TXRQST only, ID and DLC stay as they are in the object
+    HWREG(base + CAN_O_IF1CMSK) = cmsk;
+    HWREG(base + CAN_O_IF1CRQ) = obj_num;
+
+}
+
+/*
+ * Desc: reads a receive object if it has new data
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * obj_num - receive object(1 to 32)
+ * pdata - where the data goes, room for 8 bytes
+ * plen - where the received length goes(can be 0)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if there was new data
+ *                    MIL_CAN_NOK if there is no data
+ *
+ * Note: MSGLST isn't cleared, use CANMessageGet on FIFO objects
+ */
+mil_can_status_t MIL_CAN_FastRead(uint32_t base,uint8_t obj_num,uint8_t *pdata,uint8_t *plen){
+
+    uint32_t mctl;
+    uint8_t len;
+
+    while(HWREG(base + CAN_O_IF2CRQ) & CAN_IF2CRQ_BUSY){}
+
+    //pull data and control, clear NEWDAT and INTPND in the same transfer
+    HWREG(base + CAN_O_IF2CMSK) = CAN_IF2CMSK_DATAA | CAN_IF2CMSK_DATAB | CAN_IF2CMSK_CONTROL |
+                                  CAN_IF2CMSK_CLRINTPND | CAN_IF2CMSK_NEWDAT;
+    HWREG(base + CAN_O_IF2CRQ) = obj_num;
+
+    while(HWREG(base + CAN_O_IF2CRQ) & CAN_IF2CRQ_BUSY){}
+
+    mctl = HWREG(base + CAN_O_IF2MCTL);
+    if(!(mctl & CAN_IF2MCTL_NEWDAT)){
+        return MIL_CAN_NOK;
+    }
+
+    len = (uint8_t)(mctl & CAN_IF2MCTL_DLC_M);
+    if(len > 8){
+        len = 8;
+    }
+
+    MIL_CAN_FastUnpack(HWREG(base + CAN_O_IF2DA1),pdata,0,len);
+    MIL_CAN_FastUnpack(HWREG(base + CAN_O_IF2DA2),pdata,2,len);
+    if(len > 4){
+        MIL_CAN_FastUnpack(HWREG(base + CAN_O_IF2DB1),pdata,4,len);
+        MIL_CAN_FastUnpack(HWREG(base + CAN_O_IF2DB2),pdata,6,len);
+    }
+
+    if(plen){
+        *plen = len;
+    }
+
+    return MIL_CAN_OK;
+
+}
+
+#else
+
+/*
+ * Desc: ID and length of each fast transmit object, driverlib needs
+ *       them on every CANMessageSet
+ */
+static uint16_t MIL_CAN_FastTxId[2][32];
+static uint8_t  MIL_CAN_FastTxLen[2][32];
+
+static uint8_t MIL_CAN_FastModule(uint32_t base){
+
+    return (base == CAN1_BASE) ? 1 : 0;
+
+}
+
+void MIL_CAN_FastTxInit(uint32_t base,uint8_t obj_num,uint32_t canid,uint8_t len){
+
+    MIL_CAN_FastTxId[MIL_CAN_FastModule(base)][obj_num - 1] = (uint16_t)canid;
+    MIL_CAN_FastTxLen[MIL_CAN_FastModule(base)][obj_num - 1] = len;
+
+}
+
+void MIL_CAN_FastWrite(uint32_t base,uint8_t obj_num,const uint8_t *pdata,uint8_t len){
+
+    tCANMsgObject msg_obj;
+
+    (void)len;
+
+    msg_obj.ui32MsgID = MIL_CAN_FastTxId[MIL_CAN_FastModule(base)][obj_num - 1];
+    msg_obj.ui32MsgIDMask = 0;
+    msg_obj.ui32Flags = 0;
+    msg_obj.ui32MsgLen = MIL_CAN_FastTxLen[MIL_CAN_FastModule(base)][obj_num - 1];
+    msg_obj.pui8MsgData = (uint8_t *)pdata;
+
+    CANMessageSet(base,obj_num,&msg_obj,MSG_OBJ_TYPE_TX);
+
+}
+
+mil_can_status_t MIL_CAN_FastRead(uint32_t base,uint8_t obj_num,uint8_t *pdata,uint8_t *plen){
+
+    tCANMsgObject msg_obj;
+
+    if(!(CANStatusGet(base,CAN_STS_NEWDAT) & (0x01UL << (obj_num - 1)))){
+        return MIL_CAN_NOK;
+    }
+
+    msg_obj.pui8MsgData = pdata;
+    CANMessageGet(base,obj_num,&msg_obj,1);
+
+    if(plen){
+        *plen = (uint8_t)msg_obj.ui32MsgLen;
+    }
+
+    return MIL_CAN_OK;
+
+}
+
+#endif /* MIL_CAN_FAST_DRIVERLIB */
+
+/*
+ * Desc: MIL_CAN_GetMail on top of MIL_CAN_FastRead, data goes to the
+ *       mailbox buffer
+ *
+ * Parameters:
+ * pmailbox - a mailbox set up with MIL_InitMailBox
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if there was new data
+ *                    MIL_CAN_NOK if there is no data
+ *
+ * Note: at most msg_len bytes are copied to the buffer
+ */
+mil_can_status_t MIL_CAN_FastGetMail(MIL_CAN_MailBox_t *pmailbox){
+
+    uint8_t data[8];
+    uint8_t len;
+
+    if(MIL_CAN_FastRead(pmailbox->base,pmailbox->obj_num,data,&len) != MIL_CAN_OK){
+        return MIL_CAN_NOK;
+    }
+
+    if(len > pmailbox->msg_len){
+        len = pmailbox->msg_len;
+    }
+    for(uint8_t i = 0;i < len;i++){
+        pmailbox->buffer[i] = data[i];
+    }
+
+    return MIL_CAN_OK;
+
+}
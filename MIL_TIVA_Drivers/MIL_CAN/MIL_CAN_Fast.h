@@ -0,0 +1,116 @@
+/*
+ * Name: MIL_CAN_Fast.h
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Register level read and write for fixed mailboxes
+ *
+ * WHAT YOU NEED TO UNDERSTAND:
+ * The CPU never touches a message object directly, it goes through an
+ * interface register set(IF1 or IF2): load the ID, mask, control and
+ * data registers, write a command mask saying which parts to move, write
+ * the object number and wait for BUSY to drop.
+ *
+ * CANMessageSet and CANMessageGet move everything every time. Set
+ * rebuilds and writes the arbitration, mask and control registers and
+ * Get reads all of them back and decodes the ID and flags into the
+ * tCANMsgObject. For a mailbox whose ID, mask and length never change
+ * that's all wasted, only the data(and NEWDAT/TXRQST) is different frame
+ * to frame.
+ *
+ * These move only what changes:
+ *
+ *   MIL_CAN_FastWrite - data registers + TXRQST, the ID and DLC
+ *                       loaded by MIL_CAN_FastTxInit stay in the object
+ *   MIL_CAN_FastRead  - data and control registers, NEWDAT and INTPND
+ *                       cleared in the same transfer, no separate
+ *                       CANStatusGet needed to see if there's new data
+ *
+ * Examples/MIL_CAN_FastPath_DEMO.c times both against the driverlib
+ * calls with the cycle counter.
+ *
+ * HOW TO USE:
+ * transmit - MIL_CAN_FastTxInit(CAN1_BASE,5,0x38,8) once, then
+ *            MIL_CAN_FastWrite(CAN1_BASE,5,data,8) for every frame
+ *
+ * receive - set up the mailbox like normal(MIL_InitMailBox), then
+ *           if(MIL_CAN_FastRead(CAN1_BASE,box.obj_num,data,&len) == MIL_CAN_OK){...}
+ *           or MIL_CAN_FastGetMail(&box) as a drop in for MIL_CAN_GetMail
+ *
+ * Note: same rules as driverlib for who uses which interface, writes go
+ *       through IF1 and reads through IF2. Wrap calls in MIL_CAN_IfLock/
+ *       MIL_CAN_IfUnlock whenever a CAN ISR or another interrupt that
+ *       touches message objects could run(see MESSAGE OBJECT LOCKING in
+ *       MIL_CAN.h), the same goes for CANMessageSet
+ *
+ * Note: define MIL_CAN_FAST_DRIVERLIB to build these on top of
+ *       CANMessageSet/CANMessageGet instead(the simulator doesn't model
+ *       the interface registers)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "MIL_CAN.h"
+
+#ifndef MIL_CAN_FAST_H_
+#define MIL_CAN_FAST_H_
+
+/*
+ * Desc: loads a transmit object with a fixed ID and length without
+ *       sending anything
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * obj_num - message object to use(1 to 32)
+ * canid - 11 bit ID every frame from this object is sent with
+ * len - bytes in every frame(0 to 8)
+ */
+void MIL_CAN_FastTxInit(uint32_t base,uint8_t obj_num,uint32_t canid,uint8_t len);
+
+/*
+ * Desc: loads new data into a transmit object and requests a send
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * obj_num - object set up with MIL_CAN_FastTxInit
+ * pdata - your data
+ * len - bytes in pdata, should match MIL_CAN_FastTxInit(the length
+ *       sent is always the one from MIL_CAN_FastTxInit)
+ *
+ * Note: doesn't check if the last frame went out, if it hasn't it's
+ *       replaced by this one
+ */
+void MIL_CAN_FastWrite(uint32_t base,uint8_t obj_num,const uint8_t *pdata,uint8_t len);
+
+/*
+ * Desc: reads a receive object if it has new data
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * obj_num - receive object(1 to 32)
+ * pdata - where the data goes, room for 8 bytes
+ * plen - where the received length goes(can be 0)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if there was new data
+ *                    MIL_CAN_NOK if there is no data
+ *
+ * Note: MSGLST isn't cleared, use CANMessageGet on FIFO objects
+ */
+mil_can_status_t MIL_CAN_FastRead(uint32_t base,uint8_t obj_num,uint8_t *pdata,uint8_t *plen);
+
+/*
+ * Desc: MIL_CAN_GetMail on top of MIL_CAN_FastRead, data goes to the
+ *       mailbox buffer
+ *
+ * Parameters:
+ * pmailbox - a mailbox set up with MIL_InitMailBox
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if there was new data
+ *                    MIL_CAN_NOK if there is no data
+ *
+ * Note: at most msg_len bytes are copied to the buffer
+ */
+mil_can_status_t MIL_CAN_FastGetMail(MIL_CAN_MailBox_t *pmailbox);
+
+#endif /* MIL_CAN_FAST_H_ */
@@ -0,0 +1,294 @@
+/*
+ * Name: MIL_CAN_Filter.c
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Works out the hardware acceptance filters for you
+ *
+ * Notes: the merge is greedy. Every pass merges the two filters that
+ *        let the fewest unwanted IDs through, until the set fits in
+ *        the objects you gave it and no free merges are left
+ */
+
+/* INCLUDES */
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/can.h"
+
+//MIL includes
+#include "MIL_CAN_Filter.h"
+
+/*
+ * Desc: number of IDs a single (id,mask) pair lets through
+ */
+static uint32_t MIL_CAN_FilterSize(uint32_t filt_mask){
+
+    uint32_t dont_care = ~filt_mask & MIL_CAN_FILTER_ID_MASK;
+    uint32_t size = 1;
+
+    while(dont_care){
+        size <<= 1;
+        dont_care &= dont_care - 1;
+    }
+
+    return size;
+
+}
+
+/*
+ * Desc: true if canid gets through the filter
+ */
+static bool MIL_CAN_FilterMatch(const MIL_CAN_Filter_t *pfilt,uint32_t canid){
+
+    return ((canid ^ pfilt->canid) & pfilt->filt_mask) == 0;
+
+}
+
+/*
+ * Desc: smallest filter that lets through everything a and b do
+ */
+static MIL_CAN_Filter_t MIL_CAN_FilterMerge(const MIL_CAN_Filter_t *pa,const MIL_CAN_Filter_t *pb){
+
+    MIL_CAN_Filter_t merged;
+
+    merged.filt_mask = pa->filt_mask & pb->filt_mask & ~(pa->canid ^ pb->canid) & MIL_CAN_FILTER_ID_MASK;
+    merged.canid = pa->canid & merged.filt_mask;
+
+    return merged;
+
+}
+
+/*
+ * Desc: builds the smallest filter set that fits in max_objs objects
+ *
+ * Note: duplicate IDs are fine, IDs are cut down to 11 bits
+ *
+ * Parameters:
+ * pset - where the filter set is built
+ * pids - the IDs your node cares about
+ * num_ids - how many IDs(up to MIL_CAN_FILTER_MAX_IDS)
+ * max_objs - how many message objects you can spare(1 to 32)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if there are too many IDs, no IDs
+ *                    or max_objs is out of range
+ */
+mil_can_status_t MIL_CAN_FilterAlloc(MIL_CAN_FilterSet_t *pset,
+                                     const uint32_t *pids,
+                                     uint8_t num_ids,
+                                     uint8_t max_objs){
+
+    MIL_CAN_Filter_t work[MIL_CAN_FILTER_MAX_IDS];
+    uint8_t num_work = 0;
+
+    if((num_ids == 0) || (num_ids > MIL_CAN_FILTER_MAX_IDS) ||
+       (max_objs == 0) || (max_objs > 32)){
+        return MIL_CAN_NOK;
+    }
+
+    //sorted copy of the IDs without duplicates(insertion sort, lists are short)
+    pset->num_ids = 0;
+    for(uint8_t i = 0;i < num_ids;i++){
+
+        uint32_t canid = pids[i] & MIL_CAN_FILTER_ID_MASK;
+        uint8_t pos = pset->num_ids;
+
+        while((pos > 0) && (pset->ids[pos - 1] > canid)){
+            pos--;
+        }
+        if((pos > 0) && (pset->ids[pos - 1] == canid)){
+            continue;
+        }
+        for(uint8_t j = pset->num_ids;j > pos;j--){
+            pset->ids[j] = pset->ids[j - 1];
+        }
+        pset->ids[pos] = canid;
+        pset->num_ids++;
+
+    }
+
+    //start with an exact filter per ID
+    for(uint8_t i = 0;i < pset->num_ids;i++){
+        work[i].canid = pset->ids[i];
+        work[i].filt_mask = MIL_CAN_FILTER_ID_MASK;
+    }
+    num_work = pset->num_ids;
+
+    while(num_work > 1){
+
+        int32_t best_cost = INT32_MAX;
+        uint8_t best_a = 0;
+        uint8_t best_b = 0;
+
+        //find the merge that lets the least extra IDs through
+        for(uint8_t a = 0;a < num_work;a++){
+            for(uint8_t b = a + 1;b < num_work;b++){
+
+                MIL_CAN_Filter_t merged = MIL_CAN_FilterMerge(&work[a],&work[b]);
+                int32_t cost = (int32_t)MIL_CAN_FilterSize(merged.filt_mask)
+                             - (int32_t)MIL_CAN_FilterSize(work[a].filt_mask)
+                             - (int32_t)MIL_CAN_FilterSize(work[b].filt_mask);
+
+                if(cost < best_cost){
+                    best_cost = cost;
+                    best_a = a;
+                    best_b = b;
+                }
+
+            }
+        }
+
+        //stop once it fits and the next merge would cost something
+        if((num_work <= max_objs) && (best_cost > 0)){
+            break;
+        }
+
+        work[best_a] = MIL_CAN_FilterMerge(&work[best_a],&work[best_b]);
+        work[best_b] = work[--num_work];
+
+        //drop any filter the merged one now covers
+        for(uint8_t i = 0;i < num_work;i++){
+
+            if((i != best_a) &&
+               ((work[i].filt_mask & work[best_a].filt_mask) == work[best_a].filt_mask) &&
+               MIL_CAN_FilterMatch(&work[best_a],work[i].canid)){
+
+                work[i] = work[--num_work];
+                if(best_a == num_work){best_a = i;}
+                i--;
+
+            }
+
+        }
+
+    }
+
+    pset->num_filters = num_work;
+    for(uint8_t i = 0;i < num_work;i++){
+        pset->filters[i] = work[i];
+    }
+
+    //count every ID the hardware will let through
+    pset->accepted_ids = 0;
+    for(uint32_t canid = 0;canid <= MIL_CAN_FILTER_ID_MASK;canid++){
+        for(uint8_t i = 0;i < pset->num_filters;i++){
+            if(MIL_CAN_FilterMatch(&pset->filters[i],canid)){
+                pset->accepted_ids++;
+                break;
+            }
+        }
+    }
+    pset->exact = (pset->accepted_ids == pset->num_ids);
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: software post filter, checks whether an ID is one you asked for
+ *
+ * Note: only needed when pset->exact is 0
+ *
+ * Returns:
+ * 1 if canid was in the list passed to MIL_CAN_FilterAlloc
+ */
+bool MIL_CAN_FilterAccept(const MIL_CAN_FilterSet_t *pset,uint32_t canid){
+
+    uint8_t lo = 0;
+    uint8_t hi = pset->num_ids;
+
+    //binary search of the sorted ID list
+    while(lo < hi){
+
+        uint8_t mid = (lo + hi) >> 1;
+
+        if(pset->ids[mid] == canid){return true;}
+        else if(pset->ids[mid] < canid){lo = mid + 1;}
+        else{hi = mid;}
+
+    }
+
+    return false;
+
+}
+
+/*
+ * Desc: expected share of bus traffic the hardware will throw away
+ *       before the CPU ever sees it
+ *
+ * Parameters:
+ * pset - a built filter set
+ * pbus_ids - IDs seen on the bus
+ * pbus_rates - rate of each of those IDs
+ * num_bus_ids - how many bus IDs
+ *
+ * Returns:
+ * 0.0 to 1.0, 1.0 meaning every frame is rejected in hardware
+ */
+float MIL_CAN_FilterRejectRatio(const MIL_CAN_FilterSet_t *pset,
+                                const uint32_t *pbus_ids,
+                                const uint32_t *pbus_rates,
+                                uint8_t num_bus_ids){
+
+    uint32_t total = 0;
+    uint32_t rejected = 0;
+
+    //no traffic model, every ID is equally likely
+    if(num_bus_ids == 0){
+        return 1.0f - ((float)pset->accepted_ids / (float)(MIL_CAN_FILTER_ID_MASK + 1));
+    }
+
+    for(uint8_t i = 0;i < num_bus_ids;i++){
+
+        bool hit = false;
+
+        for(uint8_t f = 0;f < pset->num_filters;f++){
+            if(MIL_CAN_FilterMatch(&pset->filters[f],pbus_ids[i] & MIL_CAN_FILTER_ID_MASK)){
+                hit = true;
+                break;
+            }
+        }
+
+        total += pbus_rates[i];
+        if(!hit){
+            rejected += pbus_rates[i];
+        }
+
+    }
+
+    if(total == 0){
+        return 0.0f;
+    }
+
+    return (float)rejected / (float)total;
+
+}
+
+/*
+ * Desc: fills out one mailbox per filter, ready for MIL_InitMailBox
+ *       or MIL_CAN_RxQueueAttach
+ *
+ * Note: msg_len is set to 8, rx_flag_int to 0 and buffer is left alone
+ *
+ * Parameters:
+ * pset - a built filter set
+ * pmailboxes - array of at least pset->num_filters mailboxes
+ * base - CAN0_BASE or CAN1_BASE
+ * first_obj - object number for the first mailbox, the rest follow it
+ */
+void MIL_CAN_FilterToMailBoxes(const MIL_CAN_FilterSet_t *pset,
+                               MIL_CAN_MailBox_t *pmailboxes,
+                               uint32_t base,
+                               uint8_t first_obj){
+
+    for(uint8_t i = 0;i < pset->num_filters;i++){
+
+        pmailboxes[i].canid = pset->filters[i].canid;
+        pmailboxes[i].filt_mask = pset->filters[i].filt_mask;
+        pmailboxes[i].base = base;
+        pmailboxes[i].msg_len = 8;
+        pmailboxes[i].obj_num = first_obj + i;
+        pmailboxes[i].rx_flag_int = 0;
+
+    }
+
+}
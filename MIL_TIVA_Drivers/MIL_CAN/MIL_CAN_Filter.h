@@ -0,0 +1,163 @@
+/*
+ * Name: MIL_CAN_Filter.h
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Works out the hardware acceptance filters for you
+ *
+ * WHAT YOU NEED TO UNDERSTAND:
+ * Each message object has one ID and one mask. A frame gets into the
+ * object if every bit set in the mask matches between the frame's ID
+ * and the object's ID. The TIVA only has 32 objects, so once a node
+ * cares about a lot of IDs people either run out of objects or set the
+ * mask to 0x00, which makes the CPU look at every frame on the bus.
+ *
+ * These functions take the list of IDs your node cares about and merge
+ * them into as few (id,mask) pairs as will fit in the objects you give it,
+ * picking the merges that let the least unwanted IDs through. Merges that
+ * let nothing extra through are always taken, so you usually end up with
+ * spare objects.
+ *
+ * If a merge had to let extra IDs through, MIL_CAN_FilterAccept will
+ * throw those frames away in software.
+ *
+ * HOW TO USE:
+ * uint32_t ids[] = {0x37,0x38,0x41,0x42};
+ * MIL_CAN_FilterSet_t filters;
+ * MIL_CAN_MailBox_t boxes[4];
+ *
+ * MIL_CAN_FilterAlloc(&filters,ids,4,4);
+ * MIL_CAN_FilterToMailBoxes(&filters,boxes,CAN1_BASE,1);
+ * for(uint8_t i = 0;i < filters.num_filters;i++){
+ *     MIL_CAN_RxQueueAttach(&boxes[i]);
+ * }
+ *
+ * then for every frame you pull out of the queue
+ * if(filters.exact || MIL_CAN_FilterAccept(&filters,frame.canid)){...}
+ *
+ * Note: all of this assumes standard 11 bit IDs
+ */
+
+#include "MIL_CAN.h"
+
+#ifndef MIL_CAN_FILTER_H_
+#define MIL_CAN_FILTER_H_
+
+//standard CAN IDs are 11 bits
+#define MIL_CAN_FILTER_ID_BITS 11
+#define MIL_CAN_FILTER_ID_MASK 0x7FF
+
+/*
+ * Desc: most IDs a filter set can be built from
+ *
+ * Note: each ID costs 4 bytes in the filter set
+ */
+#ifndef MIL_CAN_FILTER_MAX_IDS
+#define MIL_CAN_FILTER_MAX_IDS 64
+#endif
+
+/*
+ * Desc: one hardware acceptance filter
+ *
+ * PARAMETERS:
+ * canid - ID to compare against
+ * filt_mask - which bits of canid matter
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint32_t filt_mask;
+
+} MIL_CAN_Filter_t;
+
+/*
+ * Desc: the result of MIL_CAN_FilterAlloc
+ *
+ * PARAMETERS:
+ * filters - the (id,mask) pairs to load into message objects
+ * num_filters - how many of them are used
+ * ids - the IDs you asked for, sorted(used for software filtering)
+ * num_ids - how many of them there are
+ * accepted_ids - how many of the 2048 possible IDs the filters let through
+ * exact - 1 if the filters let through only the IDs you asked for
+ */
+typedef struct{
+
+  MIL_CAN_Filter_t filters[32];
+  uint8_t  num_filters;
+  uint32_t ids[MIL_CAN_FILTER_MAX_IDS];
+  uint8_t  num_ids;
+  uint32_t accepted_ids;
+  uint8_t  exact;
+
+} MIL_CAN_FilterSet_t;
+
+/*
+ * Desc: builds the smallest filter set that fits in max_objs objects
+ *
+ * Note: duplicate IDs are fine, IDs are cut down to 11 bits
+ *
+ * Parameters:
+ * pset - where the filter set is built
+ * pids - the IDs your node cares about
+ * num_ids - how many IDs(up to MIL_CAN_FILTER_MAX_IDS)
+ * max_objs - how many message objects you can spare(1 to 32)
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if there are too many IDs, no IDs
+ *                    or max_objs is out of range
+ */
+mil_can_status_t MIL_CAN_FilterAlloc(MIL_CAN_FilterSet_t *pset,
+                                     const uint32_t *pids,
+                                     uint8_t num_ids,
+                                     uint8_t max_objs);
+
+/*
+ * Desc: software post filter, checks whether an ID is one you asked for
+ *
+ * Note: only needed when pset->exact is 0
+ *
+ * Returns:
+ * 1 if canid was in the list passed to MIL_CAN_FilterAlloc
+ */
+bool MIL_CAN_FilterAccept(const MIL_CAN_FilterSet_t *pset,uint32_t canid);
+
+/*
+ * Desc: expected share of bus traffic the hardware will throw away
+ *       before the CPU ever sees it
+ *
+ * Note: pass in every ID on the bus with how often it's sent(any unit,
+ *       frames per second works). With no bus IDs(num_bus_ids = 0) every
+ *       possible ID is treated as equally likely
+ *
+ * Parameters:
+ * pset - a built filter set
+ * pbus_ids - IDs seen on the bus
+ * pbus_rates - rate of each of those IDs
+ * num_bus_ids - how many bus IDs
+ *
+ * Returns:
+ * 0.0 to 1.0, 1.0 meaning every frame is rejected in hardware
+ */
+float MIL_CAN_FilterRejectRatio(const MIL_CAN_FilterSet_t *pset,
+                                const uint32_t *pbus_ids,
+                                const uint32_t *pbus_rates,
+                                uint8_t num_bus_ids);
+
+/*
+ * Desc: fills out one mailbox per filter, ready for MIL_InitMailBox
+ *       or MIL_CAN_RxQueueAttach
+ *
+ * Note: msg_len is set to 8, rx_flag_int to 0 and buffer is left alone
+ *
+ * Parameters:
+ * pset - a built filter set
+ * pmailboxes - array of at least pset->num_filters mailboxes
+ * base - CAN0_BASE or CAN1_BASE
+ * first_obj - object number for the first mailbox, the rest follow it
+ */
+void MIL_CAN_FilterToMailBoxes(const MIL_CAN_FilterSet_t *pset,
+                               MIL_CAN_MailBox_t *pmailboxes,
+                               uint32_t base,
+                               uint8_t first_obj);
+
+#endif /* MIL_CAN_FILTER_H_ */
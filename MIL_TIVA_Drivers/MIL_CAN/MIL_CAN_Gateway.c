@@ -0,0 +1,235 @@
+/*
+ * Name: MIL_CAN_Gateway.c
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Forwarding and redundancy between CAN0 and CAN1
+ *
+ * Notes: everything here runs in the receive hook of the CAN ISRs
+ *
+ *        a forwarded frame is copied twice in RAM, the ISR reads it out of
+ *        the message object onto its stack for the hook, and
+ *        MIL_CAN_TxClassSend copies it into the other module's transmit
+ *        class. It never goes through this board's receive queue
+ */
+
+/* INCLUDES */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/can.h"
+
+//MIL includes
+#include "MIL_CAN.h"
+#include "MIL_CAN_Gateway.h"
+
+typedef struct{
+
+    uint32_t canid;
+    uint32_t time_us;
+    uint8_t  len;
+    uint8_t  bus;
+    uint8_t  used;
+    uint8_t  data[8];
+
+}mil_can_gw_seen_t;
+
+static const MIL_CAN_GwRoute_t *MIL_CAN_GwRoutes;
+static uint8_t MIL_CAN_GwNumRoutes;
+static mil_can_tx_class_t MIL_CAN_GwClass;
+static uint32_t (*MIL_CAN_GwTime)(void);
+static uint32_t MIL_CAN_GwWindow;
+static mil_can_gw_seen_t MIL_CAN_GwSeen[MIL_CAN_GW_DEDUP_SLOTS];
+static uint8_t MIL_CAN_GwSeenNext;
+static MIL_CAN_GwStats_t MIL_CAN_GwStats;
+
+static bool MIL_CAN_GwSameFrame(const mil_can_gw_seen_t *pseen,const MIL_CAN_Frame_t *pframe){
+
+    if((pseen->canid != pframe->canid) || (pseen->len != pframe->len)){
+        return false;
+    }
+
+    for(uint8_t i = 0;i < pframe->len;i++){
+        if(pseen->data[i] != pframe->data[i]){
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+/*
+ * Desc: decides whether a redundant frame is the second copy
+ *
+ * Returns:
+ * bool - true if it's a duplicate and should be dropped
+ */
+static bool MIL_CAN_GwDedup(uint8_t bus,const MIL_CAN_Frame_t *pframe){
+
+    uint32_t now = MIL_CAN_GwTime();
+    mil_can_gw_seen_t *pseen;
+
+    for(uint8_t i = 0;i < MIL_CAN_GW_DEDUP_SLOTS;i++){
+
+        pseen = &MIL_CAN_GwSeen[i];
+
+        if(!pseen->used){
+            continue;
+        }
+
+        //too old to be anybody's copy
+        if((now - pseen->time_us) > MIL_CAN_GwWindow){
+            pseen->used = 0;
+            continue;
+        }
+
+        if((pseen->bus != bus) && MIL_CAN_GwSameFrame(pseen,pframe)){
+            //each first copy cancels exactly one second copy
+            pseen->used = 0;
+            MIL_CAN_GwStats.dup_dropped++;
+            return true;
+        }
+
+    }
+
+    //first copy, remember it(round robin, the oldest entry goes)
+    pseen = &MIL_CAN_GwSeen[MIL_CAN_GwSeenNext];
+    MIL_CAN_GwSeenNext = (MIL_CAN_GwSeenNext + 1) % MIL_CAN_GW_DEDUP_SLOTS;
+
+    if(pseen->used && ((now - pseen->time_us) <= MIL_CAN_GwWindow)){
+        MIL_CAN_GwStats.dedup_evicted++;
+    }
+
+    pseen->canid = pframe->canid;
+    pseen->len = pframe->len;
+    pseen->bus = bus;
+    pseen->time_us = now;
+    for(uint8_t i = 0;i < pframe->len;i++){
+        pseen->data[i] = pframe->data[i];
+    }
+    pseen->used = 1;
+
+    return false;
+
+}
+
+/*
+ * Desc: receive hook installed on both modules
+ */
+static bool MIL_CAN_GwHook(uint32_t base,MIL_CAN_Frame_t *pframe){
+
+    uint8_t bus = (base == CAN1_BASE) ? 1 : 0;
+    uint8_t dir_flag = bus ? MIL_CAN_GW_1TO0 : MIL_CAN_GW_0TO1;
+    uint32_t other = bus ? CAN0_BASE : CAN1_BASE;
+
+    for(uint8_t i = 0;i < MIL_CAN_GwNumRoutes;i++){
+
+        const MIL_CAN_GwRoute_t *proute = &MIL_CAN_GwRoutes[i];
+        uint32_t id = pframe->canid & proute->mask;
+
+        if((id < proute->first_id) || (id > proute->last_id)){
+            continue;
+        }
+
+        if(proute->flags & MIL_CAN_GW_REDUNDANT){
+            return MIL_CAN_GwDedup(bus,pframe);
+        }
+
+        if(!(proute->flags & dir_flag)){
+            return false;
+        }
+
+        //from the ISR's copy into the other module's transmit class
+        if(MIL_CAN_TxClassSend(other,MIL_CAN_GwClass,pframe->canid,pframe->data,pframe->len) == MIL_CAN_OK){
+            MIL_CAN_GwStats.forwarded[bus]++;
+        }
+        else{
+            MIL_CAN_GwStats.fwd_dropped++;
+        }
+
+        return !(proute->flags & MIL_CAN_GW_KEEP);
+
+    }
+
+    return false;
+
+}
+
+/*
+ * Desc: starts the gateway on both modules
+ *
+ * Parameters:
+ * proutes - route table(not copied, keep it around, const is fine)
+ * num_routes - number of routes
+ * fwd_class - transmit class forwarded frames go out in
+ * time_us - function returning a free running microsecond count
+ * window_us - how long after the first copy of a redundant frame the
+ *             second one is still recognized(a couple frame times
+ *             plus the worst queueing delay on the slower bus)
+ */
+void MIL_CAN_GwInit(const MIL_CAN_GwRoute_t *proutes,uint8_t num_routes,mil_can_tx_class_t fwd_class,
+                    uint32_t (*time_us)(void),uint32_t window_us){
+
+    MIL_CAN_GwStop();
+
+    MIL_CAN_GwRoutes = proutes;
+    MIL_CAN_GwNumRoutes = num_routes;
+    MIL_CAN_GwClass = fwd_class;
+    MIL_CAN_GwTime = time_us;
+    MIL_CAN_GwWindow = window_us;
+    MIL_CAN_GwSeenNext = 0;
+
+    for(uint8_t i = 0;i < MIL_CAN_GW_DEDUP_SLOTS;i++){
+        MIL_CAN_GwSeen[i].used = 0;
+    }
+
+    MIL_CAN_GwStats.forwarded[0] = 0;
+    MIL_CAN_GwStats.forwarded[1] = 0;
+    MIL_CAN_GwStats.fwd_dropped = 0;
+    MIL_CAN_GwStats.dup_dropped = 0;
+    MIL_CAN_GwStats.dedup_evicted = 0;
+
+    MIL_CAN_RxHookSet(CAN0_BASE,MIL_CAN_GwHook);
+    MIL_CAN_RxHookSet(CAN1_BASE,MIL_CAN_GwHook);
+
+}
+
+/*
+ * Desc: stops forwarding and dedup on both modules
+ */
+void MIL_CAN_GwStop(void){
+
+    MIL_CAN_RxHookSet(CAN0_BASE,0);
+    MIL_CAN_RxHookSet(CAN1_BASE,0);
+
+}
+
+/*
+ * Desc: sends a frame on both buses
+ *
+ * Parameters:
+ * tx_class - class to send in on both modules(not the forwarding class)
+ * canid - ID to send with
+ * pMsg - pointer to your message(copied)
+ * MsgLen - up to 8 bytes
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if at least one bus took it
+ */
+mil_can_status_t MIL_CAN_GwSendBoth(mil_can_tx_class_t tx_class,uint32_t canid,const uint8_t *pMsg,uint8_t MsgLen){
+
+    mil_can_status_t stat0 = MIL_CAN_TxClassSend(CAN0_BASE,tx_class,canid,pMsg,MsgLen);
+    mil_can_status_t stat1 = MIL_CAN_TxClassSend(CAN1_BASE,tx_class,canid,pMsg,MsgLen);
+
+    return ((stat0 == MIL_CAN_OK) || (stat1 == MIL_CAN_OK)) ? MIL_CAN_OK : MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: copies out the gateway counters
+ */
+void MIL_CAN_GwStatsGet(MIL_CAN_GwStats_t *pstats){
+
+    *pstats = MIL_CAN_GwStats;
+
+}
@@ -0,0 +1,141 @@
+/*
+ * Name: MIL_CAN_Gateway.h
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Forwarding and redundancy between CAN0 and CAN1
+ *
+ * WHAT THIS IS FOR:
+ * The TM4C123 has two CAN controllers and MIL_InitCAN can bring up both
+ * (CAN0 on ports B/E/F, CAN1 on port A). This uses them together:
+ *
+ * GATEWAY - frames that match a route are forwarded to the other bus
+ *           straight from the CAN ISR, so two bus segments(say the
+ *           thruster bus and the sensor bus) can share traffic without
+ *           the main loop doing anything
+ *
+ * REDUNDANT - critical frames are sent on both buses with
+ *             MIL_CAN_GwSendBoth, and receivers take whichever copy shows
+ *             up first and throw away the second, so losing one bus
+ *             doesn't lose the kill command
+ *
+ * ROUTES:
+ * A route matches a frame when first_id <= (canid & mask) <= last_id,
+ * so {0x100,0x1FF,0x7FF} is a range and {0x30,0x30,0xF0} matches group 3
+ * of the MIL_CAN_ID scheme. The first route that matches decides, frames
+ * that match no route just go into the receive queue like always.
+ *
+ * Route flags:
+ * MIL_CAN_GW_0TO1 - forward frames from CAN0 onto CAN1
+ * MIL_CAN_GW_1TO0 - forward frames from CAN1 onto CAN0
+ * MIL_CAN_GW_KEEP - also put forwarded frames in this board's receive queue
+ * MIL_CAN_GW_REDUNDANT - the frame is sent on both buses, pass the first
+ *                        copy up and drop the second(never forwarded)
+ *
+ * A second copy is a frame with the same ID and data that arrives on the
+ * other bus within the dedup window. If the same value is legitimately
+ * sent twice in a row faster than the window, put a counter in the data.
+ *
+ * HOW TO USE:
+ * 1) MIL_InitCAN both modules
+ * 2) set up the receive queue on both(MIL_CAN_RxQueueInit, attach
+ *    mailboxes or FIFOs covering every routed ID)
+ * 3) MIL_CAN_TxClassInit the class forwarded frames go out in on both
+ *    modules, don't send in that class from anywhere else
+ * 4) MIL_CAN_GwInit(routes,num_routes,class,time_us,window_us)
+ * 5) MIL_CANIntEnable(MIL_CAN0_ISR,CAN0_BASE) and the same for CAN1
+ *
+ *      static const MIL_CAN_GwRoute_t routes[] = {
+ *          {0x100,0x1FF,0x7FF,MIL_CAN_GW_0TO1},
+ *          {0x200,0x2FF,0x7FF,MIL_CAN_GW_1TO0 | MIL_CAN_GW_KEEP},
+ *          {0x000,0x00F,0x7FF,MIL_CAN_GW_REDUNDANT},
+ *      };
+ *
+ * Note: leave CAN0 and CAN1 at the same interrupt priority(the reset
+ *       default) so the two ISRs never interrupt each other, they share
+ *       the dedup table
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "MIL_CAN.h"
+
+#ifndef MIL_CAN_GATEWAY_H_
+#define MIL_CAN_GATEWAY_H_
+
+//frames remembered for dedup
+#ifndef MIL_CAN_GW_DEDUP_SLOTS
+#define MIL_CAN_GW_DEDUP_SLOTS 16
+#endif
+
+#define MIL_CAN_GW_0TO1      0x01
+#define MIL_CAN_GW_1TO0      0x02
+#define MIL_CAN_GW_KEEP      0x04
+#define MIL_CAN_GW_REDUNDANT 0x08
+
+typedef struct{
+
+  uint32_t first_id;
+  uint32_t last_id;
+  uint32_t mask;
+  uint8_t  flags;
+
+} MIL_CAN_GwRoute_t;
+
+/*
+ * Desc: gateway counters
+ *
+ * forwarded - frames forwarded, [0] CAN0 to CAN1, [1] CAN1 to CAN0
+ * fwd_dropped - frames that couldn't be forwarded(transmit class full)
+ * dup_dropped - second copies of redundant frames thrown away
+ * dedup_evicted - redundant frames forgotten before their copy arrived
+ *                 (raise MIL_CAN_GW_DEDUP_SLOTS if this climbs)
+ */
+typedef struct{
+
+  uint32_t forwarded[2];
+  uint32_t fwd_dropped;
+  uint32_t dup_dropped;
+  uint32_t dedup_evicted;
+
+} MIL_CAN_GwStats_t;
+
+/*
+ * Desc: starts the gateway on both modules
+ *
+ * Parameters:
+ * proutes - route table(not copied, keep it around, const is fine)
+ * num_routes - number of routes
+ * fwd_class - transmit class forwarded frames go out in
+ * time_us - function returning a free running microsecond count
+ * window_us - how long after the first copy of a redundant frame the
+ *             second one is still recognized(a couple frame times
+ *             plus the worst queueing delay on the slower bus)
+ */
+void MIL_CAN_GwInit(const MIL_CAN_GwRoute_t *proutes,uint8_t num_routes,mil_can_tx_class_t fwd_class,
+                    uint32_t (*time_us)(void),uint32_t window_us);
+
+/*
+ * Desc: stops forwarding and dedup on both modules
+ */
+void MIL_CAN_GwStop(void);
+
+/*
+ * Desc: sends a frame on both buses
+ *
+ * Parameters:
+ * tx_class - class to send in on both modules(not the forwarding class)
+ * canid - ID to send with
+ * pMsg - pointer to your message(copied)
+ * MsgLen - up to 8 bytes
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if at least one bus took it
+ */
+mil_can_status_t MIL_CAN_GwSendBoth(mil_can_tx_class_t tx_class,uint32_t canid,const uint8_t *pMsg,uint8_t MsgLen);
+
+/*
+ * Desc: copies out the gateway counters
+ */
+void MIL_CAN_GwStatsGet(MIL_CAN_GwStats_t *pstats);
+
+#endif /* MIL_CAN_GATEWAY_H_ */
@@ -0,0 +1,571 @@
+/*
+ * Name: MIL_CAN_IsoTp.c
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: ISO-TP style segmentation and reassembly on top of MIL_CAN
+ *
+ * Notes: everything here runs from the main loop, the only thing shared
+ *        with the CAN ISR is the transmit queue which handles that itself
+ *
+ *        frames are sent with the shortest DLC that fits instead of being
+ *        padded to 8 bytes, that's less bus time on every last frame and
+ *        flow control frame
+ */
+
+/* INCLUDES */
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/can.h"
+
+//MIL includes
+#include "MIL_CAN.h"
+#include "MIL_CAN_IsoTp.h"
+
+#if MIL_CAN_ISOTP_POOL_BUFS < 1 || MIL_CAN_ISOTP_POOL_BUFS > 32
+#error "MIL_CAN_ISOTP_POOL_BUFS must be 1 to 32"
+#endif
+
+#if MIL_CAN_ISOTP_FC_RESERVE >= MIL_CAN_TXQ_SIZE
+#error "MIL_CAN_ISOTP_FC_RESERVE must be smaller than MIL_CAN_TXQ_SIZE"
+#endif
+
+#if MIL_CAN_ISOTP_BUF_SIZE > MIL_CAN_ISOTP_MAX_LEN
+#error "MIL_CAN_ISOTP_BUF_SIZE can't be bigger than MIL_CAN_ISOTP_MAX_LEN"
+#endif
+
+//protocol control info, upper nibble of the first byte
+#define MIL_CAN_ISOTP_SF 0x00   //single frame
+#define MIL_CAN_ISOTP_FF 0x10   //first frame
+#define MIL_CAN_ISOTP_CF 0x20   //consecutive frame
+#define MIL_CAN_ISOTP_FC 0x30   //flow control
+
+//flow status, lower nibble of a flow control frame
+#define MIL_CAN_ISOTP_FS_CTS   0x00   //continue to send
+#define MIL_CAN_ISOTP_FS_WAIT  0x01
+#define MIL_CAN_ISOTP_FS_OVFLW 0x02
+
+//transmit states
+#define MIL_CAN_ISOTP_TX_IDLE    0
+#define MIL_CAN_ISOTP_TX_WAIT_FC 1
+#define MIL_CAN_ISOTP_TX_SEND_CF 2
+
+static uint32_t (*MIL_CAN_IsoTpTime)(void);
+static MIL_CAN_IsoTpChan_t *MIL_CAN_IsoTpChans[MIL_CAN_ISOTP_MAX_CHANNELS];
+static uint8_t MIL_CAN_IsoTpNumChans;
+
+static uint8_t MIL_CAN_IsoTpPool[MIL_CAN_ISOTP_POOL_BUFS][MIL_CAN_ISOTP_BUF_SIZE];
+static uint32_t MIL_CAN_IsoTpPoolFree;
+
+/*
+ * Desc: reassembly buffer pool
+ */
+static uint8_t *MIL_CAN_IsoTpAlloc(void){
+
+    uint8_t i;
+
+    if(MIL_CAN_IsoTpPoolFree == 0){
+        return 0;
+    }
+
+    for(i = 0;!(MIL_CAN_IsoTpPoolFree & (1UL << i));i++);
+
+    MIL_CAN_IsoTpPoolFree &= ~(1UL << i);
+
+    return MIL_CAN_IsoTpPool[i];
+
+}
+
+static void MIL_CAN_IsoTpFree(uint8_t *pbuf){
+
+    uint32_t i = (uint32_t)(pbuf - &MIL_CAN_IsoTpPool[0][0]) / MIL_CAN_ISOTP_BUF_SIZE;
+
+    MIL_CAN_IsoTpPoolFree |= 1UL << i;
+
+}
+
+/*
+ * Desc: STmin byte to microseconds, reserved values are read as the
+ *       longest gap like the standard asks
+ */
+static uint32_t MIL_CAN_IsoTpStMin(uint8_t st_min){
+
+    if(st_min <= 0x7F){
+        return (uint32_t)st_min * 1000;
+    }
+
+    if((st_min >= 0xF1) && (st_min <= 0xF9)){
+        return (uint32_t)(st_min - 0xF0) * 100;
+    }
+
+    return 127000;
+
+}
+
+/*
+ * Desc: queues a flow control frame, if the transmit queue is full it's
+ *       kept on the channel and MIL_CAN_IsoTpService retries it
+ *
+ * Note: a newer flow control replaces one still waiting, only the
+ *       latest one means anything to the sender
+ */
+static void MIL_CAN_IsoTpSendFC(MIL_CAN_IsoTpChan_t *pchan,uint8_t flow_status){
+
+    uint8_t data[3];
+
+    pchan->rx_fc = MIL_CAN_ISOTP_FC | flow_status;
+
+    //checked first so a full queue doesn't count a drop on every retry
+    if(MIL_CAN_TxQueueCount(pchan->base) >= MIL_CAN_TXQ_SIZE){
+        return;
+    }
+
+    data[0] = pchan->rx_fc;
+    data[1] = pchan->block_size;
+    data[2] = pchan->st_min;
+
+    if(MIL_CAN_TxQueueSend(pchan->base,pchan->tx_id,data,3) == MIL_CAN_OK){
+        pchan->rx_fc = 0;
+    }
+
+}
+
+static void MIL_CAN_IsoTpRxAbort(MIL_CAN_IsoTpChan_t *pchan){
+
+    MIL_CAN_IsoTpFree(pchan->rx_buf);
+    pchan->rx_buf = 0;
+    pchan->err_count++;
+
+}
+
+/*
+ * Desc: queues the next consecutive frame, MIL_CAN_ISOTP_FC_RESERVE
+ *       queue slots are left for flow control
+ */
+static mil_can_status_t MIL_CAN_IsoTpSendCF(MIL_CAN_IsoTpChan_t *pchan){
+
+    uint8_t data[8];
+    uint16_t left = pchan->tx_len - pchan->tx_pos;
+    uint8_t len = (left > 7) ? 7 : (uint8_t)left;
+
+    if(MIL_CAN_TxQueueCount(pchan->base) >= (MIL_CAN_TXQ_SIZE - MIL_CAN_ISOTP_FC_RESERVE)){
+        return MIL_CAN_NOK;
+    }
+
+    data[0] = MIL_CAN_ISOTP_CF | pchan->tx_sn;
+
+    for(uint8_t i = 0;i < len;i++){
+        data[i + 1] = pchan->tx_data[pchan->tx_pos + i];
+    }
+
+    if(MIL_CAN_TxQueueSend(pchan->base,pchan->tx_id,data,len + 1) == MIL_CAN_NOK){
+        return MIL_CAN_NOK;
+    }
+
+    pchan->tx_pos += len;
+    pchan->tx_sn = (pchan->tx_sn + 1) & 0x0F;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: queues the first frame
+ */
+static mil_can_status_t MIL_CAN_IsoTpSendFF(MIL_CAN_IsoTpChan_t *pchan){
+
+    uint8_t data[8];
+
+    data[0] = MIL_CAN_ISOTP_FF | (uint8_t)(pchan->tx_len >> 8);
+    data[1] = (uint8_t)pchan->tx_len;
+
+    for(uint8_t i = 0;i < 6;i++){
+        data[i + 2] = pchan->tx_data[i];
+    }
+
+    if(MIL_CAN_TxQueueSend(pchan->base,pchan->tx_id,data,8) == MIL_CAN_NOK){
+        return MIL_CAN_NOK;
+    }
+
+    pchan->tx_pos = 6;
+    pchan->tx_sn = 1;
+    pchan->tx_state = MIL_CAN_ISOTP_TX_WAIT_FC;
+    pchan->tx_time_us = MIL_CAN_IsoTpTime();
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: flow control frame from the receiver
+ */
+static void MIL_CAN_IsoTpRxFC(MIL_CAN_IsoTpChan_t *pchan,const MIL_CAN_Frame_t *pframe){
+
+    if((pchan->tx_state != MIL_CAN_ISOTP_TX_WAIT_FC) || (pframe->len < 3)){
+        return;
+    }
+
+    switch(pframe->data[0] & 0x0F){
+
+        case MIL_CAN_ISOTP_FS_CTS:
+            pchan->tx_bs = pframe->data[1];
+            pchan->tx_bs_left = pframe->data[1];
+            pchan->tx_stmin_us = MIL_CAN_IsoTpStMin(pframe->data[2]);
+            pchan->tx_state = MIL_CAN_ISOTP_TX_SEND_CF;
+            //first consecutive frame can go right away
+            pchan->tx_time_us = MIL_CAN_IsoTpTime() - pchan->tx_stmin_us;
+            break;
+
+        case MIL_CAN_ISOTP_FS_WAIT:
+            pchan->tx_time_us = MIL_CAN_IsoTpTime();
+            break;
+
+        default:
+            //overflow or garbage, the receiver can't take it
+            pchan->tx_state = MIL_CAN_ISOTP_TX_IDLE;
+            pchan->err_count++;
+            break;
+
+    }
+
+}
+
+/*
+ * Desc: first frame from the sender
+ */
+static void MIL_CAN_IsoTpRxFF(MIL_CAN_IsoTpChan_t *pchan,const MIL_CAN_Frame_t *pframe){
+
+    uint16_t len;
+
+    if(pframe->len < 8){
+        return;
+    }
+
+    //a new first frame replaces whatever was in progress
+    if(pchan->rx_buf){
+        MIL_CAN_IsoTpRxAbort(pchan);
+    }
+
+    len = ((uint16_t)(pframe->data[0] & 0x0F) << 8) | pframe->data[1];
+
+    if((len <= 7) || (len > MIL_CAN_ISOTP_BUF_SIZE) || !(pchan->rx_buf = MIL_CAN_IsoTpAlloc())){
+        MIL_CAN_IsoTpSendFC(pchan,MIL_CAN_ISOTP_FS_OVFLW);
+        pchan->err_count++;
+        return;
+    }
+
+    for(uint8_t i = 0;i < 6;i++){
+        pchan->rx_buf[i] = pframe->data[i + 2];
+    }
+
+    pchan->rx_len = len;
+    pchan->rx_pos = 6;
+    pchan->rx_sn = 1;
+    pchan->rx_bs_left = pchan->block_size;
+    pchan->rx_time_us = MIL_CAN_IsoTpTime();
+
+    MIL_CAN_IsoTpSendFC(pchan,MIL_CAN_ISOTP_FS_CTS);
+
+}
+
+/*
+ * Desc: consecutive frame from the sender
+ */
+static void MIL_CAN_IsoTpRxCF(MIL_CAN_IsoTpChan_t *pchan,const MIL_CAN_Frame_t *pframe){
+
+    uint16_t left;
+    uint8_t len;
+
+    if(!pchan->rx_buf){
+        return;
+    }
+
+    //out of order means a frame got lost, the message is garbage
+    if((pframe->data[0] & 0x0F) != pchan->rx_sn){
+        MIL_CAN_IsoTpRxAbort(pchan);
+        return;
+    }
+
+    left = pchan->rx_len - pchan->rx_pos;
+    len = (left > 7) ? 7 : (uint8_t)left;
+
+    if(pframe->len < len + 1){
+        MIL_CAN_IsoTpRxAbort(pchan);
+        return;
+    }
+
+    for(uint8_t i = 0;i < len;i++){
+        pchan->rx_buf[pchan->rx_pos + i] = pframe->data[i + 1];
+    }
+
+    pchan->rx_pos += len;
+    pchan->rx_sn = (pchan->rx_sn + 1) & 0x0F;
+    pchan->rx_time_us = MIL_CAN_IsoTpTime();
+
+    if(pchan->rx_pos >= pchan->rx_len){
+
+        uint8_t *pbuf = pchan->rx_buf;
+
+        pchan->rx_buf = 0;
+        pchan->rx_count++;
+
+        if(pchan->rx_done){
+            pchan->rx_done(pchan,pbuf,pchan->rx_len);
+        }
+
+        MIL_CAN_IsoTpFree(pbuf);
+        return;
+
+    }
+
+    //end of a block, let the sender know it can keep going
+    if(pchan->block_size && (--pchan->rx_bs_left == 0)){
+        pchan->rx_bs_left = pchan->block_size;
+        MIL_CAN_IsoTpSendFC(pchan,MIL_CAN_ISOTP_FS_CTS);
+    }
+
+}
+
+/*
+ * Desc: closes every channel and frees every buffer
+ *
+ * Parameters:
+ * time_us - function returning a free running microsecond count
+ */
+void MIL_CAN_IsoTpInit(uint32_t (*time_us)(void)){
+
+    MIL_CAN_IsoTpTime = time_us;
+    MIL_CAN_IsoTpNumChans = 0;
+    MIL_CAN_IsoTpPoolFree = 0xFFFFFFFFUL >> (32 - MIL_CAN_ISOTP_POOL_BUFS);
+
+}
+
+/*
+ * Desc: opens a channel
+ *
+ * Parameters:
+ * pchan - a pointer to your configured channel
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if all channels are in use or
+ *                    another channel already listens on rx_id
+ */
+mil_can_status_t MIL_CAN_IsoTpOpen(MIL_CAN_IsoTpChan_t *pchan){
+
+    if(MIL_CAN_IsoTpNumChans >= MIL_CAN_ISOTP_MAX_CHANNELS){
+        return MIL_CAN_NOK;
+    }
+
+    for(uint8_t i = 0;i < MIL_CAN_IsoTpNumChans;i++){
+        if((MIL_CAN_IsoTpChans[i]->base == pchan->base) &&
+           (MIL_CAN_IsoTpChans[i]->rx_id == pchan->rx_id)){
+            return MIL_CAN_NOK;
+        }
+    }
+
+    pchan->tx_state = MIL_CAN_ISOTP_TX_IDLE;
+    pchan->rx_buf = 0;
+    pchan->rx_fc = 0;
+    pchan->tx_count = 0;
+    pchan->rx_count = 0;
+    pchan->err_count = 0;
+
+    MIL_CAN_IsoTpChans[MIL_CAN_IsoTpNumChans++] = pchan;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: starts sending a message, the rest is sent by MIL_CAN_IsoTpService
+ *
+ * Parameters:
+ * pchan - an open channel
+ * pdata - the message(not copied, keep it until the send finishes)
+ * len - 1 to 4095 bytes
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the channel is still sending,
+ *                    len is out of range or the transmit queue is full
+ */
+mil_can_status_t MIL_CAN_IsoTpSend(MIL_CAN_IsoTpChan_t *pchan,const uint8_t *pdata,uint16_t len){
+
+    uint8_t data[8];
+
+    if((pchan->tx_state != MIL_CAN_ISOTP_TX_IDLE) || (len == 0) || (len > MIL_CAN_ISOTP_MAX_LEN)){
+        return MIL_CAN_NOK;
+    }
+
+    //fits in a single frame
+    if(len <= 7){
+
+        data[0] = MIL_CAN_ISOTP_SF | (uint8_t)len;
+
+        for(uint8_t i = 0;i < len;i++){
+            data[i + 1] = pdata[i];
+        }
+
+        if(MIL_CAN_TxQueueSend(pchan->base,pchan->tx_id,data,len + 1) == MIL_CAN_NOK){
+            return MIL_CAN_NOK;
+        }
+
+        pchan->tx_count++;
+        return MIL_CAN_OK;
+
+    }
+
+    pchan->tx_data = pdata;
+    pchan->tx_len = len;
+
+    return MIL_CAN_IsoTpSendFF(pchan);
+
+}
+
+/*
+ * Desc: 1 while the channel is still sending a message
+ */
+bool MIL_CAN_IsoTpTxBusy(MIL_CAN_IsoTpChan_t *pchan){
+
+    return pchan->tx_state != MIL_CAN_ISOTP_TX_IDLE;
+
+}
+
+/*
+ * Desc: hands a received frame to ISO-TP
+ *
+ * Parameters:
+ * base - module the frame came in on
+ * pframe - the frame
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if the frame belonged to an open channel
+ *                    MIL_CAN_NOK if it's yours to handle
+ */
+mil_can_status_t MIL_CAN_IsoTpRx(uint32_t base,const MIL_CAN_Frame_t *pframe){
+
+    MIL_CAN_IsoTpChan_t *pchan = 0;
+    uint8_t len;
+
+    for(uint8_t i = 0;i < MIL_CAN_IsoTpNumChans;i++){
+        if((MIL_CAN_IsoTpChans[i]->base == base) &&
+           (MIL_CAN_IsoTpChans[i]->rx_id == pframe->canid)){
+            pchan = MIL_CAN_IsoTpChans[i];
+            break;
+        }
+    }
+
+    if(!pchan || (pframe->len == 0)){
+        return MIL_CAN_NOK;
+    }
+
+    switch(pframe->data[0] & 0xF0){
+
+        case MIL_CAN_ISOTP_SF:
+            len = pframe->data[0] & 0x0F;
+            if((len == 0) || (len > 7) || (pframe->len < len + 1)){
+                break;
+            }
+            pchan->rx_count++;
+            if(pchan->rx_done){
+                //single frames are handed straight out of the frame
+                pchan->rx_done(pchan,(uint8_t *)&pframe->data[1],len);
+            }
+            break;
+
+        case MIL_CAN_ISOTP_FF:
+            MIL_CAN_IsoTpRxFF(pchan,pframe);
+            break;
+
+        case MIL_CAN_ISOTP_CF:
+            MIL_CAN_IsoTpRxCF(pchan,pframe);
+            break;
+
+        case MIL_CAN_ISOTP_FC:
+            MIL_CAN_IsoTpRxFC(pchan,pframe);
+            break;
+
+        default:
+            break;
+
+    }
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: sends pending consecutive frames, retries flow control frames
+ *       that didn't fit in the transmit queue and handles timeouts
+ *
+ * Note: call this as often as you can, the faster it's called the
+ *       closer transfers get to full bus rate
+ *
+ *       consecutive frames never take the last MIL_CAN_ISOTP_FC_RESERVE
+ *       transmit queue slots
+ */
+void MIL_CAN_IsoTpService(void){
+
+    uint32_t now = MIL_CAN_IsoTpTime();
+
+    for(uint8_t i = 0;i < MIL_CAN_IsoTpNumChans;i++){
+
+        MIL_CAN_IsoTpChan_t *pchan = MIL_CAN_IsoTpChans[i];
+
+        //receive side, the sender went quiet
+        if(pchan->rx_buf && ((now - pchan->rx_time_us) > MIL_CAN_ISOTP_TIMEOUT_US)){
+            MIL_CAN_IsoTpRxAbort(pchan);
+        }
+
+        //a continue for a receive that's gone means nothing, an overflow still goes out
+        if((pchan->rx_fc == (MIL_CAN_ISOTP_FC | MIL_CAN_ISOTP_FS_CTS)) && !pchan->rx_buf){
+            pchan->rx_fc = 0;
+        }
+
+        if(pchan->rx_fc){
+            MIL_CAN_IsoTpSendFC(pchan,pchan->rx_fc & 0x0F);
+        }
+
+        switch(pchan->tx_state){
+
+            case MIL_CAN_ISOTP_TX_WAIT_FC:
+                if((now - pchan->tx_time_us) > MIL_CAN_ISOTP_TIMEOUT_US){
+                    pchan->tx_state = MIL_CAN_ISOTP_TX_IDLE;
+                    pchan->err_count++;
+                }
+                break;
+
+            case MIL_CAN_ISOTP_TX_SEND_CF:
+                /*
+                 * with no STmin keep filling the transmit queue until only
+                 * the flow control reserve is left so the bus never idles
+                 * between frames, otherwise send one frame every STmin
+                 */
+                while((now - pchan->tx_time_us) >= pchan->tx_stmin_us){
+
+                    if(MIL_CAN_IsoTpSendCF(pchan) == MIL_CAN_NOK){
+                        break;
+                    }
+
+                    pchan->tx_time_us = now;
+
+                    if(pchan->tx_pos >= pchan->tx_len){
+                        pchan->tx_state = MIL_CAN_ISOTP_TX_IDLE;
+                        pchan->tx_count++;
+                        break;
+                    }
+
+                    if(pchan->tx_bs && (--pchan->tx_bs_left == 0)){
+                        pchan->tx_state = MIL_CAN_ISOTP_TX_WAIT_FC;
+                        break;
+                    }
+
+                }
+                break;
+
+            default:
+                break;
+
+        }
+
+    }
+
+}
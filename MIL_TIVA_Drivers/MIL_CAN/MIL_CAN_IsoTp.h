@@ -0,0 +1,209 @@
+/*
+ * Name: MIL_CAN_IsoTp.h
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Sends and receives messages longer than 8 bytes over MIL_CAN
+ *
+ * WHAT THIS IS FOR:
+ * A classic CAN frame carries 8 bytes at most. Full ADC sequences or
+ * configuration blobs used to get hand split with whatever framing the
+ * author came up with. This follows the ISO-TP(ISO 15765-2) scheme so
+ * every board splits and rebuilds large messages the same way.
+ *
+ * HOW A TRANSFER LOOKS ON THE BUS:
+ * up to 7 bytes   - one single frame
+ * more than that  - first frame(total length + 6 bytes)
+ *                   the receiver answers with a flow control frame that
+ *                   says how many frames to send before waiting
+ *                   again(block size) and how long to wait between them(STmin)
+ *                   then consecutive frames of 7 bytes each
+ *
+ * CHANNELS:
+ * A channel is a pair of IDs. You send data and flow control on tx_id
+ * and listen for both on rx_id, so two boards talking to each other just
+ * have the IDs swapped. Every channel can be sending and receiving at the
+ * same time and all open channels run at once.
+ *
+ * HOW TO USE:
+ * 1) set up the transmit queue(MIL_CAN_TxQueueInit) and receive
+ *    queue(MIL_CAN_RxQueueInit/Attach) with a mailbox covering rx_id
+ * 2) MIL_CAN_IsoTpInit(your_microsecond_clock)
+ * 3) fill out a channel and MIL_CAN_IsoTpOpen(&chan)
+ * 4) in your main loop
+ *      while(MIL_CAN_RxQueueGet(base,&frame) == MIL_CAN_OK){
+ *          if(MIL_CAN_IsoTpRx(base,&frame) == MIL_CAN_NOK){
+ *              ...not ISO-TP, handle it yourself...
+ *          }
+ *      }
+ *      MIL_CAN_IsoTpService();
+ * 5) MIL_CAN_IsoTpSend(&chan,data,len) to send, data must stay untouched
+ *    until MIL_CAN_IsoTpTxBusy returns 0
+ *
+ * Received messages are handed to the channel's rx_done function, the
+ * buffer goes back to the pool once that function returns
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "MIL_CAN.h"
+
+#ifndef MIL_CAN_ISOTP_H_
+#define MIL_CAN_ISOTP_H_
+
+/*
+ * Desc: reassembly buffer pool, every receive in progress holds one buffer
+ *
+ * Note: costs BUFS * BUF_SIZE bytes of SRAM, messages longer than
+ *       BUF_SIZE are refused with an overflow flow control
+ */
+#ifndef MIL_CAN_ISOTP_POOL_BUFS
+#define MIL_CAN_ISOTP_POOL_BUFS 4
+#endif
+#ifndef MIL_CAN_ISOTP_BUF_SIZE
+#define MIL_CAN_ISOTP_BUF_SIZE 256
+#endif
+
+//most channels that can be open at once
+#ifndef MIL_CAN_ISOTP_MAX_CHANNELS
+#define MIL_CAN_ISOTP_MAX_CHANNELS 8
+#endif
+
+//how long to wait on the other side before giving up on a transfer
+#ifndef MIL_CAN_ISOTP_TIMEOUT_US
+#define MIL_CAN_ISOTP_TIMEOUT_US 1000000
+#endif
+
+/*
+ * Desc: transmit queue slots consecutive frames leave free so flow
+ *       control frames still get in while a transfer fills the queue
+ *
+ * Note: must be smaller than MIL_CAN_TXQ_SIZE
+ */
+#ifndef MIL_CAN_ISOTP_FC_RESERVE
+#define MIL_CAN_ISOTP_FC_RESERVE 1
+#endif
+
+//largest message a first frame can announce
+#define MIL_CAN_ISOTP_MAX_LEN 4095
+
+/*
+ * Desc: ISO-TP channel
+ *
+ * PARAMETERS(you configure these):
+ * base - TIVA CANx_BASE
+ * rx_id - ID data and flow control arrive on
+ * tx_id - ID data and flow control are sent on
+ * block_size - frames the other side may send before waiting for us
+ *              (0 = send everything without stopping)
+ * st_min - gap we ask the other side to leave between frames
+ *          0x00 to 0x7F = 0 to 127ms, 0xF1 to 0xF9 = 100 to 900us
+ *          0 = as fast as the bus allows
+ * rx_done - called with every complete received message(can be 0)
+ *
+ * COUNTERS(read only):
+ * tx_count - messages sent
+ * rx_count - messages received
+ * err_count - transfers dropped(timeouts, bad sequence, overflow)
+ *
+ * Everything else is state used by MIL_CAN_IsoTp, do not touch it
+ */
+typedef struct MIL_CAN_IsoTpChan_s{
+
+  uint32_t base;
+  uint32_t rx_id;
+  uint32_t tx_id;
+  uint8_t  block_size;
+  uint8_t  st_min;
+  void (*rx_done)(struct MIL_CAN_IsoTpChan_s *pchan,uint8_t *pdata,uint16_t len);
+
+  uint32_t tx_count;
+  uint32_t rx_count;
+  uint32_t err_count;
+
+  //transmit state
+  const uint8_t *tx_data;
+  uint16_t tx_len;
+  uint16_t tx_pos;
+  uint8_t  tx_state;
+  uint8_t  tx_sn;
+  uint8_t  tx_bs;
+  uint8_t  tx_bs_left;
+  uint32_t tx_stmin_us;
+  uint32_t tx_time_us;
+
+  //receive state
+  uint8_t *rx_buf;
+  uint16_t rx_len;
+  uint16_t rx_pos;
+  uint8_t  rx_sn;
+  uint8_t  rx_bs_left;
+  uint8_t  rx_fc;       //flow control byte still waiting for queue room, 0 = none
+  uint32_t rx_time_us;
+
+} MIL_CAN_IsoTpChan_t;
+
+/*
+ * Desc: closes every channel and frees every buffer
+ *
+ * Parameters:
+ * time_us - function returning a free running microsecond count
+ */
+void MIL_CAN_IsoTpInit(uint32_t (*time_us)(void));
+
+/*
+ * Desc: opens a channel
+ *
+ * Parameters:
+ * pchan - a pointer to your configured channel
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if all channels are in use or
+ *                    another channel already listens on rx_id
+ */
+mil_can_status_t MIL_CAN_IsoTpOpen(MIL_CAN_IsoTpChan_t *pchan);
+
+/*
+ * Desc: starts sending a message, the rest is sent by MIL_CAN_IsoTpService
+ *
+ * Parameters:
+ * pchan - an open channel
+ * pdata - the message(not copied, keep it until the send finishes)
+ * len - 1 to 4095 bytes
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the channel is still sending,
+ *                    len is out of range or the transmit queue is full
+ */
+mil_can_status_t MIL_CAN_IsoTpSend(MIL_CAN_IsoTpChan_t *pchan,const uint8_t *pdata,uint16_t len);
+
+/*
+ * Desc: 1 while the channel is still sending a message
+ */
+bool MIL_CAN_IsoTpTxBusy(MIL_CAN_IsoTpChan_t *pchan);
+
+/*
+ * Desc: hands a received frame to ISO-TP
+ *
+ * Parameters:
+ * base - module the frame came in on
+ * pframe - the frame
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if the frame belonged to an open channel
+ *                    MIL_CAN_NOK if it's yours to handle
+ */
+mil_can_status_t MIL_CAN_IsoTpRx(uint32_t base,const MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: sends pending consecutive frames, retries flow control frames
+ *       that didn't fit in the transmit queue and handles timeouts
+ *
+ * Note: call this as often as you can, the faster it's called the
+ *       closer transfers get to full bus rate
+ *
+ *       consecutive frames never take the last MIL_CAN_ISOTP_FC_RESERVE
+ *       transmit queue slots
+ */
+void MIL_CAN_IsoTpService(void);
+
+#endif /* MIL_CAN_ISOTP_H_ */
@@ -0,0 +1,255 @@
+/*
+ * Name: MIL_CAN_Sched.c
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Periodic CAN transmit scheduler run from a timer interrupt
+ *
+ * Notes: the tick loads message objects through IF1 like every other
+ *        CANMessageSet, so it takes the MIL_CAN message object lock and
+ *        MIL_CAN_SchedStart adds the timer to it
+ */
+
+/* INCLUDES */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/can.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+
+//MIL includes
+#include "MIL_CAN.h"
+#include "MIL_CAN_Sched.h"
+
+#if defined(__GNUC__)
+#define MIL_CAN_SCHED_BARRIER() __asm volatile("" ::: "memory")
+#else
+#define MIL_CAN_SCHED_BARRIER() __asm(" dmb")
+#endif
+
+static MIL_CAN_SchedMsg_t *MIL_CAN_SchedMsgs[MIL_CAN_SCHED_MAX_MSGS];
+static volatile uint8_t MIL_CAN_SchedNum;
+static volatile uint32_t MIL_CAN_SchedNow;
+static uint32_t MIL_CAN_SchedTimer;
+
+static uint16_t MIL_CAN_SchedGcd(uint16_t a,uint16_t b){
+
+    while(b){
+        uint16_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+
+}
+
+/*
+ * Desc: phase that collides least with what's already scheduled
+ *
+ * Every release of the new message meets a release of message m
+ * gcd/period_m of the time when their phases line up modulo the gcd,
+ * scaled by 2^16 so it stays in integers. Ties go to the earliest phase.
+ */
+static uint16_t MIL_CAN_SchedPickPhase(uint16_t period){
+
+    uint16_t best_phase = 0;
+    uint32_t best_cost = 0xFFFFFFFF;
+
+    for(uint16_t p = 0;p < period;p++){
+
+        uint32_t cost = 0;
+
+        for(uint8_t i = 0;i < MIL_CAN_SchedNum;i++){
+
+            MIL_CAN_SchedMsg_t *pother = MIL_CAN_SchedMsgs[i];
+            uint16_t g = MIL_CAN_SchedGcd(period,pother->period);
+
+            if((p % g) == (pother->phase % g)){
+                cost += ((uint32_t)g << 16) / pother->period;
+            }
+
+        }
+
+        if(cost < best_cost){
+            best_cost = cost;
+            best_phase = p;
+        }
+
+        if(cost == 0){
+            break;
+        }
+
+    }
+
+    return best_phase;
+
+}
+
+static void MIL_CAN_SchedTimerISR(void){
+
+    TimerIntClear(MIL_CAN_SchedTimer,TIMER_TIMA_TIMEOUT);
+    MIL_CAN_SchedTick();
+
+}
+
+/*
+ * Desc: adds a message to the schedule
+ *
+ * Parameters:
+ * pmsg - a pointer to your message, it has to stay around
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the schedule is full or the
+ *                    period/phase/object don't make sense
+ *
+ * Note: messages can be added while the scheduler is running, the
+ *       phase is counted from the start like everything else
+ */
+mil_can_status_t MIL_CAN_SchedAdd(MIL_CAN_SchedMsg_t *pmsg){
+
+    uint8_t num = MIL_CAN_SchedNum;
+    uint32_t now = MIL_CAN_SchedNow;
+
+    if((num >= MIL_CAN_SCHED_MAX_MSGS) || (pmsg->period == 0) ||
+       (pmsg->obj_num < 1) || (pmsg->obj_num > 32) || (pmsg->msg_len > 8)){
+        return MIL_CAN_NOK;
+    }
+
+    if(pmsg->phase == MIL_CAN_SCHED_AUTO_PHASE){
+        pmsg->phase = MIL_CAN_SchedPickPhase(pmsg->period);
+    }
+    else if(pmsg->phase >= pmsg->period){
+        return MIL_CAN_NOK;
+    }
+
+    pmsg->sent = 0;
+    pmsg->misses = 0;
+
+    pmsg->msg_obj.ui32MsgID = pmsg->canid;
+    pmsg->msg_obj.ui32MsgIDMask = 0;
+    pmsg->msg_obj.ui32Flags = MSG_OBJ_NO_FLAGS;
+    pmsg->msg_obj.ui32MsgLen = pmsg->msg_len;
+    pmsg->msg_obj.pui8MsgData = pmsg->buffer;
+
+    //first release on the next tick that matches the phase
+    pmsg->next = now + ((pmsg->phase + pmsg->period - (now % pmsg->period)) % pmsg->period);
+
+    //publish only once the message is filled in, the tick ISR may be running
+    MIL_CAN_SchedMsgs[num] = pmsg;
+    MIL_CAN_SCHED_BARRIER();
+    MIL_CAN_SchedNum = num + 1;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: sets up a timer to tick the scheduler
+ *
+ * Parameters:
+ * timer_base - TIMER0_BASE to TIMER5_BASE(timer A is used)
+ * tick_us - tick period in microseconds
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK for an unknown timer or if the message
+ *                    object lock is full
+ *
+ * Note: call MIL_ClkSetxxx first, the load value comes from the system clock
+ */
+mil_can_status_t MIL_CAN_SchedStart(uint32_t timer_base,uint32_t tick_us){
+
+    uint32_t periph;
+    uint32_t int_num;
+
+    switch(timer_base){
+        case TIMER0_BASE: periph = SYSCTL_PERIPH_TIMER0; int_num = INT_TIMER0A; break;
+        case TIMER1_BASE: periph = SYSCTL_PERIPH_TIMER1; int_num = INT_TIMER1A; break;
+        case TIMER2_BASE: periph = SYSCTL_PERIPH_TIMER2; int_num = INT_TIMER2A; break;
+        case TIMER3_BASE: periph = SYSCTL_PERIPH_TIMER3; int_num = INT_TIMER3A; break;
+        case TIMER4_BASE: periph = SYSCTL_PERIPH_TIMER4; int_num = INT_TIMER4A; break;
+        case TIMER5_BASE: periph = SYSCTL_PERIPH_TIMER5; int_num = INT_TIMER5A; break;
+        default: return MIL_CAN_NOK;
+    }
+
+    //main loop sends and the CAN ISRs have to be able to hold the tick off
+    if(MIL_CAN_IfLockAdd(int_num) != MIL_CAN_OK){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_SchedTimer = timer_base;
+
+    SysCtlPeripheralEnable(periph);
+    while(!SysCtlPeripheralReady(periph));
+
+    TimerConfigure(timer_base,TIMER_CFG_PERIODIC);
+    TimerLoadSet(timer_base,TIMER_A,(SysCtlClockGet() / 1000000) * tick_us - 1);
+    TimerIntRegister(timer_base,TIMER_A,MIL_CAN_SchedTimerISR);
+    TimerIntEnable(timer_base,TIMER_TIMA_TIMEOUT);
+    TimerEnable(timer_base,TIMER_A);
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: advances the scheduler one tick, sends whatever is due
+ *
+ * Note: MIL_CAN_SchedStart does this for you, only call it if
+ *       you're running the tick from your own timer ISR(and add that
+ *       ISR with MIL_CAN_IfLockAdd)
+ */
+void MIL_CAN_SchedTick(void){
+
+    uint32_t now = MIL_CAN_SchedNow;
+    uint8_t num = MIL_CAN_SchedNum;
+    uint32_t pending[2] = {0,0};
+    bool read[2] = {false,false};
+    uint32_t lock = MIL_CAN_IfLock();
+
+    for(uint8_t i = 0;i < num;i++){
+
+        MIL_CAN_SchedMsg_t *pmsg = MIL_CAN_SchedMsgs[i];
+        uint8_t idx = (pmsg->base == CAN1_BASE) ? 1 : 0;
+
+        if((int32_t)(now - pmsg->next) < 0){
+            continue;
+        }
+
+        //one register read per module per tick no matter how many are due
+        if(!read[idx]){
+            pending[idx] = CANStatusGet(pmsg->base,CAN_STS_TXREQUEST);
+            read[idx] = true;
+        }
+
+        if(pending[idx] & (1UL << (pmsg->obj_num - 1))){
+            pmsg->misses++;
+        }
+
+        CANMessageSet(pmsg->base,pmsg->obj_num,&pmsg->msg_obj,MSG_OBJ_TYPE_TX);
+        pmsg->sent++;
+        pmsg->next += pmsg->period;
+
+    }
+
+    MIL_CAN_IfUnlock(lock);
+
+    MIL_CAN_SchedNow = now + 1;
+
+}
+
+/*
+ * Desc: deadline misses across every scheduled message
+ */
+uint32_t MIL_CAN_SchedMisses(void){
+
+    uint32_t misses = 0;
+
+    for(uint8_t i = 0;i < MIL_CAN_SchedNum;i++){
+        misses += MIL_CAN_SchedMsgs[i]->misses;
+    }
+
+    return misses;
+
+}
@@ -0,0 +1,138 @@
+/*
+ * Name: MIL_CAN_Sched.h
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Periodic CAN transmit scheduler run from a timer interrupt
+ *
+ * WHAT THIS IS FOR:
+ * Status messages used to go out from each board's while(1) loop
+ * with MIL_CANSimpleTX. Every board boots at about the same time and
+ * loops at about the same rate so those messages end up in phase and
+ * hit the bus in bursts, the low priority ones losing arbitration
+ * over and over. This sends them from a timer tick instead and spreads
+ * their start times(phase) so the bus load stays flat.
+ *
+ * HOW IT WORKS:
+ * Time is counted in ticks(the timer period, 1ms is a good choice).
+ * A message goes out every period ticks, phase ticks after the
+ * scheduler started. Leave phase at MIL_CAN_SCHED_AUTO_PHASE and the
+ * scheduler picks the phase that collides least with the messages
+ * already registered. Two periodic messages land on the same tick
+ * whenever their phases match modulo the gcd of their periods, so
+ * that's what it counts.
+ *
+ * Every message gets its own message object. If the object is still
+ * waiting to transmit when the message is due again the frame missed
+ * its deadline(it spent a whole period losing arbitration or the bus
+ * is down), that gets counted and the old frame is replaced by the
+ * new one since only the newest value is worth sending.
+ *
+ * HOW TO USE:
+ * 1) MIL_InitCAN
+ * 2) fill out a MIL_CAN_SchedMsg_t per message and MIL_CAN_SchedAdd it
+ * 3) MIL_CAN_SchedStart(TIMER0_BASE,1000) for a 1ms tick
+ *    (or call MIL_CAN_SchedTick from a timer ISR of your own and add
+ *    that interrupt with MIL_CAN_IfLockAdd(INT_TIMERxA))
+ * 4) write new data into the buffers whenever you like, the newest
+ *    contents go out at the next period
+ *
+ * NOTE: the buffer is copied in the timer ISR, if a message has to
+ *       be consistent across bytes update it with the timer
+ *       interrupt masked
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/can.h"
+#include "MIL_CAN.h"
+
+#ifndef MIL_CAN_SCHED_H_
+#define MIL_CAN_SCHED_H_
+
+#ifndef MIL_CAN_SCHED_MAX_MSGS
+#define MIL_CAN_SCHED_MAX_MSGS 16
+#endif
+
+//let the scheduler pick the phase
+#define MIL_CAN_SCHED_AUTO_PHASE 0xFFFF
+
+/*
+ * Desc: a periodic message
+ *
+ * PARAMETERS(you configure these):
+ * canid - ID to send with
+ * base - TIVA CANx_BASE
+ * obj_num - message object reserved for this message(1 to 32)
+ * msg_len - bytes per frame(0 to 8)
+ * buffer - the data to send
+ * period - ticks between frames(1 or more)
+ * phase - ticks after start of the first frame(less than period)
+ *         or MIL_CAN_SCHED_AUTO_PHASE
+ *
+ * COUNTERS(read only):
+ * sent - frames handed to the controller
+ * misses - times the previous frame was still waiting when the next was due
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint32_t base;
+  uint8_t  obj_num;
+  uint8_t  msg_len;
+  uint8_t *buffer;
+  uint16_t period;
+  uint16_t phase;
+
+  uint32_t sent;
+  uint32_t misses;
+
+  uint32_t next;            //tick the next frame is due(you do not configure this)
+  tCANMsgObject msg_obj;    //used to interface with other TI functions(you do not configure this)
+
+} MIL_CAN_SchedMsg_t;
+
+/*
+ * Desc: adds a message to the schedule
+ *
+ * Parameters:
+ * pmsg - a pointer to your message, it has to stay around
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if the schedule is full or the
+ *                    period/phase/object don't make sense
+ *
+ * Note: messages can be added while the scheduler is running, the
+ *       phase is counted from the start like everything else
+ */
+mil_can_status_t MIL_CAN_SchedAdd(MIL_CAN_SchedMsg_t *pmsg);
+
+/*
+ * Desc: sets up a timer to tick the scheduler
+ *
+ * Parameters:
+ * timer_base - TIMER0_BASE to TIMER5_BASE(timer A is used)
+ * tick_us - tick period in microseconds
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK for an unknown timer or if the message
+ *                    object lock is full
+ *
+ * Note: call MIL_ClkSetxxx first, the load value comes from the system clock
+ */
+mil_can_status_t MIL_CAN_SchedStart(uint32_t timer_base,uint32_t tick_us);
+
+/*
+ * Desc: advances the scheduler one tick, sends whatever is due
+ *
+ * Note: MIL_CAN_SchedStart does this for you, only call it if
+ *       you're running the tick from your own timer ISR(and add that
+ *       ISR with MIL_CAN_IfLockAdd)
+ */
+void MIL_CAN_SchedTick(void);
+
+/*
+ * Desc: deadline misses across every scheduled message
+ */
+uint32_t MIL_CAN_SchedMisses(void);
+
+#endif /* MIL_CAN_SCHED_H_ */
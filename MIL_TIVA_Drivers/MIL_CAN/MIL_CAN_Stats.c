@@ -0,0 +1,392 @@
+/*
+ * Name: MIL_CAN_Stats.c
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Optional bus load and timing statistics for MIL_CAN
+ *
+ * Notes: everything here is updated from the CAN ISR, the Get
+ *        functions may see a frame half counted but never a
+ *        broken value since every counter is a single 32 bit word
+ */
+
+/* INCLUDES */
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/can.h"
+
+//MIL includes
+#include "MIL_CAN_Stats.h"
+
+/*
+ * Desc: standard frame bits on the wire without stuffing
+ *
+ * SOF(1) ID(11) RTR(1) IDE(1) r0(1) DLC(4) CRC(15) = 34 stuffable bits
+ * CRC delim(1) ACK(2) EOF(7) IFS(3) = 13 fixed bits
+ */
+#define MIL_CAN_STATS_STUFFABLE_BITS 34
+#define MIL_CAN_STATS_FIXED_BITS     13
+
+typedef struct{
+
+    uint32_t base;
+    uint32_t bps;
+    uint32_t (*time_us)(void);
+    uint32_t mark_us;
+    uint64_t elapsed_us;
+    uint32_t total_frames;
+    uint64_t total_bits;
+    uint8_t  num_ids;
+    MIL_CAN_IdStats_t ids[MIL_CAN_STATS_MAX_IDS];
+    uint32_t last_us[32];
+    MIL_CAN_BoxStats_t boxes[32];
+
+}mil_can_stats_t;
+
+static mil_can_stats_t MIL_CAN_Stats;
+
+/*
+ * Desc: worst case bits a standard frame takes on the bus
+ */
+static uint32_t MIL_CAN_StatsFrameBits(uint8_t len){
+
+    uint32_t stuffable = MIL_CAN_STATS_STUFFABLE_BITS + 8 * (uint32_t)len;
+
+    //a stuff bit after every 4 identical bits at worst
+    return stuffable + ((stuffable - 1) / 4) + MIL_CAN_STATS_FIXED_BITS;
+
+}
+
+/*
+ * Desc: histogram bin for a time between frames
+ */
+static uint8_t MIL_CAN_StatsBin(uint32_t dt_us){
+
+    uint8_t bin = 0;
+    uint32_t edge = MIL_CAN_STATS_HIST_BASE_US;
+
+    while((dt_us >= edge) && (bin < (MIL_CAN_STATS_HIST_BINS - 1))){
+        bin++;
+        edge <<= 1;
+    }
+
+    return bin;
+
+}
+
+/*
+ * Desc: writes little endian values into the snapshot
+ */
+static uint8_t *MIL_CAN_StatsPut16(uint8_t *p,uint16_t val){
+
+    p[0] = (uint8_t)val;
+    p[1] = (uint8_t)(val >> 8);
+    return p + 2;
+
+}
+
+static uint8_t *MIL_CAN_StatsPut32(uint8_t *p,uint32_t val){
+
+    p[0] = (uint8_t)val;
+    p[1] = (uint8_t)(val >> 8);
+    p[2] = (uint8_t)(val >> 16);
+    p[3] = (uint8_t)(val >> 24);
+    return p + 4;
+
+}
+
+static uint8_t *MIL_CAN_StatsPut64(uint8_t *p,uint64_t val){
+
+    p = MIL_CAN_StatsPut32(p,(uint32_t)val);
+    return MIL_CAN_StatsPut32(p,(uint32_t)(val >> 32));
+
+}
+
+/*
+ * Desc: moves the time since the last call into elapsed_us
+ *
+ * Note: only the difference of two clock readings is used, so the
+ *       32 bit clock wrapping(every ~71 minutes) is fine as long as
+ *       this runs more often than that
+ *
+ * Returns:
+ * the clock reading
+ */
+static uint32_t MIL_CAN_StatsClock(mil_can_stats_t *pstats){
+
+    uint32_t now = pstats->time_us();
+
+    pstats->elapsed_us += (uint32_t)(now - pstats->mark_us);
+    pstats->mark_us = now;
+
+    return now;
+
+}
+
+/*
+ * Desc: bits sent over bits the bus could have sent
+ */
+static float MIL_CAN_StatsLoad(uint64_t total_bits,uint64_t elapsed_us,uint32_t bps){
+
+    if(!elapsed_us || !bps){
+        return 0.0f;
+    }
+
+    return (float)total_bits / ((float)bps * ((float)elapsed_us / 1000000.0f));
+
+}
+
+/*
+ * Desc: starts(or restarts) statistics collection
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE, frames from the other module are ignored
+ * bps - bus bit rate, the same number you passed to MIL_InitCAN
+ * time_us - function returning a free running microsecond count
+ */
+void MIL_CAN_StatsInit(uint32_t base,uint32_t bps,uint32_t (*time_us)(void)){
+
+    mil_can_stats_t *pstats = &MIL_CAN_Stats;
+
+    //stop recording while everything is cleared
+    pstats->time_us = 0;
+
+    pstats->base = base;
+    pstats->bps = bps;
+    pstats->elapsed_us = 0;
+    pstats->total_frames = 0;
+    pstats->total_bits = 0;
+    pstats->num_ids = 0;
+
+    for(uint8_t i = 0;i < 32;i++){
+
+        pstats->last_us[i] = 0;
+        pstats->boxes[i].frames = 0;
+        pstats->boxes[i].min_us = 0xFFFFFFFF;
+        pstats->boxes[i].max_us = 0;
+
+        for(uint8_t b = 0;b < MIL_CAN_STATS_HIST_BINS;b++){
+            pstats->boxes[i].hist[b] = 0;
+        }
+
+    }
+
+    pstats->mark_us = time_us();
+    pstats->time_us = time_us;
+
+}
+
+/*
+ * Desc: records one received frame
+ *
+ * Parameters:
+ * base - module the frame came in on
+ * pframe - the frame
+ */
+void MIL_CAN_StatsRecord(uint32_t base,const MIL_CAN_Frame_t *pframe){
+
+    mil_can_stats_t *pstats = &MIL_CAN_Stats;
+    uint32_t now;
+
+    if(!pstats->time_us || (base != pstats->base)){
+        return;
+    }
+
+    now = MIL_CAN_StatsClock(pstats);
+
+    pstats->total_frames++;
+    pstats->total_bits += MIL_CAN_StatsFrameBits(pframe->len);
+
+    //per ID counters
+    for(uint8_t i = 0;i <= pstats->num_ids;i++){
+
+        if(i == pstats->num_ids){
+
+            //new ID, start tracking it if there's room
+            if(i < MIL_CAN_STATS_MAX_IDS){
+                pstats->ids[i].canid = pframe->canid;
+                pstats->ids[i].frames = 1;
+                pstats->ids[i].bytes = pframe->len;
+                pstats->num_ids++;
+            }
+            break;
+
+        }
+        if(pstats->ids[i].canid == pframe->canid){
+
+            pstats->ids[i].frames++;
+            pstats->ids[i].bytes += pframe->len;
+            break;
+
+        }
+
+    }
+
+    //per mailbox timing
+    if((pframe->obj_num >= 1) && (pframe->obj_num <= 32)){
+
+        uint8_t slot = pframe->obj_num - 1;
+        MIL_CAN_BoxStats_t *pbox = &pstats->boxes[slot];
+
+        if(pbox->frames){
+
+            uint32_t dt = now - pstats->last_us[slot];
+            uint8_t bin = MIL_CAN_StatsBin(dt);
+
+            if(dt < pbox->min_us){pbox->min_us = dt;}
+            if(dt > pbox->max_us){pbox->max_us = dt;}
+            if(pbox->hist[bin] != 0xFFFF){pbox->hist[bin]++;}
+
+        }
+
+        pstats->last_us[slot] = now;
+        pbox->frames++;
+
+    }
+
+}
+
+/*
+ * Desc: estimated share of the bus time used since MIL_CAN_StatsInit
+ *
+ * Returns:
+ * 0.0 to 1.0(can read slightly over 1.0 because stuffing is worst case)
+ */
+float MIL_CAN_StatsBusLoad(void){
+
+    mil_can_stats_t *pstats = &MIL_CAN_Stats;
+    uint64_t elapsed_us;
+    uint64_t total_bits;
+    uint32_t lock;
+
+    if(!pstats->time_us){
+        return 0.0f;
+    }
+
+    //the ISR updates the same 64 bit totals
+    lock = MIL_CAN_IfLock();
+    MIL_CAN_StatsClock(pstats);
+    elapsed_us = pstats->elapsed_us;
+    total_bits = pstats->total_bits;
+    MIL_CAN_IfUnlock(lock);
+
+    return MIL_CAN_StatsLoad(total_bits,elapsed_us,pstats->bps);
+
+}
+
+/*
+ * Desc: copies out the counters for one ID
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if that ID isn't being tracked
+ */
+mil_can_status_t MIL_CAN_StatsGetId(uint32_t canid,MIL_CAN_IdStats_t *pstats){
+
+    for(uint8_t i = 0;i < MIL_CAN_Stats.num_ids;i++){
+
+        if(MIL_CAN_Stats.ids[i].canid == canid){
+            *pstats = MIL_CAN_Stats.ids[i];
+            return MIL_CAN_OK;
+        }
+
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: copies out the timing for one mailbox
+ *
+ * Parameters:
+ * obj_num - message object of the mailbox(1 to 32)
+ * pstats - where the timing is copied to
+ */
+void MIL_CAN_StatsGetBox(uint8_t obj_num,MIL_CAN_BoxStats_t *pstats){
+
+    if((obj_num >= 1) && (obj_num <= 32)){
+        *pstats = MIL_CAN_Stats.boxes[obj_num - 1];
+    }
+
+}
+
+/*
+ * Desc: dumps everything into a compact binary snapshot
+ *
+ * Parameters:
+ * pbuf - where the snapshot is written
+ * buf_len - size of pbuf
+ *
+ * Returns:
+ * number of bytes written, 0 if pbuf is too small
+ */
+uint16_t MIL_CAN_StatsSnapshot(uint8_t *pbuf,uint16_t buf_len){
+
+    mil_can_stats_t *pstats = &MIL_CAN_Stats;
+    uint8_t *p = pbuf;
+    uint8_t num_ids = pstats->num_ids;
+    uint32_t needed = 26 + 10 * (uint32_t)num_ids + 1;
+    uint64_t elapsed_us = 0;
+    uint64_t total_bits;
+    uint32_t lock;
+    float load;
+
+    lock = MIL_CAN_IfLock();
+    if(pstats->time_us){
+        MIL_CAN_StatsClock(pstats);
+        elapsed_us = pstats->elapsed_us;
+    }
+    total_bits = pstats->total_bits;
+    MIL_CAN_IfUnlock(lock);
+
+    load = MIL_CAN_StatsLoad(total_bits,elapsed_us,pstats->bps);
+
+    for(uint8_t i = 0;i < 32;i++){
+        if(pstats->boxes[i].frames){
+            needed += 13 + 2 * MIL_CAN_STATS_HIST_BINS;
+        }
+    }
+
+    if(needed > buf_len){
+        return 0;
+    }
+
+    //header
+    *p++ = 'M';
+    *p++ = 'C';
+    *p++ = 2;
+    *p++ = num_ids;
+    p = MIL_CAN_StatsPut64(p,elapsed_us);
+    p = MIL_CAN_StatsPut32(p,pstats->total_frames);
+    p = MIL_CAN_StatsPut64(p,total_bits);
+    p = MIL_CAN_StatsPut16(p,(load > 65.535f) ? 0xFFFF : (uint16_t)(load * 1000.0f));
+
+    //IDs
+    for(uint8_t i = 0;i < num_ids;i++){
+        p = MIL_CAN_StatsPut16(p,(uint16_t)pstats->ids[i].canid);
+        p = MIL_CAN_StatsPut32(p,pstats->ids[i].frames);
+        p = MIL_CAN_StatsPut32(p,pstats->ids[i].bytes);
+    }
+
+    //mailboxes
+    for(uint8_t i = 0;i < 32;i++){
+
+        MIL_CAN_BoxStats_t *pbox = &pstats->boxes[i];
+
+        if(!pbox->frames){
+            continue;
+        }
+
+        *p++ = i + 1;
+        p = MIL_CAN_StatsPut32(p,pbox->frames);
+        p = MIL_CAN_StatsPut32(p,pbox->min_us);
+        p = MIL_CAN_StatsPut32(p,pbox->max_us);
+        for(uint8_t b = 0;b < MIL_CAN_STATS_HIST_BINS;b++){
+            p = MIL_CAN_StatsPut16(p,pbox->hist[b]);
+        }
+
+    }
+    *p++ = 0;
+
+    return (uint16_t)(p - pbuf);
+
+}
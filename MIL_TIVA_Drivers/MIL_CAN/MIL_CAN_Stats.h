@@ -0,0 +1,169 @@
+/*
+ * Name: MIL_CAN_Stats.h
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Optional bus load and timing statistics for MIL_CAN
+ *
+ * WHAT THIS IS FOR:
+ * Before adding more nodes to the bus we need to know how busy it is
+ * and how regular each message really is. This layer counts frames and
+ * bytes per ID, estimates the bus load(stuff bits included) and keeps a
+ * histogram of the time between frames for every mailbox.
+ *
+ * HOW TO TURN IT ON:
+ * 1) add MIL_CAN_STATS to your project's predefined symbols, this makes
+ *    the CAN ISR record every frame it reads off the controller, the
+ *    ones that overflow the receive queue and the ones that go to
+ *    latest value boxes included
+ *    (without the define none of this is compiled into MIL_CAN.c)
+ * 2) MIL_CAN_StatsInit(CAN1_BASE,200000,your_microsecond_clock)
+ *    your clock just needs to count up in microseconds and may wrap,
+ *    time and bits are totaled in 64 bits so a 32 bit clock wrapping
+ *    every ~71 minutes is fine as long as a frame, BusLoad or Snapshot
+ *    comes along more often than that
+ * 3) read it back with the Get functions or dump everything with
+ *    MIL_CAN_StatsSnapshot and send it over UART/CAN
+ *
+ * Frames read any other way(GetMail, registry, FIFO drain) can be fed
+ * in with MIL_CAN_StatsRecord.
+ *
+ * BUS LOAD NOTE:
+ * Only frames that get through your acceptance filters are seen, so with
+ * tight filters the load is the load of your traffic, not the whole bus.
+ * Set a mailbox with filt_mask 0x00 while sizing if you want everything.
+ * Stuff bits are counted worst case(one every 4 bits), so the load is
+ * slightly pessimistic which is what you want when sizing.
+ */
+
+#include "MIL_CAN.h"
+
+#ifndef MIL_CAN_STATS_H_
+#define MIL_CAN_STATS_H_
+
+/*
+ * Desc: how many different IDs get their own counters
+ *
+ * Note: IDs past this are counted in the totals only
+ */
+#ifndef MIL_CAN_STATS_MAX_IDS
+#define MIL_CAN_STATS_MAX_IDS 32
+#endif
+
+/*
+ * Desc: inter-arrival histogram layout
+ *
+ * bin 0 - less than MIL_CAN_STATS_HIST_BASE_US
+ * bin k - MIL_CAN_STATS_HIST_BASE_US * 2^(k-1) up to twice that
+ * last bin - everything longer
+ *
+ * with the defaults that's 16us up to 262ms
+ */
+#define MIL_CAN_STATS_HIST_BINS 16
+#ifndef MIL_CAN_STATS_HIST_BASE_US
+#define MIL_CAN_STATS_HIST_BASE_US 16
+#endif
+
+/*
+ * Desc: counters for a single ID
+ *
+ * PARAMETERS:
+ * canid - the ID
+ * frames - frames seen
+ * bytes - payload bytes seen
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint32_t frames;
+  uint32_t bytes;
+
+} MIL_CAN_IdStats_t;
+
+/*
+ * Desc: timing for a single mailbox(message object)
+ *
+ * PARAMETERS:
+ * frames - frames seen
+ * min_us/max_us - shortest and longest time between frames,
+ *                 max_us - min_us is the worst jitter
+ * hist - count of times between frames per bin(see above)
+ */
+typedef struct{
+
+  uint32_t frames;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint16_t hist[MIL_CAN_STATS_HIST_BINS];
+
+} MIL_CAN_BoxStats_t;
+
+/*
+ * Desc: starts(or restarts) statistics collection
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE, frames from the other module are ignored
+ * bps - bus bit rate, the same number you passed to MIL_InitCAN
+ * time_us - function returning a free running microsecond count
+ */
+void MIL_CAN_StatsInit(uint32_t base,uint32_t bps,uint32_t (*time_us)(void));
+
+/*
+ * Desc: records one received frame
+ *
+ * Note: called for you by the receive queue ISR when MIL_CAN_STATS
+ *       is defined
+ *
+ * Parameters:
+ * base - module the frame came in on
+ * pframe - the frame
+ */
+void MIL_CAN_StatsRecord(uint32_t base,const MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: estimated share of the bus time used since MIL_CAN_StatsInit
+ *
+ * Returns:
+ * 0.0 to 1.0(can read slightly over 1.0 because stuffing is worst case)
+ */
+float MIL_CAN_StatsBusLoad(void);
+
+/*
+ * Desc: copies out the counters for one ID
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if that ID isn't being tracked
+ */
+mil_can_status_t MIL_CAN_StatsGetId(uint32_t canid,MIL_CAN_IdStats_t *pstats);
+
+/*
+ * Desc: copies out the timing for one mailbox
+ *
+ * Parameters:
+ * obj_num - message object of the mailbox(1 to 32)
+ * pstats - where the timing is copied to
+ */
+void MIL_CAN_StatsGetBox(uint8_t obj_num,MIL_CAN_BoxStats_t *pstats);
+
+/*
+ * Desc: dumps everything into a compact binary snapshot
+ *
+ * FORMAT(all values little endian):
+ * header, 26 bytes
+ *   'M','C', version(2), number of IDs(1),
+ *   elapsed us(8), total frames(4), total bits(8), load in 1/1000(2)
+ * one 10 byte record per tracked ID
+ *   canid(2), frames(4), bytes(4)
+ * one record per mailbox that has seen frames, 13 + 2*HIST_BINS bytes
+ *   obj_num(1), frames(4), min_us(4), max_us(4), hist(2 each)
+ *   and the list ends with an obj_num of 0
+ *
+ * Parameters:
+ * pbuf - where the snapshot is written
+ * buf_len - size of pbuf
+ *
+ * Returns:
+ * number of bytes written, 0 if pbuf is too small
+ */
+uint16_t MIL_CAN_StatsSnapshot(uint8_t *pbuf,uint16_t buf_len);
+
+#endif /* MIL_CAN_STATS_H_ */
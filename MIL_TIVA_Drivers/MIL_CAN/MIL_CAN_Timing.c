@@ -0,0 +1,189 @@
+/*
+ * Name: MIL_CAN_Timing.c
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Bit timing calculator for the TIVA CAN controller
+ *
+ * Notes: oscillator tolerance uses the two limits from the Bosch
+ *        CAN spec, whichever is smaller
+ *        df <= min(Phase_Seg1,Phase_Seg2) / (2 * (13 * bit time - Phase_Seg2))
+ *        df <= SJW / (20 * bit time)
+ */
+
+/* INCLUDES */
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/can.h"
+#include "driverlib/sysctl.h"
+
+//MIL includes
+#include "MIL_CAN_Timing.h"
+
+//controller limits(CANBitTimingSet)
+#define MIL_CAN_TSEG1_MIN 2
+#define MIL_CAN_TSEG1_MAX 16
+#define MIL_CAN_TSEG2_MIN 1
+#define MIL_CAN_TSEG2_MAX 8
+#define MIL_CAN_SJW_MAX   4
+#define MIL_CAN_PRESCALE_MAX 1023
+
+/*
+ * Desc: finds the best bit timing for a clock and bit rate
+ *
+ * Parameters:
+ * clock - CAN module clock, SysCtlClockGet()
+ * bps - bit rate you want
+ * cable_m - length of the longest run of bus cable in meters
+ * sample_point - target sample point in 1/1000(MIL_CAN_SAMPLE_POINT_DEFAULT)
+ * ptiming - where the result is written
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if no combination reaches the bit rate
+ *                    with enough time for the cable length
+ */
+mil_can_status_t MIL_CAN_TimingSolve(uint32_t clock,
+                                     uint32_t bps,
+                                     uint16_t cable_m,
+                                     uint16_t sample_point,
+                                     MIL_CAN_BitTiming_t *ptiming){
+
+    //time the bit has to get to the far end and back
+    uint32_t prop_ns = 2 * ((uint32_t)cable_m * MIL_CAN_TIMING_CABLE_NS_PER_M + MIL_CAN_TIMING_NODE_DELAY_NS);
+    uint32_t best_sp_err = 0xFFFFFFFF;
+    uint32_t best_tol = 0;
+    bool found = false;
+
+    if((bps == 0) || (clock == 0)){
+        return MIL_CAN_NOK;
+    }
+
+    for(uint32_t prescale = 1;prescale <= MIL_CAN_PRESCALE_MAX;prescale++){
+
+        uint32_t tq_per_bit;
+        uint32_t actual_bps;
+        uint32_t rate_err_ppm;
+        uint32_t prop_tq;
+
+        //nearest whole number of TQ per bit, the prescaler doesn't have to
+        //divide the clock evenly, the rate error check below covers that
+        tq_per_bit = (uint32_t)(((uint64_t)clock + ((uint64_t)prescale * bps) / 2) / ((uint64_t)prescale * bps));
+        if((tq_per_bit < (1 + MIL_CAN_TSEG1_MIN + MIL_CAN_TSEG2_MIN)) ||
+           (tq_per_bit > (1 + MIL_CAN_TSEG1_MAX + MIL_CAN_TSEG2_MAX))){
+            continue;
+        }
+
+        actual_bps = clock / (prescale * tq_per_bit);
+        rate_err_ppm = (uint32_t)(((uint64_t)((actual_bps > bps) ? (actual_bps - bps) : (bps - actual_bps)) * 1000000) / bps);
+        if(rate_err_ppm > MIL_CAN_TIMING_MAX_RATE_ERR_PPM){
+            continue;
+        }
+
+        //propagation segment in TQ, rounded up
+        prop_tq = (uint32_t)(((uint64_t)prop_ns * clock + (uint64_t)prescale * 1000000000 - 1) / ((uint64_t)prescale * 1000000000));
+
+        for(uint32_t tseg2 = MIL_CAN_TSEG2_MIN;tseg2 <= MIL_CAN_TSEG2_MAX;tseg2++){
+
+            uint32_t tseg1 = tq_per_bit - 1 - tseg2;
+            uint32_t phase1;
+            uint32_t phase_min;
+            uint32_t sjw;
+            uint32_t sp;
+            uint32_t sp_err;
+            uint32_t tol1;
+            uint32_t tol2;
+            uint32_t tol;
+
+            if((tseg1 < MIL_CAN_TSEG1_MIN) || (tseg1 > MIL_CAN_TSEG1_MAX)){
+                continue;
+            }
+
+            //need at least one TQ of phase segment 1 after propagation
+            if(tseg1 < (prop_tq + 1)){
+                continue;
+            }
+            phase1 = tseg1 - prop_tq;
+
+            phase_min = (phase1 < tseg2) ? phase1 : tseg2;
+            sjw = (phase_min < MIL_CAN_SJW_MAX) ? phase_min : MIL_CAN_SJW_MAX;
+
+            sp = ((1 + tseg1) * 1000) / tq_per_bit;
+            sp_err = (sp > sample_point) ? (sp - sample_point) : (sample_point - sp);
+
+            tol1 = (phase_min * 1000000) / (2 * (13 * tq_per_bit - tseg2));
+            tol2 = (sjw * 1000000) / (20 * tq_per_bit);
+            tol = (tol1 < tol2) ? tol1 : tol2;
+
+            //bit rate error eats into the tolerance
+            tol = (tol > rate_err_ppm) ? (tol - rate_err_ppm) : 0;
+
+            //closest sample point first, then the most tolerance
+            if(!found || (sp_err < best_sp_err) ||
+               ((sp_err == best_sp_err) && (tol > best_tol))){
+
+                found = true;
+                best_sp_err = sp_err;
+                best_tol = tol;
+
+                ptiming->parms.ui32SyncPropPhase1Seg = tseg1;
+                ptiming->parms.ui32Phase2Seg = tseg2;
+                ptiming->parms.ui32SJW = sjw;
+                ptiming->parms.ui32QuantumPrescaler = prescale;
+                ptiming->actual_bps = actual_bps;
+                ptiming->tq_per_bit = (uint8_t)tq_per_bit;
+                ptiming->sample_point = (uint16_t)sp;
+                ptiming->osc_tol_ppm = tol;
+
+            }
+
+        }
+
+    }
+
+    if(!found){
+        return MIL_CAN_NOK;
+    }
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: loads a solved timing into the controller
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * ptiming - a timing from MIL_CAN_TimingSolve
+ */
+void MIL_CAN_TimingApply(uint32_t base,MIL_CAN_BitTiming_t *ptiming){
+
+    //CANBitTimingSet takes care of the init and config change bits
+    CANBitTimingSet(base,&ptiming->parms);
+
+}
+
+/*
+ * Desc: solves for the current system clock with the default sample point
+ *       and applies it, use after MIL_InitCAN
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * bps - bit rate you want
+ * cable_m - length of the longest run of bus cable in meters
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if it couldn't be solved, the old
+ *                    bit timing is left in place
+ */
+mil_can_status_t MIL_CAN_SetBitRate(uint32_t base,uint32_t bps,uint16_t cable_m){
+
+    MIL_CAN_BitTiming_t timing;
+
+    if(MIL_CAN_TimingSolve(SysCtlClockGet(),bps,cable_m,MIL_CAN_SAMPLE_POINT_DEFAULT,&timing) == MIL_CAN_NOK){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_TimingApply(base,&timing);
+
+    return MIL_CAN_OK;
+
+}
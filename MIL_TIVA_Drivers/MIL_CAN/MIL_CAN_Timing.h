@@ -0,0 +1,130 @@
+/*
+ * Name: MIL_CAN_Timing.h
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Bit timing calculator for the TIVA CAN controller
+ *
+ * WHAT YOU NEED TO UNDERSTAND ABOUT BIT TIMING:
+ * Each CAN bit is split into time quanta(TQ), a TQ being the system
+ * clock divided by the prescaler. A bit is laid out as
+ *
+ * | SYNC(1 TQ) | TSEG1(2 to 16 TQ) | TSEG2(1 to 8 TQ) |
+ *                                  ^ sample point
+ *
+ * TSEG1 has to cover the time it takes a bit to get to the far end of
+ * the cable and back(plus the transceiver delays) with some room left
+ * over, and the bigger the phase segments around the sample point the
+ * more clock mismatch between nodes the bus can handle.
+ *
+ * CANBitRateSet(what MIL_InitCAN uses) just grabs the first timing that
+ * hits the bit rate. That's fine at 100k-200k but starts to bite at
+ * 500k and 1M on a 16MHz internal oscillator. The solver here tries every
+ * legal prescaler/TSEG1/TSEG2/SJW combination and keeps the one with the
+ * sample point closest to target and the most oscillator tolerance.
+ *
+ * HOW TO USE:
+ * MIL_InitCAN(MIL_CAN_PORT_A,CAN1_BASE,500000);
+ * MIL_CAN_SetBitRate(CAN1_BASE,500000,10); //10m of cable
+ *
+ * or solve it yourself to look at the numbers first
+ * MIL_CAN_BitTiming_t timing;
+ * if(MIL_CAN_TimingSolve(SysCtlClockGet(),500000,10,MIL_CAN_SAMPLE_POINT_DEFAULT,&timing) == MIL_CAN_OK){
+ *     MIL_CAN_TimingApply(CAN1_BASE,&timing);
+ * }
+ */
+
+#include "MIL_CAN.h"
+
+#ifndef MIL_CAN_TIMING_H_
+#define MIL_CAN_TIMING_H_
+
+//sample point target in 1/1000 of a bit(87.5% is what CANopen recommends)
+#define MIL_CAN_SAMPLE_POINT_DEFAULT 875
+
+/*
+ * Desc: round trip delay through one transceiver and isolator in ns
+ *       (transmitter + receiver), counted twice for the round trip
+ *
+ * Note: change this if your boards use slower isolated transceivers
+ */
+#ifndef MIL_CAN_TIMING_NODE_DELAY_NS
+#define MIL_CAN_TIMING_NODE_DELAY_NS 210
+#endif
+
+//signal delay per meter of twisted pair
+#define MIL_CAN_TIMING_CABLE_NS_PER_M 5
+
+/*
+ * Desc: the most the solved bit rate may be off from the one asked for
+ *       in parts per million
+ */
+#ifndef MIL_CAN_TIMING_MAX_RATE_ERR_PPM
+#define MIL_CAN_TIMING_MAX_RATE_ERR_PPM 1000
+#endif
+
+/*
+ * Desc: a solved bit timing
+ *
+ * PARAMETERS:
+ * parms - what gets passed to CANBitTimingSet
+ * actual_bps - bit rate these settings really produce
+ * tq_per_bit - time quanta in one bit
+ * sample_point - sample point in 1/1000 of a bit
+ * osc_tol_ppm - clock mismatch the bus tolerates with these settings
+ *               (what's left after the bit rate error is taken out)
+ */
+typedef struct{
+
+  tCANBitClkParms parms;
+  uint32_t actual_bps;
+  uint8_t  tq_per_bit;
+  uint16_t sample_point;
+  uint32_t osc_tol_ppm;
+
+} MIL_CAN_BitTiming_t;
+
+/*
+ * Desc: finds the best bit timing for a clock and bit rate
+ *
+ * Parameters:
+ * clock - CAN module clock, SysCtlClockGet()
+ * bps - bit rate you want
+ * cable_m - length of the longest run of bus cable in meters
+ * sample_point - target sample point in 1/1000(MIL_CAN_SAMPLE_POINT_DEFAULT)
+ * ptiming - where the result is written
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if no combination reaches the bit rate
+ *                    with enough time for the cable length
+ */
+mil_can_status_t MIL_CAN_TimingSolve(uint32_t clock,
+                                     uint32_t bps,
+                                     uint16_t cable_m,
+                                     uint16_t sample_point,
+                                     MIL_CAN_BitTiming_t *ptiming);
+
+/*
+ * Desc: loads a solved timing into the controller
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * ptiming - a timing from MIL_CAN_TimingSolve
+ */
+void MIL_CAN_TimingApply(uint32_t base,MIL_CAN_BitTiming_t *ptiming);
+
+/*
+ * Desc: solves for the current system clock with the default sample point
+ *       and applies it, use after MIL_InitCAN
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * bps - bit rate you want
+ * cable_m - length of the longest run of bus cable in meters
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_NOK if it couldn't be solved, the old
+ *                    bit timing is left in place
+ */
+mil_can_status_t MIL_CAN_SetBitRate(uint32_t base,uint32_t bps,uint16_t cable_m);
+
+#endif /* MIL_CAN_TIMING_H_ */
@@ -0,0 +1,1345 @@
+/*
+ * Name: MIL_CAN_Sim.c
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: A virtual TIVA CAN controller and bus for running MIL_CAN on a PC
+ *
+ * Notes: time is kept in nanoseconds, every frame is laid out bit by
+ *        bit(CRC included) so its stuff bits come out exactly like a
+ *        real controller's
+ *
+ *        the whole simulation is one thread, ISRs only ever run from
+ *        inside MIL_CAN_SimRun
+ */
+
+/* INCLUDES */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/can.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+
+//MIL includes
+#include "MIL_CAN_Sim.h"
+
+#if MIL_CAN_SIM_NODES < 2
+#error "MIL_CAN_SIM_NODES has to cover CAN0 and CAN1"
+#endif
+
+//a stuffed standard frame tops out at 132 bits, extended at 157
+#define MIL_CAN_SIM_MAX_BITS 160
+
+//CRC delimiter(1) ACK slot(1) ACK delimiter(1) EOF(7) IFS(3)
+#define MIL_CAN_SIM_TAIL_BITS 13
+
+//error flag(6, plus up to 6 echoed) error delimiter(8) IFS(3)
+#define MIL_CAN_SIM_ERR_FRAME_BITS 23
+
+//an error passive transmitter waits this long after its own frame
+#define MIL_CAN_SIM_SUSPEND_BITS 8
+
+//bus off recovery needs 128 runs of 11 recessive bits
+#define MIL_CAN_SIM_RECOVERY_BITS (128 * 11)
+
+//how many times an ISR can run without clearing its interrupt
+#define MIL_CAN_SIM_ISR_LIMIT 64
+
+#define MIL_CAN_SIM_NO_EVENT 0xFFFFFFFFFFFFFFFFULL
+
+/*
+ * Desc: one message object, IDs and masks are kept in register
+ *       layout(standard IDs in bits 28:18) so standard and extended
+ *       frames filter the same way the hardware does
+ */
+typedef struct{
+
+    bool     msgval;
+    bool     dir_tx;
+    bool     xtd;
+    bool     umask;
+    bool     mxtd;
+    bool     eob;
+    bool     txie;
+    bool     rxie;
+    bool     newdat;
+    bool     msglst;
+    bool     txrqst;
+    bool     intpnd;
+    uint32_t id;
+    uint32_t mask;
+    uint8_t  dlc;
+    uint8_t  data[8];
+
+}mil_can_sim_obj_t;
+
+typedef struct{
+
+    uint8_t  bus;
+    bool     init;
+    bool     ie;
+    bool     sie;
+    bool     eie;
+    bool     retry;
+    bool     sts_int;
+    uint32_t bps;
+    uint32_t status;
+    uint32_t tec;
+    uint32_t rec;
+    uint64_t recover_ns;
+    uint64_t suspend_ns;
+    void (*handler)(void);
+    mil_can_sim_obj_t obj[32];
+    MIL_CAN_SimNodeStats_t stats;
+
+}mil_can_sim_node_t;
+
+/*
+ * Desc: a frame on the wire, copied out of the message object when
+ *       it wins arbitration like the real shift register
+ */
+typedef struct{
+
+    bool     busy;
+    uint64_t end_ns;
+    uint8_t  node;
+    uint8_t  obj_num;
+    bool     xtd;
+    uint32_t id;
+    uint8_t  dlc;
+    uint8_t  data[8];
+    uint32_t bits;
+    bool     error;
+    uint8_t  lec;
+    uint32_t inject;
+    uint8_t  inject_lec;
+    MIL_CAN_SimBusStats_t stats;
+    uint64_t busy_ns;
+
+}mil_can_sim_bus_t;
+
+/*
+ * Desc: one general purpose timer, only timer A as a full width
+ *       periodic or one shot timer
+ */
+typedef struct{
+
+    bool     enabled;
+    bool     periodic;
+    bool     int_enabled;
+    uint32_t load;
+    uint64_t next_ns;
+    void (*handler)(void);
+
+}mil_can_sim_timer_t;
+
+#define MIL_CAN_SIM_TIMERS 6
+
+static mil_can_sim_node_t MIL_CAN_SimNode[MIL_CAN_SIM_NODES];
+static mil_can_sim_timer_t MIL_CAN_SimTimer[MIL_CAN_SIM_TIMERS];
+static mil_can_sim_bus_t MIL_CAN_SimBus[MIL_CAN_SIM_BUSES];
+static uint64_t MIL_CAN_SimNow;
+static uint32_t MIL_CAN_SimClock;
+static uint8_t MIL_CAN_SimNvic[256 / 8];
+static bool MIL_CAN_SimPended[2];
+static bool MIL_CAN_SimIntMaster;
+
+/**************************************************HELPERS*************************************************************/
+
+static mil_can_sim_node_t *MIL_CAN_SimNodeGet(uint32_t base){
+
+    uint32_t n;
+
+    if(base == CAN0_BASE){
+        n = 0;
+    }
+    else if(base == CAN1_BASE){
+        n = 1;
+    }
+    else{
+        n = base - MIL_CAN_SIM_NODE_BASE;
+    }
+
+    //anything out of range lands on the last node instead of off the end
+    if(n >= MIL_CAN_SIM_NODES){
+        n = MIL_CAN_SIM_NODES - 1;
+    }
+
+    return &MIL_CAN_SimNode[n];
+
+}
+
+static uint32_t MIL_CAN_SimRegId(uint32_t id,bool xtd){
+
+    return xtd ? (id & 0x1FFFFFFF) : ((id & 0x7FF) << 18);
+
+}
+
+static uint64_t MIL_CAN_SimBitsToNs(uint32_t bits,uint32_t bps){
+
+    return ((uint64_t)bits * 1000000000ULL) / bps;
+
+}
+
+/*
+ * Desc: lays the frame out from SOF to the end of the CRC, works out
+ *       the CRC and counts the stuff bits a controller would insert
+ *
+ * Returns:
+ * uint32_t - bits the whole frame takes, interframe space included
+ */
+static uint32_t MIL_CAN_SimFrameBits(bool xtd,uint32_t id,uint8_t dlc,const uint8_t *pdata){
+
+    uint8_t bits[MIL_CAN_SIM_MAX_BITS];
+    uint32_t n = 0;
+    uint16_t crc = 0;
+    uint32_t stuffed;
+    uint8_t run;
+    uint8_t prev;
+    int8_t i;
+
+    bits[n++] = 0;                               //SOF
+
+    if(xtd){
+        for(i = 28;i >= 18;i--) bits[n++] = (id >> i) & 1;
+        bits[n++] = 1;                           //SRR
+        bits[n++] = 1;                           //IDE
+        for(i = 17;i >= 0;i--) bits[n++] = (id >> i) & 1;
+        bits[n++] = 0;                           //RTR
+        bits[n++] = 0;                           //r1
+        bits[n++] = 0;                           //r0
+    }
+    else{
+        for(i = 10;i >= 0;i--) bits[n++] = (id >> i) & 1;
+        bits[n++] = 0;                           //RTR
+        bits[n++] = 0;                           //IDE
+        bits[n++] = 0;                           //r0
+    }
+
+    for(i = 3;i >= 0;i--) bits[n++] = (dlc >> i) & 1;
+
+    for(uint8_t b = 0;b < dlc;b++){
+        for(i = 7;i >= 0;i--) bits[n++] = (pdata[b] >> i) & 1;
+    }
+
+    //CRC-15, x^15 + x^14 + x^10 + x^8 + x^7 + x^4 + x^3 + 1
+    for(uint32_t b = 0;b < n;b++){
+        uint8_t nxt = bits[b] ^ ((crc >> 14) & 1);
+        crc = (crc << 1) & 0x7FFF;
+        if(nxt){
+            crc ^= 0x4599;
+        }
+    }
+
+    for(i = 14;i >= 0;i--) bits[n++] = (crc >> i) & 1;
+
+    //a stuff bit after 5 identical bits, and it starts the next run
+    stuffed = n;
+    prev = bits[0];
+    run = 1;
+
+    for(uint32_t b = 1;b < n;b++){
+
+        if(bits[b] == prev){
+            run++;
+        }
+        else{
+            prev = bits[b];
+            run = 1;
+        }
+
+        if(run == 5){
+            stuffed++;
+            prev = !prev;
+            run = 1;
+        }
+
+    }
+
+    return stuffed + MIL_CAN_SIM_TAIL_BITS;
+
+}
+
+/*
+ * Desc: error counters to CANSTS bits, raises the error interrupt
+ *       whenever EWARN, EPASS or BOFF change
+ */
+static void MIL_CAN_SimErrUpdate(mil_can_sim_node_t *pnode){
+
+    uint32_t old = pnode->status & (CAN_STATUS_EWARN | CAN_STATUS_EPASS | CAN_STATUS_BUS_OFF);
+    uint32_t now = 0;
+
+    if(pnode->tec > 255){
+        now |= CAN_STATUS_BUS_OFF | CAN_STATUS_EPASS | CAN_STATUS_EWARN;
+        //the controller takes itself off the bus until software restarts it
+        pnode->init = true;
+        pnode->tec = 256;
+    }
+    else{
+        if((pnode->tec >= 96) || (pnode->rec >= 96)){
+            now |= CAN_STATUS_EWARN;
+        }
+        if((pnode->tec >= 128) || (pnode->rec >= 128)){
+            now |= CAN_STATUS_EPASS;
+        }
+    }
+
+    pnode->status = (pnode->status & ~old) | now;
+
+    if((old != now) && pnode->eie){
+        pnode->sts_int = true;
+    }
+
+}
+
+/*
+ * Desc: sets the last error code and TXOK/RXOK, raises the status
+ *       interrupt when enabled
+ */
+static void MIL_CAN_SimStatusSet(mil_can_sim_node_t *pnode,uint32_t set,uint8_t lec){
+
+    pnode->status = (pnode->status & ~CAN_STATUS_LEC_MSK) | set | lec;
+
+    if(pnode->sie){
+        pnode->sts_int = true;
+    }
+
+}
+
+static bool MIL_CAN_SimOnBus(mil_can_sim_node_t *pnode,uint8_t bus){
+
+    return (pnode->bus == bus) && !pnode->init && !(pnode->status & CAN_STATUS_BUS_OFF);
+
+}
+
+/*
+ * Desc: lowest numbered object waiting to transmit
+ *
+ * Returns:
+ * uint8_t - object number, 0 if nothing is pending
+ */
+static uint8_t MIL_CAN_SimTxPending(mil_can_sim_node_t *pnode){
+
+    for(uint8_t i = 0;i < 32;i++){
+        if(pnode->obj[i].msgval && pnode->obj[i].dir_tx && pnode->obj[i].txrqst){
+            return i + 1;
+        }
+    }
+
+    return 0;
+
+}
+
+/*
+ * Desc: arbitration value, lower wins, follows the order bits go
+ *       out on the wire(base ID, SRR/RTR, IDE, extended ID, RTR)
+ */
+static uint32_t MIL_CAN_SimArbKey(mil_can_sim_obj_t *pobj){
+
+    if(pobj->xtd){
+        return ((pobj->id >> 18) << 21) | (1UL << 20) | (1UL << 19) | ((pobj->id & 0x3FFFF) << 1);
+    }
+
+    return (pobj->id >> 18) << 21;
+
+}
+
+/*
+ * Desc: stores a received frame in the first object that accepts it
+ */
+static void MIL_CAN_SimAccept(mil_can_sim_node_t *pnode,mil_can_sim_bus_t *pbus){
+
+    uint32_t regid = MIL_CAN_SimRegId(pbus->id,pbus->xtd);
+
+    for(uint8_t i = 0;i < 32;i++){
+
+        mil_can_sim_obj_t *pobj = &pnode->obj[i];
+        uint32_t mask = pobj->umask ? pobj->mask : 0x1FFFFFFF;
+
+        if(!pobj->msgval || pobj->dir_tx){
+            continue;
+        }
+
+        //IDE only matters without a mask or with the extended mask bit
+        if((!pobj->umask || pobj->mxtd) && (pobj->xtd != pbus->xtd)){
+            continue;
+        }
+
+        if((regid & mask) != (pobj->id & mask)){
+            continue;
+        }
+
+        //a FIFO entry that's still full passes the frame down the chain
+        if(pobj->newdat && !pobj->eob){
+            continue;
+        }
+
+        if(pobj->newdat){
+            pobj->msglst = true;
+            pnode->stats.rx_overruns++;
+        }
+
+        pobj->id = regid;
+        pobj->xtd = pbus->xtd;
+        pobj->dlc = pbus->dlc;
+        for(uint8_t b = 0;b < 8;b++){
+            pobj->data[b] = pbus->data[b];
+        }
+        pobj->newdat = true;
+        if(pobj->rxie){
+            pobj->intpnd = true;
+        }
+
+        pnode->stats.rx_frames++;
+        return;
+
+    }
+
+    pnode->stats.rx_unmatched++;
+
+}
+
+static mil_can_sim_timer_t *MIL_CAN_SimTimerGet(uint32_t base){
+
+    uint32_t idx = (base - TIMER0_BASE) >> 12;
+
+    return (idx < MIL_CAN_SIM_TIMERS) ? &MIL_CAN_SimTimer[idx] : &MIL_CAN_SimTimer[0];
+
+}
+
+static uint64_t MIL_CAN_SimTimerPeriodNs(mil_can_sim_timer_t *ptimer){
+
+    return ((uint64_t)ptimer->load + 1) * 1000000000ULL / MIL_CAN_SimClock;
+
+}
+
+/**************************************************BUS*************************************************************/
+
+/*
+ * Desc: starts the next frame on an idle bus, the winner of
+ *       arbitration is the lowest ID any node is offering
+ */
+static void MIL_CAN_SimArbitrate(uint8_t bus){
+
+    mil_can_sim_bus_t *pbus = &MIL_CAN_SimBus[bus];
+    mil_can_sim_obj_t *pwin = 0;
+    uint32_t win_key = 0;
+    uint8_t win_node = 0;
+    uint8_t win_obj = 0;
+    uint8_t offers = 0;
+    mil_can_sim_node_t *pnode;
+    bool acked = false;
+
+    for(uint8_t n = 0;n < MIL_CAN_SIM_NODES;n++){
+
+        uint8_t obj_num;
+        uint32_t key;
+
+        pnode = &MIL_CAN_SimNode[n];
+
+        if(!MIL_CAN_SimOnBus(pnode,bus) || (pnode->suspend_ns > MIL_CAN_SimNow)){
+            continue;
+        }
+
+        if(!(obj_num = MIL_CAN_SimTxPending(pnode))){
+            continue;
+        }
+
+        offers++;
+        key = MIL_CAN_SimArbKey(&pnode->obj[obj_num - 1]);
+
+        if(!pwin || (key < win_key)){
+            pwin = &pnode->obj[obj_num - 1];
+            win_key = key;
+            win_node = n;
+            win_obj = obj_num;
+        }
+
+    }
+
+    if(!pwin){
+        return;
+    }
+
+    //everyone who offered something and didn't win lost arbitration
+    for(uint8_t n = 0;n < MIL_CAN_SIM_NODES;n++){
+        pnode = &MIL_CAN_SimNode[n];
+        if((n != win_node) && (offers > 1) && MIL_CAN_SimOnBus(pnode,bus) &&
+           (pnode->suspend_ns <= MIL_CAN_SimNow) && MIL_CAN_SimTxPending(pnode)){
+            pnode->stats.arb_lost++;
+        }
+    }
+
+    pbus->busy = true;
+    pbus->node = win_node;
+    pbus->obj_num = win_obj;
+    pbus->xtd = pwin->xtd;
+    pbus->id = pwin->xtd ? pwin->id : (pwin->id >> 18);
+    pbus->dlc = pwin->dlc;
+    for(uint8_t b = 0;b < 8;b++){
+        pbus->data[b] = pwin->data[b];
+    }
+    pbus->bits = MIL_CAN_SimFrameBits(pbus->xtd,pbus->id,pbus->dlc,pbus->data);
+    pbus->error = false;
+    pbus->lec = CAN_STATUS_LEC_NONE;
+
+    //somebody else at the same bit rate has to be listening to ACK it
+    for(uint8_t n = 0;n < MIL_CAN_SIM_NODES;n++){
+        pnode = &MIL_CAN_SimNode[n];
+        if((n != win_node) && MIL_CAN_SimOnBus(pnode,bus) &&
+           (pnode->bps == MIL_CAN_SimNode[win_node].bps)){
+            acked = true;
+        }
+    }
+
+    if(pbus->inject){
+        pbus->inject--;
+        pbus->error = true;
+        pbus->lec = pbus->inject_lec;
+        //errors get flagged at the end of the CRC at the latest
+        pbus->bits = pbus->bits - MIL_CAN_SIM_TAIL_BITS + MIL_CAN_SIM_ERR_FRAME_BITS;
+    }
+    else if(!acked){
+        pbus->error = true;
+        pbus->lec = CAN_STATUS_LEC_ACK;
+        pbus->bits = pbus->bits - MIL_CAN_SIM_TAIL_BITS + 2 + MIL_CAN_SIM_ERR_FRAME_BITS;
+    }
+
+    pbus->end_ns = MIL_CAN_SimNow + MIL_CAN_SimBitsToNs(pbus->bits,MIL_CAN_SimNode[win_node].bps);
+
+}
+
+/*
+ * Desc: the frame on the bus just finished, update the transmitter
+ *       and every receiver
+ */
+static void MIL_CAN_SimComplete(uint8_t bus){
+
+    mil_can_sim_bus_t *pbus = &MIL_CAN_SimBus[bus];
+    mil_can_sim_node_t *ptx = &MIL_CAN_SimNode[pbus->node];
+    mil_can_sim_obj_t *pobj = &ptx->obj[pbus->obj_num - 1];
+
+    pbus->busy = false;
+    pbus->stats.bits += pbus->bits;
+    pbus->busy_ns += MIL_CAN_SimBitsToNs(pbus->bits,ptx->bps);
+
+    if(pbus->error){
+
+        bool passive = (ptx->status & CAN_STATUS_EPASS) != 0;
+
+        pbus->stats.errors++;
+
+        //a passive transmitter missing its ACK doesn't count it
+        if(!((pbus->lec == CAN_STATUS_LEC_ACK) && passive)){
+            ptx->tec += 8;
+        }
+
+        //one shot mode gives up after the first try
+        if(!ptx->retry){
+            pobj->txrqst = false;
+        }
+
+        MIL_CAN_SimStatusSet(ptx,0,pbus->lec);
+        MIL_CAN_SimErrUpdate(ptx);
+
+        if(pbus->lec != CAN_STATUS_LEC_ACK){
+            for(uint8_t n = 0;n < MIL_CAN_SIM_NODES;n++){
+                mil_can_sim_node_t *pnode = &MIL_CAN_SimNode[n];
+                if((pnode != ptx) && MIL_CAN_SimOnBus(pnode,bus)){
+                    pnode->rec++;
+                    MIL_CAN_SimStatusSet(pnode,0,pbus->lec);
+                    MIL_CAN_SimErrUpdate(pnode);
+                }
+            }
+        }
+
+    }
+    else{
+
+        pbus->stats.frames++;
+        ptx->stats.tx_frames++;
+
+        if(ptx->tec){
+            ptx->tec--;
+        }
+
+        pobj->txrqst = false;
+        pobj->newdat = false;
+        if(pobj->txie){
+            pobj->intpnd = true;
+        }
+
+        MIL_CAN_SimStatusSet(ptx,CAN_STATUS_TXOK,CAN_STATUS_LEC_NONE);
+        MIL_CAN_SimErrUpdate(ptx);
+
+        for(uint8_t n = 0;n < MIL_CAN_SIM_NODES;n++){
+
+            mil_can_sim_node_t *pnode = &MIL_CAN_SimNode[n];
+
+            if((pnode == ptx) || !MIL_CAN_SimOnBus(pnode,bus)){
+                continue;
+            }
+
+            //wrong bit rate, it sees garbage
+            if(pnode->bps != ptx->bps){
+                pnode->rec++;
+                MIL_CAN_SimStatusSet(pnode,0,CAN_STATUS_LEC_FORM);
+                MIL_CAN_SimErrUpdate(pnode);
+                continue;
+            }
+
+            if(pnode->rec > 127){
+                pnode->rec = 120;
+            }
+            else if(pnode->rec){
+                pnode->rec--;
+            }
+
+            MIL_CAN_SimAccept(pnode,pbus);
+            MIL_CAN_SimStatusSet(pnode,CAN_STATUS_RXOK,CAN_STATUS_LEC_NONE);
+            MIL_CAN_SimErrUpdate(pnode);
+
+        }
+
+    }
+
+    if(ptx->status & CAN_STATUS_EPASS){
+        ptx->suspend_ns = pbus->end_ns + MIL_CAN_SimBitsToNs(MIL_CAN_SIM_SUSPEND_BITS,ptx->bps);
+    }
+
+}
+
+/**************************************************INTERRUPTS*************************************************************/
+
+static bool MIL_CAN_SimIrqLine(mil_can_sim_node_t *pnode){
+
+    if(!pnode->ie){
+        return false;
+    }
+
+    if(pnode->sts_int){
+        return true;
+    }
+
+    for(uint8_t i = 0;i < 32;i++){
+        if(pnode->obj[i].intpnd){
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+/*
+ * Desc: runs the ISR of every node with its interrupt line up, CAN0
+ *       and CAN1 also need their NVIC interrupt enabled and can be
+ *       pended from software(IntPendSet)
+ */
+static void MIL_CAN_SimDispatch(void){
+
+    for(uint8_t n = 0;n < MIL_CAN_SIM_NODES;n++){
+
+        mil_can_sim_node_t *pnode = &MIL_CAN_SimNode[n];
+        uint8_t calls = 0;
+
+        if(!pnode->handler){
+            continue;
+        }
+
+        while(MIL_CAN_SimIrqLine(pnode) || ((n < 2) && MIL_CAN_SimPended[n])){
+
+            //checked every time round, the ISR may have masked itself
+            if((n < 2) && (!MIL_CAN_SimIntMaster || !IntIsEnabled(n ? INT_CAN1 : INT_CAN0))){
+                break;
+            }
+
+            //entering the ISR clears the software pend
+            if(n < 2){
+                MIL_CAN_SimPended[n] = false;
+            }
+
+            if(calls++ == MIL_CAN_SIM_ISR_LIMIT){
+                pnode->stats.isr_stuck++;
+                break;
+            }
+
+            pnode->stats.isr_calls++;
+            pnode->handler();
+
+        }
+
+    }
+
+}
+
+/**************************************************SIMULATION API*************************************************************/
+
+/*
+ * Desc: puts every node back in reset, clears the buses and time
+ *
+ * Parameters:
+ * clock - what SysCtlClockGet should return
+ */
+void MIL_CAN_SimReset(uint32_t clock){
+
+    uint8_t *p = (uint8_t *)MIL_CAN_SimNode;
+
+    for(uint32_t i = 0;i < sizeof(MIL_CAN_SimNode);i++){
+        p[i] = 0;
+    }
+
+    p = (uint8_t *)MIL_CAN_SimBus;
+
+    for(uint32_t i = 0;i < sizeof(MIL_CAN_SimBus);i++){
+        p[i] = 0;
+    }
+
+    p = (uint8_t *)MIL_CAN_SimTimer;
+
+    for(uint32_t i = 0;i < sizeof(MIL_CAN_SimTimer);i++){
+        p[i] = 0;
+    }
+
+    for(uint32_t i = 0;i < sizeof(MIL_CAN_SimNvic);i++){
+        MIL_CAN_SimNvic[i] = 0;
+    }
+    MIL_CAN_SimPended[0] = false;
+    MIL_CAN_SimPended[1] = false;
+
+    for(uint8_t n = 0;n < MIL_CAN_SIM_NODES;n++){
+        MIL_CAN_SimNode[n].init = true;
+        MIL_CAN_SimNode[n].retry = true;
+        MIL_CAN_SimNode[n].bps = 500000;
+        MIL_CAN_SimNode[n].status = CAN_STATUS_LEC_MSK;
+    }
+
+    MIL_CAN_SimIntMaster = true;
+    MIL_CAN_SimNow = 0;
+    MIL_CAN_SimClock = clock;
+
+}
+
+/*
+ * Desc: moves a node to another bus
+ *
+ * Parameters:
+ * base - CAN0_BASE, CAN1_BASE or MIL_CAN_SIM_NODE(n)
+ * bus - 0 to MIL_CAN_SIM_BUSES - 1
+ */
+void MIL_CAN_SimConnect(uint32_t base,uint8_t bus){
+
+    if(bus < MIL_CAN_SIM_BUSES){
+        MIL_CAN_SimNodeGet(base)->bus = bus;
+    }
+
+}
+
+/*
+ * Desc: runs the buses for a while
+ *
+ * Parameters:
+ * us - microseconds of virtual time to run
+ */
+void MIL_CAN_SimRun(uint32_t us){
+
+    uint64_t end = MIL_CAN_SimNow + (uint64_t)us * 1000;
+
+    //anything the firmware did since the last run might want servicing
+    MIL_CAN_SimDispatch();
+
+    while(1){
+
+        uint64_t next = MIL_CAN_SIM_NO_EVENT;
+        int8_t next_bus = -1;
+        int8_t next_node = -1;
+        int8_t next_timer = -1;
+
+        for(uint8_t b = 0;b < MIL_CAN_SIM_BUSES;b++){
+            if(!MIL_CAN_SimBus[b].busy){
+                MIL_CAN_SimArbitrate(b);
+            }
+            if(MIL_CAN_SimBus[b].busy && (MIL_CAN_SimBus[b].end_ns < next)){
+                next = MIL_CAN_SimBus[b].end_ns;
+                next_bus = b;
+            }
+        }
+
+        //bus off recoveries and suspended transmitters are events too
+        for(uint8_t n = 0;n < MIL_CAN_SIM_NODES;n++){
+            mil_can_sim_node_t *pnode = &MIL_CAN_SimNode[n];
+            if(pnode->recover_ns && (pnode->recover_ns < next)){
+                next = pnode->recover_ns;
+                next_bus = -1;
+                next_node = n;
+            }
+            if((pnode->suspend_ns > MIL_CAN_SimNow) && (pnode->suspend_ns < next)){
+                next = pnode->suspend_ns;
+                next_bus = -1;
+                next_node = -1;
+            }
+        }
+
+        for(uint8_t t = 0;t < MIL_CAN_SIM_TIMERS;t++){
+            if(MIL_CAN_SimTimer[t].enabled && (MIL_CAN_SimTimer[t].next_ns < next)){
+                next = MIL_CAN_SimTimer[t].next_ns;
+                next_bus = -1;
+                next_node = -1;
+                next_timer = t;
+            }
+        }
+
+        if(next > end){
+            break;
+        }
+
+        MIL_CAN_SimNow = next;
+
+        if(next_timer >= 0){
+            mil_can_sim_timer_t *ptimer = &MIL_CAN_SimTimer[next_timer];
+            if(ptimer->periodic){
+                ptimer->next_ns += MIL_CAN_SimTimerPeriodNs(ptimer);
+            }
+            else{
+                ptimer->enabled = false;
+            }
+            if(ptimer->int_enabled && ptimer->handler && MIL_CAN_SimIntMaster){
+                ptimer->handler();
+            }
+        }
+        else if(next_bus >= 0){
+            MIL_CAN_SimComplete(next_bus);
+        }
+        else if(next_node >= 0){
+            mil_can_sim_node_t *pnode = &MIL_CAN_SimNode[next_node];
+            pnode->recover_ns = 0;
+            pnode->tec = 0;
+            pnode->rec = 0;
+            MIL_CAN_SimErrUpdate(pnode);
+        }
+
+        MIL_CAN_SimDispatch();
+
+    }
+
+    MIL_CAN_SimNow = end;
+
+}
+
+/*
+ * Desc: virtual time in microseconds, pass it as MIL_CAN's time_us
+ */
+uint32_t MIL_CAN_SimTimeUs(void){
+
+    return (uint32_t)(MIL_CAN_SimNow / 1000);
+
+}
+
+/*
+ * Desc: destroys the next few frames on a bus with an error frame
+ *
+ * Parameters:
+ * bus - bus to disturb
+ * num_frames - how many frames in a row to destroy
+ * lec - CAN_STATUS_LEC_xxx every node sees(STUFF, FORM, CRC, BIT0...)
+ */
+void MIL_CAN_SimInjectErrors(uint8_t bus,uint32_t num_frames,uint8_t lec){
+
+    if(bus < MIL_CAN_SIM_BUSES){
+        MIL_CAN_SimBus[bus].inject = num_frames;
+        MIL_CAN_SimBus[bus].inject_lec = lec & CAN_STATUS_LEC_MSK;
+    }
+
+}
+
+/*
+ * Desc: copies out bus and node statistics
+ */
+void MIL_CAN_SimBusStatsGet(uint8_t bus,MIL_CAN_SimBusStats_t *pstats){
+
+    if(bus < MIL_CAN_SIM_BUSES){
+        *pstats = MIL_CAN_SimBus[bus].stats;
+        pstats->busy_us = MIL_CAN_SimBus[bus].busy_ns / 1000;
+    }
+
+}
+
+void MIL_CAN_SimNodeStatsGet(uint32_t base,MIL_CAN_SimNodeStats_t *pstats){
+
+    *pstats = MIL_CAN_SimNodeGet(base)->stats;
+
+}
+
+/**************************************************DRIVERLIB CAN*************************************************************/
+
+void CANInit(uint32_t ui32Base){
+
+    mil_can_sim_node_t *pnode = MIL_CAN_SimNodeGet(ui32Base);
+
+    pnode->init = true;
+
+    for(uint8_t i = 0;i < 32;i++){
+        pnode->obj[i].msgval = false;
+        pnode->obj[i].txrqst = false;
+        pnode->obj[i].newdat = false;
+        pnode->obj[i].msglst = false;
+        pnode->obj[i].intpnd = false;
+    }
+
+}
+
+void CANEnable(uint32_t ui32Base){
+
+    mil_can_sim_node_t *pnode = MIL_CAN_SimNodeGet(ui32Base);
+
+    pnode->init = false;
+
+    //leaving init after bus off starts the recovery count
+    if((pnode->status & CAN_STATUS_BUS_OFF) && !pnode->recover_ns){
+        pnode->recover_ns = MIL_CAN_SimNow + MIL_CAN_SimBitsToNs(MIL_CAN_SIM_RECOVERY_BITS,pnode->bps);
+    }
+
+}
+
+void CANDisable(uint32_t ui32Base){
+
+    MIL_CAN_SimNodeGet(ui32Base)->init = true;
+
+}
+
+uint32_t CANBitRateSet(uint32_t ui32Base,uint32_t ui32SourceClock,uint32_t ui32BitRate){
+
+    (void)ui32SourceClock;
+
+    MIL_CAN_SimNodeGet(ui32Base)->bps = ui32BitRate;
+
+    return ui32BitRate;
+
+}
+
+void CANBitTimingSet(uint32_t ui32Base,tCANBitClkParms *psClkParms){
+
+    uint32_t tq = 1 + psClkParms->ui32SyncPropPhase1Seg + psClkParms->ui32Phase2Seg;
+
+    MIL_CAN_SimNodeGet(ui32Base)->bps = MIL_CAN_SimClock / (psClkParms->ui32QuantumPrescaler * tq);
+
+}
+
+void CANRetrySet(uint32_t ui32Base,bool bAutoRetry){
+
+    MIL_CAN_SimNodeGet(ui32Base)->retry = bAutoRetry;
+
+}
+
+bool CANRetryGet(uint32_t ui32Base){
+
+    return MIL_CAN_SimNodeGet(ui32Base)->retry;
+
+}
+
+bool CANErrCntrGet(uint32_t ui32Base,uint32_t *pui32RxCount,uint32_t *pui32TxCount){
+
+    mil_can_sim_node_t *pnode = MIL_CAN_SimNodeGet(ui32Base);
+
+    *pui32RxCount = pnode->rec > 127 ? 127 : pnode->rec;
+    *pui32TxCount = pnode->tec > 255 ? 255 : pnode->tec;
+
+    return pnode->rec > 127;
+
+}
+
+void CANIntEnable(uint32_t ui32Base,uint32_t ui32IntFlags){
+
+    mil_can_sim_node_t *pnode = MIL_CAN_SimNodeGet(ui32Base);
+
+    pnode->ie |= (ui32IntFlags & CAN_INT_MASTER) != 0;
+    pnode->sie |= (ui32IntFlags & CAN_INT_STATUS) != 0;
+    pnode->eie |= (ui32IntFlags & CAN_INT_ERROR) != 0;
+
+}
+
+void CANIntDisable(uint32_t ui32Base,uint32_t ui32IntFlags){
+
+    mil_can_sim_node_t *pnode = MIL_CAN_SimNodeGet(ui32Base);
+
+    pnode->ie &= !(ui32IntFlags & CAN_INT_MASTER);
+    pnode->sie &= !(ui32IntFlags & CAN_INT_STATUS);
+    pnode->eie &= !(ui32IntFlags & CAN_INT_ERROR);
+
+}
+
+void CANIntRegister(uint32_t ui32Base,void (*pfnHandler)(void)){
+
+    MIL_CAN_SimNodeGet(ui32Base)->handler = pfnHandler;
+
+    if(ui32Base == CAN0_BASE){
+        IntEnable(INT_CAN0);
+    }
+    else if(ui32Base == CAN1_BASE){
+        IntEnable(INT_CAN1);
+    }
+
+}
+
+void CANIntUnregister(uint32_t ui32Base){
+
+    MIL_CAN_SimNodeGet(ui32Base)->handler = 0;
+
+}
+
+uint32_t CANIntStatus(uint32_t ui32Base,tCANIntStsReg eIntStsReg){
+
+    mil_can_sim_node_t *pnode = MIL_CAN_SimNodeGet(ui32Base);
+    uint32_t pending = 0;
+
+    for(uint8_t i = 0;i < 32;i++){
+        if(pnode->obj[i].intpnd){
+            pending |= 1UL << i;
+        }
+    }
+
+    if(eIntStsReg == CAN_INT_STS_OBJECT){
+        return pending;
+    }
+
+    //status beats every message object
+    if(pnode->sts_int){
+        return CAN_INT_INTID_STATUS;
+    }
+
+    for(uint8_t i = 0;i < 32;i++){
+        if(pending & (1UL << i)){
+            return i + 1;
+        }
+    }
+
+    return 0;
+
+}
+
+void CANIntClear(uint32_t ui32Base,uint32_t ui32IntClr){
+
+    mil_can_sim_node_t *pnode = MIL_CAN_SimNodeGet(ui32Base);
+
+    if(ui32IntClr == CAN_INT_INTID_STATUS){
+        pnode->sts_int = false;
+    }
+    else if((ui32IntClr >= 1) && (ui32IntClr <= 32)){
+        pnode->obj[ui32IntClr - 1].intpnd = false;
+    }
+
+}
+
+/*
+ * Desc: reading the control register acknowledges the status interrupt
+ *       and resets TXOK, RXOK and the last error code like driverlib does
+ */
+uint32_t CANStatusGet(uint32_t ui32Base,tCANStsReg eStatusReg){
+
+    mil_can_sim_node_t *pnode = MIL_CAN_SimNodeGet(ui32Base);
+    uint32_t status = 0;
+
+    switch(eStatusReg){
+
+        case CAN_STS_CONTROL:
+            status = pnode->status;
+            pnode->status = (pnode->status & ~(CAN_STATUS_TXOK | CAN_STATUS_RXOK)) | CAN_STATUS_LEC_MSK;
+            pnode->sts_int = false;
+            break;
+
+        case CAN_STS_TXREQUEST:
+            for(uint8_t i = 0;i < 32;i++){
+                status |= (uint32_t)pnode->obj[i].txrqst << i;
+            }
+            break;
+
+        case CAN_STS_NEWDAT:
+            for(uint8_t i = 0;i < 32;i++){
+                status |= (uint32_t)pnode->obj[i].newdat << i;
+            }
+            break;
+
+        case CAN_STS_MSGVAL:
+            for(uint8_t i = 0;i < 32;i++){
+                status |= (uint32_t)pnode->obj[i].msgval << i;
+            }
+            break;
+
+        default:
+            break;
+
+    }
+
+    return status;
+
+}
+
+void CANMessageSet(uint32_t ui32Base,uint32_t ui32ObjID,tCANMsgObject *psMsgObject,tMsgObjType eMsgType){
+
+    mil_can_sim_obj_t *pobj;
+    uint32_t flags = psMsgObject->ui32Flags;
+    bool xtd;
+
+    if((ui32ObjID < 1) || (ui32ObjID > 32)){
+        return;
+    }
+
+    pobj = &MIL_CAN_SimNodeGet(ui32Base)->obj[ui32ObjID - 1];
+
+    //driverlib picks extended IDs on its own once the ID needs it
+    xtd = (flags & MSG_OBJ_EXTENDED_ID) || (psMsgObject->ui32MsgID > 0x7FF);
+
+    pobj->msgval = true;
+    pobj->dir_tx = (eMsgType == MSG_OBJ_TYPE_TX) || (eMsgType == MSG_OBJ_TYPE_TX_REMOTE);
+    pobj->xtd = xtd;
+    pobj->id = MIL_CAN_SimRegId(psMsgObject->ui32MsgID,xtd);
+    pobj->umask = (flags & MSG_OBJ_USE_ID_FILTER) != 0;
+    pobj->mxtd = (flags & MSG_OBJ_USE_EXT_FILTER) == MSG_OBJ_USE_EXT_FILTER;
+    pobj->mask = MIL_CAN_SimRegId(psMsgObject->ui32MsgIDMask,xtd);
+    pobj->eob = !(flags & MSG_OBJ_FIFO);
+    pobj->txie = (flags & MSG_OBJ_TX_INT_ENABLE) != 0;
+    pobj->rxie = (flags & MSG_OBJ_RX_INT_ENABLE) != 0;
+    pobj->dlc = psMsgObject->ui32MsgLen > 8 ? 8 : (uint8_t)psMsgObject->ui32MsgLen;
+    pobj->msglst = false;
+    pobj->intpnd = false;
+
+    for(uint8_t b = 0;b < pobj->dlc;b++){
+        pobj->data[b] = psMsgObject->pui8MsgData[b];
+    }
+
+    pobj->newdat = pobj->dir_tx;
+    pobj->txrqst = pobj->dir_tx;
+
+}
+
+/*
+ * Desc: like driverlib, data is only copied when the object has new
+ *       data, and reading it clears NEWDAT and MSGLST
+ */
+void CANMessageGet(uint32_t ui32Base,uint32_t ui32ObjID,tCANMsgObject *psMsgObject,bool bClrPendingInt){
+
+    mil_can_sim_obj_t *pobj;
+    uint32_t flags = 0;
+
+    if((ui32ObjID < 1) || (ui32ObjID > 32)){
+        return;
+    }
+
+    pobj = &MIL_CAN_SimNodeGet(ui32Base)->obj[ui32ObjID - 1];
+
+    if(pobj->xtd){
+        psMsgObject->ui32MsgID = pobj->id;
+        psMsgObject->ui32MsgIDMask = pobj->mask;
+        flags |= MSG_OBJ_EXTENDED_ID;
+    }
+    else{
+        psMsgObject->ui32MsgID = pobj->id >> 18;
+        psMsgObject->ui32MsgIDMask = pobj->mask >> 18;
+    }
+
+    if(pobj->umask){
+        flags |= pobj->mxtd ? MSG_OBJ_USE_EXT_FILTER : MSG_OBJ_USE_ID_FILTER;
+    }
+    if(pobj->txie){
+        flags |= MSG_OBJ_TX_INT_ENABLE;
+    }
+    if(pobj->rxie){
+        flags |= MSG_OBJ_RX_INT_ENABLE;
+    }
+    if(pobj->msglst){
+        flags |= MSG_OBJ_DATA_LOST;
+        pobj->msglst = false;
+    }
+
+    psMsgObject->ui32MsgLen = pobj->dlc;
+
+    if(pobj->newdat){
+
+        if(psMsgObject->pui8MsgData){
+            for(uint8_t b = 0;b < pobj->dlc;b++){
+                psMsgObject->pui8MsgData[b] = pobj->data[b];
+            }
+        }
+
+        flags |= MSG_OBJ_NEW_DATA;
+        pobj->newdat = false;
+
+    }
+
+    if(bClrPendingInt){
+        pobj->intpnd = false;
+    }
+
+    psMsgObject->ui32Flags = flags;
+
+}
+
+void CANMessageClear(uint32_t ui32Base,uint32_t ui32ObjID){
+
+    if((ui32ObjID >= 1) && (ui32ObjID <= 32)){
+        MIL_CAN_SimNodeGet(ui32Base)->obj[ui32ObjID - 1].msgval = false;
+        MIL_CAN_SimNodeGet(ui32Base)->obj[ui32ObjID - 1].txrqst = false;
+    }
+
+}
+
+/**************************************************EVERYTHING ELSE MIL_CAN CALLS*************************************************************/
+
+void IntEnable(uint32_t ui32Interrupt){
+
+    MIL_CAN_SimNvic[(ui32Interrupt & 0xFF) / 8] |= 1 << (ui32Interrupt % 8);
+
+}
+
+void IntDisable(uint32_t ui32Interrupt){
+
+    MIL_CAN_SimNvic[(ui32Interrupt & 0xFF) / 8] &= ~(1 << (ui32Interrupt % 8));
+
+}
+
+uint32_t IntIsEnabled(uint32_t ui32Interrupt){
+
+    return (MIL_CAN_SimNvic[(ui32Interrupt & 0xFF) / 8] >> (ui32Interrupt % 8)) & 1;
+
+}
+
+void IntPendSet(uint32_t ui32Interrupt){
+
+    //only the CAN interrupts are modeled, it's taken on the next dispatch
+    if(ui32Interrupt == INT_CAN0){
+        MIL_CAN_SimPended[0] = true;
+    }
+    else if(ui32Interrupt == INT_CAN1){
+        MIL_CAN_SimPended[1] = true;
+    }
+
+}
+
+bool IntMasterEnable(void){
+
+    bool was_off = !MIL_CAN_SimIntMaster;
+
+    MIL_CAN_SimIntMaster = true;
+
+    return was_off;
+
+}
+
+bool IntMasterDisable(void){
+
+    bool was_off = !MIL_CAN_SimIntMaster;
+
+    MIL_CAN_SimIntMaster = false;
+
+    return was_off;
+
+}
+
+uint32_t SysCtlClockGet(void){
+
+    return MIL_CAN_SimClock;
+
+}
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral){
+
+    (void)ui32Peripheral;
+
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral){
+
+    (void)ui32Peripheral;
+
+    return true;
+
+}
+
+void GPIOPinConfigure(uint32_t ui32PinConfig){
+
+    (void)ui32PinConfig;
+
+}
+
+void GPIOPinTypeCAN(uint32_t ui32Port,uint8_t ui8Pins){
+
+    (void)ui32Port;
+    (void)ui8Pins;
+
+}
+
+/**************************************************TIMERS*************************************************************/
+
+void TimerConfigure(uint32_t ui32Base,uint32_t ui32Config){
+
+    mil_can_sim_timer_t *ptimer = MIL_CAN_SimTimerGet(ui32Base);
+
+    ptimer->enabled = false;
+    ptimer->periodic = ((ui32Config & 0x0F) == (TIMER_CFG_PERIODIC & 0x0F));
+
+}
+
+void TimerLoadSet(uint32_t ui32Base,uint32_t ui32Timer,uint32_t ui32Value){
+
+    (void)ui32Timer;
+
+    MIL_CAN_SimTimerGet(ui32Base)->load = ui32Value;
+
+}
+
+void TimerEnable(uint32_t ui32Base,uint32_t ui32Timer){
+
+    mil_can_sim_timer_t *ptimer = MIL_CAN_SimTimerGet(ui32Base);
+
+    (void)ui32Timer;
+
+    //enabling a running timer doesn't restart it
+    if(!ptimer->enabled){
+        ptimer->enabled = true;
+        ptimer->next_ns = MIL_CAN_SimNow + MIL_CAN_SimTimerPeriodNs(ptimer);
+    }
+
+}
+
+void TimerDisable(uint32_t ui32Base,uint32_t ui32Timer){
+
+    (void)ui32Timer;
+
+    MIL_CAN_SimTimerGet(ui32Base)->enabled = false;
+
+}
+
+void TimerIntRegister(uint32_t ui32Base,uint32_t ui32Timer,void (*pfnHandler)(void)){
+
+    (void)ui32Timer;
+
+    MIL_CAN_SimTimerGet(ui32Base)->handler = pfnHandler;
+
+}
+
+void TimerIntEnable(uint32_t ui32Base,uint32_t ui32IntFlags){
+
+    if(ui32IntFlags & TIMER_TIMA_TIMEOUT){
+        MIL_CAN_SimTimerGet(ui32Base)->int_enabled = true;
+    }
+
+}
+
+void TimerIntDisable(uint32_t ui32Base,uint32_t ui32IntFlags){
+
+    if(ui32IntFlags & TIMER_TIMA_TIMEOUT){
+        MIL_CAN_SimTimerGet(ui32Base)->int_enabled = false;
+    }
+
+}
+
+void TimerIntClear(uint32_t ui32Base,uint32_t ui32IntFlags){
+
+    //timeouts are delivered once each, nothing is left to clear
+    (void)ui32Base;
+    (void)ui32IntFlags;
+
+}
@@ -0,0 +1,182 @@
+/*
+ * Name: MIL_CAN_Sim.h
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: A virtual TIVA CAN controller and bus for running MIL_CAN on a PC
+ *
+ * WHAT THIS IS FOR:
+ * Testing CAN code on real boards means a pile of launchpads, a
+ * transceiver per board and a lot of waiting to hit the one timing
+ * that breaks things. This file implements the driverlib CAN calls
+ * (CANMessageSet, CANMessageGet, CANStatusGet, CANIntStatus,
+ * CANIntRegister and friends) against a model of the controller so
+ * MIL_CAN and anything built on it compiles and runs on Linux,
+ * with several nodes sharing a bus and everything deterministic.
+ *
+ * WHAT IS MODELED:
+ * -32 message objects per node with MSGVAL, NEWDAT, MSGLST, TXRQST
+ *  and INTPND like the real thing
+ * -acceptance filtering, received frames go in the lowest numbered
+ *  object that matches, FIFO chains(MSG_OBJ_FIFO) fill in order and
+ *  a full object gets overwritten with MSG_OBJ_DATA_LOST set
+ * -transmit order, each node offers its lowest numbered pending object
+ * -arbitration, the lowest ID on the bus wins and the others retry
+ *  after the frame
+ * -frame length down to the bit, the real stuff bits for the frame's
+ *  ID, data and CRC are counted so bus timing matches a scope
+ * -error counters, error warning/passive/bus off, bus off recovery
+ *  after 128 x 11 recessive bits, missing ACK with a lone node
+ * -interrupt cause(CANIntStatus) and status interrupts the way
+ *  CANStatusGet/CANIntClear acknowledge them
+ * -IntPendSet on INT_CAN0/INT_CAN1, the ISR runs at the next dispatch
+ *  even with no interrupt source set
+ * -timer A of TIMER0 to TIMER5 as a periodic or one shot timeout
+ *  interrupt(TimerConfigure, TimerLoadSet, TimerIntRegister...) so
+ *  code that drives CAN from a timer runs too
+ *
+ * WHAT ISN'T:
+ * remote frames, test/silent/loopback modes, bit errors inside a
+ * frame(use MIL_CAN_SimInjectErrors instead) and ISRs interrupting
+ * each other, an ISR always runs to completion
+ *
+ * NODES:
+ * CAN0_BASE and CAN1_BASE are the firmware under test, every other
+ * node is addressed with MIL_CAN_SIM_NODE(n) and driven by your test
+ * code with the same driverlib calls, e.g.
+ *
+ *      CANMessageSet(MIL_CAN_SIM_NODE(2),1,&msg,MSG_OBJ_TYPE_TX);
+ *
+ * Every node starts on bus 0, MIL_CAN_SimConnect moves it.
+ *
+ * TIME:
+ * Nothing happens on the bus until you call MIL_CAN_SimRun, it moves
+ * virtual time forward and runs ISRs as frames finish. Use
+ * MIL_CAN_SimTimeUs anywhere MIL_CAN wants a microsecond clock.
+ *
+ * HOW TO USE:
+ * build MIL_CAN.c and this file with gcc against the TivaWare headers
+ * instead of linking driverlib, then
+ *
+ *      MIL_CAN_SimReset(16000000);
+ *      MIL_InitCAN(MIL_CAN_PORT_B,CAN0_BASE,200000);
+ *      MIL_CANIntEnable(MIL_CAN0_ISR,CAN0_BASE);
+ *      ...set up the other nodes...
+ *      MIL_CAN_SimRun(1000);   //1ms of bus time
+ *
+ * If your firmware puts its ISR in the startup file vector table
+ * instead of using CANIntRegister, call CANIntRegister from the test
+ * so the simulator knows what to run.
+ *
+ * NOTE: this file provides the GPIO, SysCtl, NVIC and timer calls
+ *       MIL_CAN makes as well, don't link it with the real driverlib
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_CAN_SIM_H_
+#define MIL_CAN_SIM_H_
+
+#ifndef MIL_CAN_SIM_NODES
+#define MIL_CAN_SIM_NODES 8
+#endif
+
+#ifndef MIL_CAN_SIM_BUSES
+#define MIL_CAN_SIM_BUSES 2
+#endif
+
+/*
+ * Desc: base address for simulated node n(2 and up),
+ *       node 0 is CAN0_BASE and node 1 is CAN1_BASE
+ */
+#define MIL_CAN_SIM_NODE_BASE 0xC0000000UL
+#define MIL_CAN_SIM_NODE(n)   (MIL_CAN_SIM_NODE_BASE + (uint32_t)(n))
+
+/*
+ * Desc: bus statistics
+ *
+ * frames - frames sent successfully
+ * errors - frames destroyed by an error(injected or missing ACK)
+ * bits - bits on the wire including stuff bits and interframe space
+ * busy_us - time the bus wasn't idle
+ */
+typedef struct{
+
+  uint32_t frames;
+  uint32_t errors;
+  uint64_t bits;
+  uint64_t busy_us;
+
+} MIL_CAN_SimBusStats_t;
+
+/*
+ * Desc: node statistics
+ *
+ * tx_frames - frames this node sent
+ * rx_frames - frames stored in one of its message objects
+ * rx_unmatched - frames no message object accepted
+ * rx_overruns - frames that overwrote unread data(MSGLST)
+ * arb_lost - arbitrations lost to a lower ID
+ * isr_calls - times its ISR ran
+ * isr_stuck - times its ISR returned without clearing the interrupt
+ *             64 times in a row(the simulator gave up on it)
+ */
+typedef struct{
+
+  uint32_t tx_frames;
+  uint32_t rx_frames;
+  uint32_t rx_unmatched;
+  uint32_t rx_overruns;
+  uint32_t arb_lost;
+  uint32_t isr_calls;
+  uint32_t isr_stuck;
+
+} MIL_CAN_SimNodeStats_t;
+
+/*
+ * Desc: puts every node back in reset, clears the buses and time
+ *
+ * Parameters:
+ * clock - what SysCtlClockGet should return
+ */
+void MIL_CAN_SimReset(uint32_t clock);
+
+/*
+ * Desc: moves a node to another bus
+ *
+ * Parameters:
+ * base - CAN0_BASE, CAN1_BASE or MIL_CAN_SIM_NODE(n)
+ * bus - 0 to MIL_CAN_SIM_BUSES - 1
+ */
+void MIL_CAN_SimConnect(uint32_t base,uint8_t bus);
+
+/*
+ * Desc: runs the buses for a while
+ *
+ * Parameters:
+ * us - microseconds of virtual time to run
+ */
+void MIL_CAN_SimRun(uint32_t us);
+
+/*
+ * Desc: virtual time in microseconds, pass it as MIL_CAN's time_us
+ */
+uint32_t MIL_CAN_SimTimeUs(void);
+
+/*
+ * Desc: destroys the next few frames on a bus with an error frame
+ *
+ * Parameters:
+ * bus - bus to disturb
+ * num_frames - how many frames in a row to destroy
+ * lec - CAN_STATUS_LEC_xxx every node sees(STUFF, FORM, CRC, BIT0...)
+ */
+void MIL_CAN_SimInjectErrors(uint8_t bus,uint32_t num_frames,uint8_t lec);
+
+/*
+ * Desc: copies out bus and node statistics
+ */
+void MIL_CAN_SimBusStatsGet(uint8_t bus,MIL_CAN_SimBusStats_t *pstats);
+void MIL_CAN_SimNodeStatsGet(uint32_t base,MIL_CAN_SimNodeStats_t *pstats);
+
+#endif /* MIL_CAN_SIM_H_ */
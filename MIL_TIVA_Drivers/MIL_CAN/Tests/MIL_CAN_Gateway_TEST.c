@@ -0,0 +1,282 @@
+/*
+ * Name: MIL_CAN gateway test
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Host test of MIL_CAN_Gateway on the simulator with CAN0 and CAN1
+ *       on separate buses, forwards in both directions, keeps a copy with
+ *       MIL_CAN_GW_KEEP, drops the second copy of a redundant frame and
+ *       lets it through again once the dedup window has run out
+ *
+ * TEST NOTES:
+ * CAN0 sits on sim bus 0 with peer node 2, CAN1 on bus 1 with peer node 3.
+ * Each peer listens for the range forwarded onto its bus, so a frame only
+ * reaches the other peer if the gateway sent it across.
+ *
+ * HOW TO BUILD:
+ * from MIL_CAN/Tests, with TIVAWARE pointing at your TivaWare install
+ *
+ *      gcc -std=gnu99 -I$TIVAWARE -I.. -I../Sim MIL_CAN_Gateway_TEST.c
+ *          ../MIL_CAN.c ../MIL_CAN_Gateway.c ../Sim/MIL_CAN_Sim.c -o gw_test
+ *
+ * then ./gw_test, it prints every check and returns non zero if any failed
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/can.h"
+
+#include "MIL_CAN.h"
+#include "MIL_CAN_Gateway.h"
+#include "MIL_CAN_Sim.h"
+
+/********DEFINES START******/
+#define TEST_BPS        500000
+#define TEST_PEER0      MIL_CAN_SIM_NODE(2)    //on CAN0's bus
+#define TEST_PEER1      MIL_CAN_SIM_NODE(3)    //on CAN1's bus
+#define TEST_PEER_TX    1
+#define TEST_PEER_RX    10
+#define TEST_WINDOW_US  2000
+
+//a forwarded frame crosses both buses, ~250us each at 500k
+#define TEST_FRAME_US   1000
+/********DEFINES END******/
+
+static const MIL_CAN_GwRoute_t test_routes[] = {
+    {0x100,0x1FF,0x7FF,MIL_CAN_GW_0TO1},
+    {0x200,0x2FF,0x7FF,MIL_CAN_GW_1TO0 | MIL_CAN_GW_KEEP},
+    {0x000,0x00F,0x7FF,MIL_CAN_GW_REDUNDANT},
+};
+
+static uint32_t test_failures;
+
+static void TEST_EQ(const char *pname,uint32_t got,uint32_t want){
+
+    printf("%-44s got %5u want %5u %s\n",pname,got,want,(got == want) ? "ok" : "FAIL");
+
+    if(got != want){
+        test_failures++;
+    }
+
+}
+
+/*
+ * Desc: brings up a peer on a bus, listening for canid/mask
+ */
+static void TEST_PeerInit(uint32_t peer,uint8_t bus,uint32_t canid,uint32_t mask){
+
+    static uint8_t rx_data[8];
+    tCANMsgObject msg;
+
+    MIL_CAN_SimConnect(peer,bus);
+    CANInit(peer);
+    CANBitRateSet(peer,0,TEST_BPS);
+    CANEnable(peer);
+
+    msg.ui32MsgID = canid;
+    msg.ui32MsgIDMask = mask;
+    msg.ui32Flags = MSG_OBJ_USE_ID_FILTER;
+    msg.ui32MsgLen = 8;
+    msg.pui8MsgData = rx_data;
+    CANMessageSet(peer,TEST_PEER_RX,&msg,MSG_OBJ_TYPE_RX);
+
+}
+
+/*
+ * Desc: a peer sends one frame with value in the first byte
+ */
+static void TEST_PeerSend(uint32_t peer,uint32_t canid,uint8_t value){
+
+    uint8_t data[8] = {value,0x5A,0,0,0,0,0,value};
+    tCANMsgObject msg;
+
+    msg.ui32MsgID = canid;
+    msg.ui32Flags = 0;
+    msg.ui32MsgLen = 8;
+    msg.pui8MsgData = data;
+    CANMessageSet(peer,TEST_PEER_TX,&msg,MSG_OBJ_TYPE_TX);
+
+}
+
+/*
+ * Desc: frames a peer has received so far
+ */
+static uint32_t TEST_PeerRxCount(uint32_t peer){
+
+    MIL_CAN_SimNodeStats_t stats;
+
+    MIL_CAN_SimNodeStatsGet(peer,&stats);
+
+    return stats.rx_frames;
+
+}
+
+/*
+ * Desc: ID and first byte of the last frame a peer received, packed as
+ *       (canid << 8) | value
+ */
+static uint32_t TEST_PeerLast(uint32_t peer){
+
+    uint8_t data[8];
+    tCANMsgObject msg;
+
+    msg.pui8MsgData = data;
+    CANMessageGet(peer,TEST_PEER_RX,&msg,0);
+
+    return (msg.ui32MsgID << 8) | data[0];
+
+}
+
+/*
+ * Desc: empties a module's receive queue
+ *
+ * Returns:
+ * number of frames that were in it, the last one is copied to plast
+ */
+static uint32_t TEST_Drain(uint32_t base,MIL_CAN_Frame_t *plast){
+
+    MIL_CAN_Frame_t frame;
+    uint32_t count = 0;
+
+    while(MIL_CAN_RxQueueGet(base,&frame) == MIL_CAN_OK){
+        *plast = frame;
+        count++;
+    }
+
+    return count;
+
+}
+
+int main(void){
+
+    static const uint32_t bases[2] = {CAN0_BASE,CAN1_BASE};
+    static const uint32_t mailbox_ids[3] = {0x100,0x200,0x000};
+    static MIL_CAN_MailBox_t mailboxes[2][3];
+    static uint8_t mailbox_data[2][3][8];
+    MIL_CAN_GwStats_t stats;
+    MIL_CAN_Frame_t frame;
+
+    MIL_CAN_SimReset(16000000);
+    MIL_CAN_SimConnect(CAN1_BASE,1);
+
+    MIL_InitCAN(MIL_CAN_PORT_B,CAN0_BASE,TEST_BPS);
+    MIL_InitCAN(MIL_CAN_PORT_A,CAN1_BASE,TEST_BPS);
+
+    //each peer only hears what gets forwarded onto its bus
+    TEST_PeerInit(TEST_PEER0,0,0x200,0x700);
+    TEST_PeerInit(TEST_PEER1,1,0x100,0x700);
+
+    for(uint8_t i = 0;i < 2;i++){
+
+        MIL_CAN_RxQueueInit(bases[i]);
+
+        for(uint8_t j = 0;j < 3;j++){
+            mailboxes[i][j].canid = mailbox_ids[j];
+            mailboxes[i][j].filt_mask = 0x700;
+            mailboxes[i][j].base = bases[i];
+            mailboxes[i][j].msg_len = 8;
+            mailboxes[i][j].obj_num = 20 + j;
+            mailboxes[i][j].buffer = mailbox_data[i][j];
+            MIL_CAN_RxQueueAttach(&mailboxes[i][j]);
+        }
+
+        MIL_CAN_TxClassInit(bases[i],MIL_CAN_TX_TELEMETRY,5,4);
+
+    }
+
+    MIL_CAN_GwInit(test_routes,3,MIL_CAN_TX_TELEMETRY,MIL_CAN_SimTimeUs,TEST_WINDOW_US);
+    MIL_CANIntEnable(MIL_CAN0_ISR,CAN0_BASE);
+    MIL_CANIntEnable(MIL_CAN1_ISR,CAN1_BASE);
+
+    /*********************CAN0 TO CAN1**************/
+
+    TEST_PeerSend(TEST_PEER0,0x150,0x11);
+    MIL_CAN_SimRun(TEST_FRAME_US);
+
+    MIL_CAN_GwStatsGet(&stats);
+    TEST_EQ("0to1 forwarded[0]",stats.forwarded[0],1);
+    TEST_EQ("0to1 peer1 frames",TEST_PeerRxCount(TEST_PEER1),1);
+    TEST_EQ("0to1 peer1 got 0x150 0x11",TEST_PeerLast(TEST_PEER1),(0x150 << 8) | 0x11);
+    TEST_EQ("0to1 not echoed to peer0",TEST_PeerRxCount(TEST_PEER0),0);
+    //no KEEP, the gateway took it
+    TEST_EQ("0to1 CAN0 queue",TEST_Drain(CAN0_BASE,&frame),0);
+
+    /*********************CAN1 TO CAN0 WITH KEEP****/
+
+    TEST_PeerSend(TEST_PEER1,0x250,0x22);
+    MIL_CAN_SimRun(TEST_FRAME_US);
+
+    MIL_CAN_GwStatsGet(&stats);
+    TEST_EQ("1to0 forwarded[1]",stats.forwarded[1],1);
+    TEST_EQ("1to0 peer0 frames",TEST_PeerRxCount(TEST_PEER0),1);
+    TEST_EQ("1to0 peer0 got 0x250 0x22",TEST_PeerLast(TEST_PEER0),(0x250 << 8) | 0x22);
+    TEST_EQ("1to0 KEEP CAN1 queue",TEST_Drain(CAN1_BASE,&frame),1);
+    TEST_EQ("1to0 KEEP frame id",frame.canid,0x250);
+    TEST_EQ("1to0 KEEP frame data",frame.data[0],0x22);
+
+    /*********************WRONG DIRECTION***********/
+
+    //0x1xx only goes 0 to 1, from CAN1 it's just a local frame
+    TEST_PeerSend(TEST_PEER1,0x160,0x33);
+    MIL_CAN_SimRun(TEST_FRAME_US);
+
+    MIL_CAN_GwStatsGet(&stats);
+    TEST_EQ("wrong way forwarded[1]",stats.forwarded[1],1);
+    TEST_EQ("wrong way peer0 frames",TEST_PeerRxCount(TEST_PEER0),1);
+    TEST_EQ("wrong way CAN1 queue",TEST_Drain(CAN1_BASE,&frame),1);
+    TEST_EQ("wrong way frame id",frame.canid,0x160);
+
+    /*********************REDUNDANT*****************/
+
+    //the same frame on both buses, CAN0 sees it first
+    TEST_PeerSend(TEST_PEER0,0x003,0x44);
+    MIL_CAN_SimRun(TEST_FRAME_US / 2);
+    TEST_PeerSend(TEST_PEER1,0x003,0x44);
+    MIL_CAN_SimRun(TEST_FRAME_US / 2);
+
+    MIL_CAN_GwStatsGet(&stats);
+    TEST_EQ("redundant dup_dropped",stats.dup_dropped,1);
+    TEST_EQ("redundant first copy CAN0",TEST_Drain(CAN0_BASE,&frame),1);
+    TEST_EQ("redundant first copy id",frame.canid,0x003);
+    TEST_EQ("redundant second copy CAN1",TEST_Drain(CAN1_BASE,&frame),0);
+    TEST_EQ("redundant never forwarded[0]",stats.forwarded[0],1);
+    TEST_EQ("redundant never forwarded[1]",stats.forwarded[1],1);
+
+    //a different value isn't a copy
+    TEST_PeerSend(TEST_PEER0,0x003,0x45);
+    MIL_CAN_SimRun(TEST_FRAME_US / 2);
+    TEST_PeerSend(TEST_PEER1,0x003,0x46);
+    MIL_CAN_SimRun(TEST_FRAME_US / 2);
+
+    MIL_CAN_GwStatsGet(&stats);
+    TEST_EQ("different data dup_dropped",stats.dup_dropped,1);
+    TEST_EQ("different data CAN0",TEST_Drain(CAN0_BASE,&frame),1);
+    TEST_EQ("different data CAN1",TEST_Drain(CAN1_BASE,&frame),1);
+
+    /*********************WINDOW EXPIRY*************/
+
+    //the second copy shows up after the window, so it's new again
+    MIL_CAN_SimRun(TEST_WINDOW_US * 2);
+    TEST_PeerSend(TEST_PEER0,0x004,0x55);
+    MIL_CAN_SimRun(TEST_FRAME_US / 2);
+    MIL_CAN_SimRun(TEST_WINDOW_US * 2);
+    TEST_PeerSend(TEST_PEER1,0x004,0x55);
+    MIL_CAN_SimRun(TEST_FRAME_US / 2);
+
+    MIL_CAN_GwStatsGet(&stats);
+    TEST_EQ("expired dup_dropped",stats.dup_dropped,1);
+    TEST_EQ("expired CAN0",TEST_Drain(CAN0_BASE,&frame),1);
+    TEST_EQ("expired CAN1",TEST_Drain(CAN1_BASE,&frame),1);
+    TEST_EQ("expired frame data",frame.data[0],0x55);
+
+    MIL_CAN_GwStatsGet(&stats);
+    TEST_EQ("final fwd_dropped",stats.fwd_dropped,0);
+    TEST_EQ("final dedup_evicted",stats.dedup_evicted,0);
+
+    printf("%s, %u failed\n",test_failures ? "FAIL" : "PASS",test_failures);
+
+    return test_failures ? 1 : 0;
+
+}
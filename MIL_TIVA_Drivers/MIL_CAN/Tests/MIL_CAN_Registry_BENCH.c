@@ -0,0 +1,202 @@
+/*
+ * Name: MIL_CAN mailbox registry benchmark
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Counts the driverlib calls one pass over N mailboxes costs,
+ *       MIL_CAN_CheckMail + MIL_CAN_GetMail on each mailbox against one
+ *       MIL_CAN_RegistryDispatch, for 1 to 32 mailboxes
+ *
+ * BENCH NOTES:
+ * Runs on the simulator, the linker wraps CANStatusGet and CANMessageGet
+ * so every call MIL_CAN makes is counted. On the TM4C a CANStatusGet of
+ * NEWDAT is two 16 bit register reads and a CANMessageGet is a full
+ * IF2 transfer, so these counts are what the main loop pays in register
+ * traffic. Each size is measured with every mailbox holding new data
+ * and again with only one of them holding new data(the usual case).
+ *
+ * HOW TO BUILD:
+ * from MIL_CAN/Tests, with TIVAWARE pointing at your TivaWare install
+ *
+ *      gcc -std=gnu99 -I$TIVAWARE -I.. -I../Sim MIL_CAN_Registry_BENCH.c
+ *          ../MIL_CAN.c ../Sim/MIL_CAN_Sim.c
+ *          -Wl,--wrap=CANStatusGet -Wl,--wrap=CANMessageGet -o registry_bench
+ *
+ * then ./registry_bench, it returns non zero if the two ways disagree on
+ * how many frames there were
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/can.h"
+
+#include "MIL_CAN.h"
+#include "MIL_CAN_Sim.h"
+
+/********DEFINES START******/
+#define BENCH_BPS       1000000
+#define BENCH_CANID     0x100   //mailbox n listens to BENCH_CANID + n - 1
+#define BENCH_PEER      MIL_CAN_SIM_NODE(2)
+#define BENCH_FRAME_US  150
+/********DEFINES END******/
+
+/********COUNTING WRAPPERS START******/
+uint32_t __real_CANStatusGet(uint32_t ui32Base,tCANStsReg eStatusReg);
+void __real_CANMessageGet(uint32_t ui32Base,uint32_t ui32ObjID,tCANMsgObject *psMsgObject,bool bClrPendingInt);
+
+static uint32_t bench_status_gets;
+static uint32_t bench_message_gets;
+
+uint32_t __wrap_CANStatusGet(uint32_t ui32Base,tCANStsReg eStatusReg){
+
+    bench_status_gets++;
+    return __real_CANStatusGet(ui32Base,eStatusReg);
+
+}
+
+void __wrap_CANMessageGet(uint32_t ui32Base,uint32_t ui32ObjID,tCANMsgObject *psMsgObject,bool bClrPendingInt){
+
+    bench_message_gets++;
+    __real_CANMessageGet(ui32Base,ui32ObjID,psMsgObject,bClrPendingInt);
+
+}
+/********COUNTING WRAPPERS END******/
+
+static MIL_CAN_MailBox_t bench_mailbox[32];
+static uint8_t bench_buffer[32][8];
+static uint32_t bench_handled;
+
+static void BENCH_Handler(MIL_CAN_MailBox_t *pmailbox){
+
+    (void)pmailbox;
+    bench_handled++;
+
+}
+
+/*
+ * Desc: the peer sends one frame to each of the first num_full mailboxes
+ */
+static void BENCH_Fill(uint8_t num_full){
+
+    uint8_t data[8] = {1,2,3,4,5,6,7,8};
+    tCANMsgObject msg;
+
+    for(uint8_t i = 0;i < num_full;i++){
+
+        msg.ui32MsgID = BENCH_CANID + i;
+        msg.ui32Flags = 0;
+        msg.ui32MsgLen = 8;
+        msg.pui8MsgData = data;
+        CANMessageSet(BENCH_PEER,1,&msg,MSG_OBJ_TYPE_TX);
+
+        MIL_CAN_SimRun(BENCH_FRAME_US);
+
+    }
+
+}
+
+/*
+ * Desc: one main loop pass the old way, every mailbox checked on its own
+ */
+static uint32_t BENCH_Poll(uint8_t num_boxes){
+
+    uint32_t frames = 0;
+
+    for(uint8_t i = 0;i < num_boxes;i++){
+        if(MIL_CAN_CheckMail(&bench_mailbox[i]) == MIL_CAN_OK){
+            MIL_CAN_GetMail(&bench_mailbox[i]);
+            frames++;
+        }
+    }
+
+    return frames;
+
+}
+
+int main(void){
+
+    MIL_CAN_MailRegistry_t registry;
+    uint32_t mismatches = 0;
+
+    MIL_CAN_SimReset(16000000);
+    MIL_InitCAN(MIL_CAN_PORT_B,CAN0_BASE,BENCH_BPS);
+
+    CANInit(BENCH_PEER);
+    CANBitRateSet(BENCH_PEER,0,BENCH_BPS);
+    CANEnable(BENCH_PEER);
+
+    printf("                  every mailbox new          one mailbox new\n");
+    printf("mailboxes   poll sts/msg  registry sts/msg  poll sts/msg  registry sts/msg\n");
+
+    for(uint8_t num_boxes = 1;num_boxes <= 32;num_boxes++){
+
+        uint32_t poll_sts[2];
+        uint32_t poll_msg[2];
+        uint32_t reg_sts[2];
+        uint32_t reg_msg[2];
+
+        MIL_CAN_RegistryInit(&registry,CAN0_BASE);
+
+        for(uint8_t i = 0;i < num_boxes;i++){
+
+            bench_mailbox[i].canid = BENCH_CANID + i;
+            bench_mailbox[i].filt_mask = 0x7FF;
+            bench_mailbox[i].base = CAN0_BASE;
+            bench_mailbox[i].msg_len = 8;
+            bench_mailbox[i].obj_num = i + 1;
+            bench_mailbox[i].rx_flag_int = 0;
+            bench_mailbox[i].buffer = bench_buffer[i];
+
+            MIL_CAN_RegistryAdd(&registry,&bench_mailbox[i],BENCH_Handler);
+
+        }
+
+        //[0] every mailbox has a frame waiting, [1] only the last one does
+        for(uint8_t pass = 0;pass < 2;pass++){
+
+            uint32_t polled;
+
+            //same frames for both, reading the others first leaves only
+            //the last mailbox on the second pass
+            BENCH_Fill(num_boxes);
+            if(pass){
+                BENCH_Poll(num_boxes - 1);
+            }
+
+            bench_status_gets = 0;
+            bench_message_gets = 0;
+            polled = BENCH_Poll(num_boxes);
+            poll_sts[pass] = bench_status_gets;
+            poll_msg[pass] = bench_message_gets;
+
+            BENCH_Fill(num_boxes);
+            if(pass){
+                BENCH_Poll(num_boxes - 1);
+            }
+
+            bench_status_gets = 0;
+            bench_message_gets = 0;
+            bench_handled = 0;
+            MIL_CAN_RegistryDispatch(&registry);
+            reg_sts[pass] = bench_status_gets;
+            reg_msg[pass] = bench_message_gets;
+
+            if(polled != bench_handled){
+                mismatches++;
+            }
+
+        }
+
+        printf("%9u   %8u/%-3u  %12u/%-3u  %8u/%-3u  %12u/%-3u\n",num_boxes,
+               poll_sts[0],poll_msg[0],reg_sts[0],reg_msg[0],
+               poll_sts[1],poll_msg[1],reg_sts[1],reg_msg[1]);
+
+    }
+
+    printf("mismatches %u\n",mismatches);
+
+    return mismatches ? 1 : 0;
+
+}
@@ -0,0 +1,169 @@
+/*
+ * Name: MIL_CAN routing table benchmark
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Times MIL_CAN_Route against a linear search of {ID,handler}
+ *       pairs(what an if/else chain on the ID compiles down to) for
+ *       64 to 512 routed IDs
+ *
+ * BENCH NOTES:
+ * 512 IDs don't fit the default 8 bit table, so this is built with
+ * MIL_CAN_ROUTE_ID_BITS=9(see ID ROUTING TABLE in MIL_CAN.h). The routed
+ * IDs are spread evenly over the 9 bit space and the frames are a fixed
+ * pseudo random mix of routed IDs and IDs nobody handles(1 in 8, at 512
+ * every ID is routed), the same mix for both. The numbers are host ns
+ * per frame and don't carry over to the TM4C, but the shape does: the
+ * table stays flat and the linear search grows with the number of IDs.
+ *
+ * HOW TO BUILD:
+ * from MIL_CAN/Tests, with TIVAWARE pointing at your TivaWare install
+ *
+ *      gcc -std=gnu99 -O2 -DMIL_CAN_ROUTE_ID_BITS=9 -I$TIVAWARE -I.. -I../Sim
+ *          MIL_CAN_Route_BENCH.c ../MIL_CAN.c ../Sim/MIL_CAN_Sim.c -o route_bench
+ *
+ * then ./route_bench, it returns non zero if the two ways route a frame
+ * differently
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "inc/hw_memmap.h"
+
+#include "MIL_CAN.h"
+
+/********DEFINES START******/
+#define BENCH_FRAMES    4096    //frames in the mix, a power of 2
+#define BENCH_ROUNDS    2000    //times the mix is routed per measurement
+#define BENCH_MAX_IDS   512
+/********DEFINES END******/
+
+#if MIL_CAN_ROUTE_ID_SPACE < BENCH_MAX_IDS
+#error "build with -DMIL_CAN_ROUTE_ID_BITS=9 or more"
+#endif
+
+typedef struct{
+    uint32_t canid;
+    mil_can_frame_handler_t handler;
+}bench_route_t;
+
+static mil_can_frame_handler_t bench_table[MIL_CAN_ROUTE_ID_SPACE];
+static bench_route_t bench_linear[BENCH_MAX_IDS];
+static MIL_CAN_Frame_t bench_frames[BENCH_FRAMES];
+static volatile uint32_t bench_sum;
+
+static void BENCH_Handler(const MIL_CAN_Frame_t *pframe){
+
+    bench_sum += pframe->canid;
+
+}
+
+/*
+ * Desc: the if/else chain, first match wins
+ */
+static mil_can_status_t BENCH_RouteLinear(const bench_route_t *proutes,uint32_t num_routes,const MIL_CAN_Frame_t *pframe){
+
+    for(uint32_t i = 0;i < num_routes;i++){
+        if(proutes[i].canid == pframe->canid){
+            proutes[i].handler(pframe);
+            return MIL_CAN_OK;
+        }
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+static double BENCH_NowNs(void){
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+
+}
+
+int main(void){
+
+    uint32_t mismatches = 0;
+    uint32_t rng = 0x12345678;
+
+    printf("   IDs   table ns/frame   linear ns/frame   speedup\n");
+
+    for(uint32_t num_ids = 64;num_ids <= BENCH_MAX_IDS;num_ids *= 2){
+
+        uint32_t stride = MIL_CAN_ROUTE_ID_SPACE / num_ids;
+        uint32_t table_sum;
+        uint32_t linear_sum;
+        double start;
+        double table_ns;
+        double linear_ns;
+
+        for(uint32_t id = 0;id < MIL_CAN_ROUTE_ID_SPACE;id++){
+            bench_table[id] = 0;
+        }
+
+        for(uint32_t i = 0;i < num_ids;i++){
+            bench_table[i * stride] = BENCH_Handler;
+            bench_linear[i].canid = i * stride;
+            bench_linear[i].handler = BENCH_Handler;
+        }
+
+        for(uint32_t f = 0;f < BENCH_FRAMES;f++){
+
+            rng = rng * 1664525 + 1013904223;
+
+            //1 in 8 frames is for an ID nobody routes
+            if((rng >> 29) == 0){
+                bench_frames[f].canid = ((rng >> 8) % MIL_CAN_ROUTE_ID_SPACE) | ((stride > 1) ? 1 : 0);
+            }
+            else{
+                bench_frames[f].canid = ((rng >> 8) % num_ids) * stride;
+            }
+            bench_frames[f].len = 0;
+
+        }
+
+        //both have to route the exact same frames
+        for(uint32_t f = 0;f < BENCH_FRAMES;f++){
+            if(MIL_CAN_Route(bench_table,&bench_frames[f]) !=
+               BENCH_RouteLinear(bench_linear,num_ids,&bench_frames[f])){
+                mismatches++;
+            }
+        }
+
+        bench_sum = 0;
+        start = BENCH_NowNs();
+        for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+            for(uint32_t f = 0;f < BENCH_FRAMES;f++){
+                MIL_CAN_Route(bench_table,&bench_frames[f]);
+            }
+        }
+        table_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_FRAMES);
+        table_sum = bench_sum;
+
+        bench_sum = 0;
+        start = BENCH_NowNs();
+        for(uint32_t r = 0;r < BENCH_ROUNDS;r++){
+            for(uint32_t f = 0;f < BENCH_FRAMES;f++){
+                BENCH_RouteLinear(bench_linear,num_ids,&bench_frames[f]);
+            }
+        }
+        linear_ns = (BENCH_NowNs() - start) / ((double)BENCH_ROUNDS * BENCH_FRAMES);
+        linear_sum = bench_sum;
+
+        if(table_sum != linear_sum){
+            mismatches++;
+        }
+
+        printf("%6u   %14.2f   %15.2f   %6.1fx\n",num_ids,table_ns,linear_ns,linear_ns / table_ns);
+
+    }
+
+    printf("mismatches %u\n",mismatches);
+
+    return mismatches ? 1 : 0;
+
+}
@@ -0,0 +1,198 @@
+/*
+ * Name: MIL_CAN receive queue test
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Host test of the interrupt driven receive queue on the simulator,
+ *       fills the queue, overflows it and overwrites a message object
+ *       before the ISR can read it, checking the counters each time
+ *
+ * HOW TO BUILD:
+ * from MIL_CAN/Tests, with TIVAWARE pointing at your TivaWare install
+ *
+ *      gcc -std=gnu99 -I$TIVAWARE -I.. -I../Sim MIL_CAN_RxQueue_TEST.c
+ *          ../MIL_CAN.c ../Sim/MIL_CAN_Sim.c -o rxq_test
+ *
+ * then ./rxq_test, it prints every check and returns non zero if any failed
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/can.h"
+#include "driverlib/interrupt.h"
+
+#include "MIL_CAN.h"
+#include "MIL_CAN_Sim.h"
+
+/********DEFINES START******/
+#define TEST_BPS        500000
+#define TEST_CANID      0x100
+#define TEST_RX_OBJ     1
+#define TEST_PEER       MIL_CAN_SIM_NODE(2)
+#define TEST_PEER_OBJ   1
+
+//one 8 byte frame at 500k is ~250us, leave room for stuff bits
+#define TEST_FRAME_US   400
+/********DEFINES END******/
+
+static uint32_t test_failures;
+
+static void TEST_EQ(const char *pname,uint32_t got,uint32_t want){
+
+    printf("%-40s got %5u want %5u %s\n",pname,got,want,(got == want) ? "ok" : "FAIL");
+
+    if(got != want){
+        test_failures++;
+    }
+
+}
+
+/*
+ * Desc: the peer sends one frame with seq in the first byte and the
+ *       bus runs until it's been received
+ */
+static void TEST_PeerSend(uint8_t seq){
+
+    uint8_t data[8] = {seq,0xA5,0,0,0,0,0,seq};
+    tCANMsgObject msg;
+
+    msg.ui32MsgID = TEST_CANID;
+    msg.ui32Flags = 0;
+    msg.ui32MsgLen = 8;
+    msg.pui8MsgData = data;
+    CANMessageSet(TEST_PEER,TEST_PEER_OBJ,&msg,MSG_OBJ_TYPE_TX);
+
+    MIL_CAN_SimRun(TEST_FRAME_US);
+
+}
+
+/*
+ * Desc: pulls everything out of the queue, checks it came out in order
+ *       starting at first_seq
+ *
+ * Returns:
+ * number of frames read
+ */
+static uint32_t TEST_Drain(uint8_t first_seq,uint32_t *pout_of_order){
+
+    MIL_CAN_Frame_t frame;
+    uint32_t count = 0;
+
+    while(MIL_CAN_RxQueueGet(CAN0_BASE,&frame) == MIL_CAN_OK){
+
+        if((frame.data[0] != (uint8_t)(first_seq + count)) || (frame.canid != TEST_CANID) ||
+           (frame.len != 8) || (frame.obj_num != TEST_RX_OBJ)){
+            (*pout_of_order)++;
+        }
+
+        count++;
+
+    }
+
+    return count;
+
+}
+
+int main(void){
+
+    static uint8_t rx_buffer[8];
+    MIL_CAN_MailBox_t mailbox;
+    MIL_CAN_RxQueueStats_t stats;
+    MIL_CAN_Frame_t frame;
+    uint32_t out_of_order = 0;
+    uint8_t seq = 0;
+
+    MIL_CAN_SimReset(16000000);
+    MIL_InitCAN(MIL_CAN_PORT_B,CAN0_BASE,TEST_BPS);
+
+    CANInit(TEST_PEER);
+    CANBitRateSet(TEST_PEER,0,TEST_BPS);
+    CANEnable(TEST_PEER);
+
+    mailbox.canid = TEST_CANID;
+    mailbox.filt_mask = 0x7FF;
+    mailbox.base = CAN0_BASE;
+    mailbox.msg_len = 8;
+    mailbox.obj_num = TEST_RX_OBJ;
+    mailbox.buffer = rx_buffer;
+
+    MIL_CAN_RxQueueInit(CAN0_BASE);
+    MIL_CAN_RxQueueAttach(&mailbox);
+    MIL_CANIntEnable(MIL_CAN0_ISR,CAN0_BASE);
+
+    /*********************EMPTY*********************/
+
+    TEST_EQ("empty queue count",MIL_CAN_RxQueueCount(CAN0_BASE),0);
+    TEST_EQ("empty queue get",MIL_CAN_RxQueueGet(CAN0_BASE,&frame),MIL_CAN_NOK);
+
+    /*********************FILL**********************/
+
+    //exactly the queue size goes in without losing anything
+    for(uint32_t i = 0;i < MIL_CAN_RXQ_SIZE;i++){
+        TEST_PeerSend(seq++);
+    }
+
+    MIL_CAN_RxQueueStatsGet(CAN0_BASE,&stats);
+    TEST_EQ("full queue count",MIL_CAN_RxQueueCount(CAN0_BASE),MIL_CAN_RXQ_SIZE);
+    TEST_EQ("full queue rx_frames",stats.rx_frames,MIL_CAN_RXQ_SIZE);
+    TEST_EQ("full queue overflows",stats.overflows,0);
+    TEST_EQ("full queue lost",stats.lost,0);
+
+    /*********************OVERFLOW******************/
+
+    //the queue is full, these are read off the controller and dropped
+    for(uint32_t i = 0;i < 3;i++){
+        TEST_PeerSend(seq++);
+    }
+
+    MIL_CAN_RxQueueStatsGet(CAN0_BASE,&stats);
+    TEST_EQ("overflow count",MIL_CAN_RxQueueCount(CAN0_BASE),MIL_CAN_RXQ_SIZE);
+    TEST_EQ("overflow rx_frames",stats.rx_frames,MIL_CAN_RXQ_SIZE);
+    TEST_EQ("overflow overflows",stats.overflows,3);
+
+    //the oldest frames survive, the dropped ones were the newest
+    TEST_EQ("overflow drain",TEST_Drain(0,&out_of_order),MIL_CAN_RXQ_SIZE);
+    TEST_EQ("overflow order",out_of_order,0);
+
+    //room again, the queue picks up right where it left off
+    TEST_PeerSend(seq);
+    TEST_EQ("after drain count",MIL_CAN_RxQueueCount(CAN0_BASE),1);
+    TEST_EQ("after drain frame",TEST_Drain(seq,&out_of_order),1);
+    TEST_EQ("after drain order",out_of_order,0);
+    seq++;
+
+    /*********************LOST**********************/
+
+    //hold the ISR off so the second frame overwrites the first
+    //inside the message object
+    IntDisable(INT_CAN0);
+    TEST_PeerSend(seq++);
+    TEST_PeerSend(seq++);
+    IntEnable(INT_CAN0);
+    MIL_CAN_SimRun(10);
+
+    MIL_CAN_RxQueueStatsGet(CAN0_BASE,&stats);
+    TEST_EQ("lost count",MIL_CAN_RxQueueCount(CAN0_BASE),1);
+    TEST_EQ("lost counter",stats.lost,1);
+    TEST_EQ("lost get",MIL_CAN_RxQueueGet(CAN0_BASE,&frame),MIL_CAN_OK);
+    TEST_EQ("lost frame is the newer one",frame.data[0],(uint8_t)(seq - 1));
+    TEST_EQ("lost flag",frame.flags & MIL_CAN_FRAME_LOST,MIL_CAN_FRAME_LOST);
+
+    //and the next frame is clean again
+    TEST_PeerSend(seq++);
+    TEST_EQ("clean get",MIL_CAN_RxQueueGet(CAN0_BASE,&frame),MIL_CAN_OK);
+    TEST_EQ("clean flag",frame.flags & MIL_CAN_FRAME_LOST,0);
+
+    MIL_CAN_RxQueueStatsGet(CAN0_BASE,&stats);
+    TEST_EQ("final rx_frames",stats.rx_frames,MIL_CAN_RXQ_SIZE + 3);
+    TEST_EQ("final overflows",stats.overflows,3);
+    TEST_EQ("final lost",stats.lost,1);
+
+    printf("%s, %u failed\n",test_failures ? "FAIL" : "PASS",test_failures);
+
+    return test_failures ? 1 : 0;
+
+}
@@ -0,0 +1,193 @@
+/*
+ * Name: MIL_CAN transmit class latency benchmark
+ * Author: Marquez Jones
+ * Date Created: 10/16/2026
+ * Desc: Measures the worst case time from MIL_CAN_TxClassSend to the
+ *       frame arriving at another node while the bulk class keeps the
+ *       bus saturated, with the urgent frame in its own class and again
+ *       with it queued behind the bulk traffic
+ *
+ * BENCH NOTES:
+ * Runs on the simulator at 500k. The bulk class is refilled every
+ * microsecond so it never runs dry, and its ID(0x010) beats the urgent
+ * ID(0x7F0) in arbitration, so the urgent frame only gets out early
+ * because of its message objects. The urgent frame is sent at a
+ * different point of the bulk frame on the wire each trial so the worst
+ * case gets hit. Queued behind bulk it has to wait for room in the bulk
+ * class first, that wait counts too. The bound from MIL_CAN.h is the
+ * frame already on the wire plus the urgent frame itself, two 8 byte
+ * frame times.
+ *
+ * HOW TO BUILD:
+ * from MIL_CAN/Tests, with TIVAWARE pointing at your TivaWare install
+ *
+ *      gcc -std=gnu99 -I$TIVAWARE -I.. -I../Sim MIL_CAN_TxClass_BENCH.c
+ *          ../MIL_CAN.c ../Sim/MIL_CAN_Sim.c -o txclass_bench
+ *
+ * then ./txclass_bench, it returns non zero if the urgent class ever
+ * takes longer than the bound
+ */
+
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/can.h"
+
+#include "MIL_CAN.h"
+#include "MIL_CAN_Sim.h"
+
+/********DEFINES START******/
+#define BENCH_BPS           500000
+#define BENCH_BULK_ID       0x010
+#define BENCH_URGENT_ID     0x7F0
+#define BENCH_PEER          MIL_CAN_SIM_NODE(2)
+#define BENCH_PEER_URGENT   1   //peer object that only takes the urgent ID
+#define BENCH_PEER_ANY      2   //peer object that takes everything else
+#define BENCH_TRIALS        100
+
+//longest 8 byte standard frame with worst case stuffing, 135 bits
+#define BENCH_FRAME_BITS    135
+#define BENCH_FRAME_US      ((BENCH_FRAME_BITS * 1000000UL) / BENCH_BPS)
+/********DEFINES END******/
+
+typedef struct{
+    uint32_t worst_us;
+    uint32_t total_us;
+    uint32_t trials;
+}bench_result_t;
+
+static uint8_t bench_data[8] = {0xDE,0xAD,0xBE,0xEF,0,0,0,0};
+
+/*
+ * Desc: tops the bulk class up until it refuses
+ */
+static void BENCH_BulkFill(void){
+
+    while(MIL_CAN_TxClassSend(CAN0_BASE,MIL_CAN_TX_BULK,BENCH_BULK_ID,bench_data,8) == MIL_CAN_OK){}
+
+}
+
+/*
+ * Desc: sends the urgent frame the way application code would, trying
+ *       again every microsecond while its class is full
+ */
+static void BENCH_UrgentSend(mil_can_tx_class_t tx_class){
+
+    while(MIL_CAN_TxClassSend(CAN0_BASE,tx_class,BENCH_URGENT_ID,bench_data,8) != MIL_CAN_OK){
+        MIL_CAN_SimRun(1);
+    }
+
+}
+
+/*
+ * Desc: runs the bus a microsecond at a time, keeping bulk saturated,
+ *       until the peer has the urgent frame
+ *
+ * Returns:
+ * microseconds it took
+ */
+static uint32_t BENCH_WaitUrgent(uint32_t start_us){
+
+    tCANMsgObject msg;
+    uint8_t rx[8];
+
+    while(!(CANStatusGet(BENCH_PEER,CAN_STS_NEWDAT) & (0x01UL << (BENCH_PEER_URGENT - 1)))){
+        BENCH_BulkFill();
+        MIL_CAN_SimRun(1);
+    }
+
+    msg.pui8MsgData = rx;
+    CANMessageGet(BENCH_PEER,BENCH_PEER_URGENT,&msg,1);
+
+    return MIL_CAN_SimTimeUs() - start_us;
+
+}
+
+/*
+ * Desc: sends the urgent frame BENCH_TRIALS times at different points
+ *       of the bulk traffic
+ *
+ * Parameters:
+ * tx_class - class the urgent frame goes in
+ */
+static void BENCH_Run(mil_can_tx_class_t tx_class,bench_result_t *presult){
+
+    presult->worst_us = 0;
+    presult->total_us = 0;
+    presult->trials = 0;
+
+    for(uint32_t k = 0;k < BENCH_TRIALS;k++){
+
+        uint32_t start_us;
+        uint32_t latency_us;
+
+        //land somewhere different inside a bulk frame each time
+        BENCH_BulkFill();
+        MIL_CAN_SimRun(BENCH_FRAME_US + (k * 37) % BENCH_FRAME_US);
+        BENCH_BulkFill();
+
+        start_us = MIL_CAN_SimTimeUs();
+        BENCH_UrgentSend(tx_class);
+        latency_us = BENCH_WaitUrgent(start_us);
+
+        if(latency_us > presult->worst_us){
+            presult->worst_us = latency_us;
+        }
+        presult->total_us += latency_us;
+        presult->trials++;
+
+    }
+
+}
+
+int main(void){
+
+    tCANMsgObject msg;
+    uint8_t rx[8];
+    bench_result_t urgent;
+    bench_result_t queued;
+    MIL_CAN_TxQueueStats_t bulk_stats;
+    uint32_t bound_us = 2 * BENCH_FRAME_US;
+
+    MIL_CAN_SimReset(16000000);
+    MIL_InitCAN(MIL_CAN_PORT_B,CAN0_BASE,BENCH_BPS);
+    MIL_CANIntEnable(MIL_CAN0_ISR,CAN0_BASE);
+
+    CANInit(BENCH_PEER);
+    CANBitRateSet(BENCH_PEER,0,BENCH_BPS);
+    CANEnable(BENCH_PEER);
+
+    //the lowest matching object wins, so the urgent ID never reaches ANY
+    msg.ui32MsgID = BENCH_URGENT_ID;
+    msg.ui32MsgIDMask = 0x7FF;
+    msg.ui32Flags = MSG_OBJ_USE_ID_FILTER;
+    msg.ui32MsgLen = 8;
+    msg.pui8MsgData = rx;
+    CANMessageSet(BENCH_PEER,BENCH_PEER_URGENT,&msg,MSG_OBJ_TYPE_RX);
+
+    msg.ui32MsgID = 0;
+    msg.ui32MsgIDMask = 0;
+    CANMessageSet(BENCH_PEER,BENCH_PEER_ANY,&msg,MSG_OBJ_TYPE_RX);
+
+    //urgent band below the bulk band, like MIL_CAN.h says
+    MIL_CAN_TxClassInit(CAN0_BASE,MIL_CAN_TX_KILL,1,2);
+    MIL_CAN_TxClassInit(CAN0_BASE,MIL_CAN_TX_BULK,11,4);
+
+    BENCH_Run(MIL_CAN_TX_KILL,&urgent);
+    BENCH_Run(MIL_CAN_TX_BULK,&queued);
+
+    MIL_CAN_TxClassStatsGet(CAN0_BASE,MIL_CAN_TX_BULK,&bulk_stats);
+
+    printf("8 byte frame at %u bps: %u us, bound for the urgent class %u us\n",
+           BENCH_BPS,(uint32_t)BENCH_FRAME_US,bound_us);
+    printf("urgent in its own class     worst %6u us  average %6u us\n",
+           urgent.worst_us,urgent.total_us / urgent.trials);
+    printf("urgent queued behind bulk   worst %6u us  average %6u us\n",
+           queued.worst_us,queued.total_us / queued.trials);
+    printf("bulk frames sent %u, refused while full %u\n",bulk_stats.sent,bulk_stats.dropped);
+
+    return (urgent.worst_us > bound_us) ? 1 : 0;
+
+}